@@ -0,0 +1,165 @@
+/*
+ * DomAnalyzer 微基准
+ *
+ * 在随机生成的控制流图 (一条主链 + 随机前向/回边，平均出度约为 2) 上分别运行
+ * Lengauer-Tarjan 与 SEMI-NCA，输出耗时与每条边的平均耗时，用于确认两者随规模近似线性增长。
+ * 较小的规模下还会与 Cooper-Harvey-Kennedy 迭代算法的结果进行比对。
+ *
+ * 用法: make bench && ./bin/bench_dom [最大结点数]
+ */
+#include <dom_analyzer.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+static vector<vector<int>> makeGraph(int n, unsigned seed)
+{
+    mt19937             rng(seed);
+    vector<vector<int>> graph(n);
+    for (int u = 0; u + 1 < n; ++u)
+    {
+        graph[u].push_back(u + 1);
+        uniform_int_distribution<int> kind(0, 9);
+        int                           k = kind(rng);
+        if (k < 6)
+        {
+            // 前向边，模拟 if/else 汇合
+            uniform_int_distribution<int> span(2, 16);
+            int                           v = u + span(rng);
+            if (v < n) graph[u].push_back(v);
+        }
+        else if (k < 8)
+        {
+            // 回边，模拟循环
+            uniform_int_distribution<int> span(1, 32);
+            int                           v = u - span(rng);
+            if (v >= 0) graph[u].push_back(v);
+        }
+    }
+    return graph;
+}
+
+// Cooper, Harvey, Kennedy: "A Simple, Fast Dominance Algorithm"
+static vector<int> referenceIdom(const vector<vector<int>>& graph)
+{
+    int         n = graph.size();
+    vector<int> order, rpoIndex(n, -1);
+    {
+        vector<char>              visited(n, 0);
+        vector<pair<int, size_t>> stack{{0, 0}};
+        visited[0] = 1;
+        while (!stack.empty())
+        {
+            auto [u, i] = stack.back();
+            if (i == graph[u].size())
+            {
+                order.push_back(u);
+                stack.pop_back();
+                continue;
+            }
+            stack.back().second++;
+            int v = graph[u][i];
+            if (!visited[v])
+            {
+                visited[v] = 1;
+                stack.push_back({v, 0});
+            }
+        }
+    }
+    vector<int> rpo(order.rbegin(), order.rend());
+    for (size_t i = 0; i < rpo.size(); ++i) rpoIndex[rpo[i]] = i;
+
+    vector<vector<int>> preds(n);
+    for (int u = 0; u < n; ++u)
+        for (int v : graph[u]) preds[v].push_back(u);
+
+    vector<int> idom(n, -1);
+    idom[0]      = 0;
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+        for (size_t i = 1; i < rpo.size(); ++i)
+        {
+            int b      = rpo[i];
+            int newDom = -1;
+            for (int p : preds[b])
+            {
+                if (idom[p] == -1) continue;
+                if (newDom == -1)
+                {
+                    newDom = p;
+                    continue;
+                }
+                int x = p, y = newDom;
+                while (x != y)
+                {
+                    while (rpoIndex[x] > rpoIndex[y]) x = idom[x];
+                    while (rpoIndex[y] > rpoIndex[x]) y = idom[y];
+                }
+                newDom = x;
+            }
+            if (idom[b] != newDom)
+            {
+                idom[b] = newDom;
+                changed = true;
+            }
+        }
+    }
+    return idom;
+}
+
+static double run(DomAnalyzer::Algorithm algo, const vector<vector<int>>& graph, vector<int>& idom)
+{
+    DomAnalyzer analyzer;
+    analyzer.setAlgorithm(algo);
+    auto begin = chrono::steady_clock::now();
+    analyzer.solve(graph, {0}, false);
+    auto end = chrono::steady_clock::now();
+    idom     = analyzer.imm_dom;
+    return chrono::duration<double, milli>(end - begin).count();
+}
+
+int main(int argc, char** argv)
+{
+    int maxNodes = argc > 1 ? atoi(argv[1]) : 1000000;
+
+    printf("%10s %10s %12s %12s %12s %12s %8s\n", "nodes", "edges", "LT (ms)", "ns/edge", "SNCA (ms)", "ns/edge",
+        "check");
+    for (int n = 1000; n <= maxNodes; n *= 10)
+    {
+        for (int scale : {1, 2, 5})
+        {
+            int nodes = n * scale;
+            if (nodes > maxNodes) break;
+
+            auto   graph = makeGraph(nodes, 2025u + nodes);
+            size_t edges = 0;
+            for (auto& succs : graph) edges += succs.size();
+
+            vector<int> ltIdom, sncaIdom;
+            double      lt   = run(DomAnalyzer::Algorithm::LengauerTarjan, graph, ltIdom);
+            double      snca = run(DomAnalyzer::Algorithm::SemiNCA, graph, sncaIdom);
+
+            const char* check = "skip";
+            bool        ok    = ltIdom == sncaIdom;
+            if (nodes <= 100000)
+            {
+                auto ref = referenceIdom(graph);
+                for (int i = 0; i < nodes && ok; ++i) ok = ref[i] == ltIdom[i];
+                check = ok ? "ok" : "FAIL";
+            }
+            else if (!ok)
+                check = "FAIL";
+
+            printf("%10d %10zu %12.3f %12.2f %12.3f %12.2f %8s\n", nodes, edges, lt, lt * 1e6 / edges, snca,
+                snca * 1e6 / edges, check);
+            if (!ok) return 1;
+        }
+    }
+    return 0;
+}
@@ -4,8 +4,10 @@
 
 namespace ME
 {
-    void FunctionPass::runOnModule(Module& module)
+    // 串行版本，供直接调用 pass 时使用; 经由 PassManager 运行时会在线程池上并发执行各函数
+    PreservedAnalyses FunctionPass::runOnModule(Module& module)
     {
-        for (auto* function : module.functions) runOnFunction(*function);
+        for (auto* function : module.functions) Analysis::AM.invalidate(*function, runOnFunction(*function));
+        return PreservedAnalyses::all();
     }
 }  // namespace ME
@@ -1,6 +1,8 @@
 #ifndef __INTERFACES_MIDDLEEND_PASS_H__
 #define __INTERFACES_MIDDLEEND_PASS_H__
 
+#include <middleend/pass/analysis/analysis_manager.h>
+
 namespace ME
 {
     class Module;
@@ -9,30 +11,38 @@ namespace ME
 
 namespace ME
 {
+    using Analysis::PreservedAnalyses;
+
     class Pass
-    {
+    { /*
+       * 所有 pass 都返回其运行后仍然有效的分析集合 (PreservedAnalyses)
+       * 未修改 IR 时返回 PreservedAnalyses::all()，调用者据此使缓存的分析失效
+       */
       public:
-        virtual ~Pass()                                = default;
-        virtual void runOnModule(Module& module)       = 0;
-        virtual void runOnFunction(Function& function) = 0;
+        virtual ~Pass()                                             = default;
+        virtual PreservedAnalyses runOnModule(Module& module)       = 0;
+        virtual PreservedAnalyses runOnFunction(Function& function) = 0;
     };
 
     class ModulePass : public Pass
     { /*
        * 全局优化Pass的基类
+       * runOnModule 的返回值由调用者通过 AM.invalidate(module, pa) 作用于模块及其所有函数
        */
       public:
-        virtual void runOnModule(Module& module) override       = 0;
-        virtual void runOnFunction(Function& function) override = 0;
+        virtual PreservedAnalyses runOnModule(Module& module) override       = 0;
+        virtual PreservedAnalyses runOnFunction(Function& function) override = 0;
     };
 
     class FunctionPass : public Pass
     { /*
        * 过程内优化Pass的基类
+       * runOnModule 在每个函数运行结束后立即按其返回值使该函数的分析失效，
+       * 因此自身总是返回 PreservedAnalyses::all()
        */
       public:
-        virtual void runOnModule(Module& module) override;
-        virtual void runOnFunction(Function& function) override = 0;
+        virtual PreservedAnalyses runOnModule(Module& module) override;
+        virtual PreservedAnalyses runOnFunction(Function& function) override = 0;
     };
 }  // namespace ME
 
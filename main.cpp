@@ -4,6 +4,7 @@
 #include <fstream>
 #include <iostream>
 #include <iomanip>
+#include <thread>
 
 #include <frontend/symbol/symbol_table.h>
 #include <frontend/ast/visitor/sementic_check/ast_checker.h>
@@ -11,7 +12,10 @@
 #include <middleend/visitor/codegen/ast_codegen.h>
 #include <middleend/visitor/printer/module_printer.h>
 #include <middleend/module/ir_module.h>
-#include <middleend/pass/unify_return.h>
+#include <middleend/pass/pass_manager.h>
+#include <middleend/pass/analysis/dominfo.h>
+#include <middleend/pass/inliner.h>
+#include <middleend/pass/loop_unroll.h>
 
 /* 如果你简化了框架的实现, 或者解决了框架现存的问题
    或者是用现代C++特性对框架进行了重构, 并且有效地简化了代码或者提高了代码的复用性
@@ -49,6 +53,13 @@ int main(int argc, char** argv)
     int      optimizeLevel = 0;
     ostream* outStream     = &cout;
     ofstream outFile;
+    string   passPipeline  = "";
+    bool     customPasses  = false;
+    bool     timePasses    = false;
+    size_t   threadCount   = 1;
+    bool     directSSA     = false;
+
+    ME::PassManager passManager;
 
     for (int i = 1; i < argc; i++)
     {
@@ -69,6 +80,50 @@ int main(int argc, char** argv)
         else if (arg == "-O0") { optimizeLevel = 0; }
         else if (arg == "-O2") { optimizeLevel = 2; }
         else if (arg == "-O3") { optimizeLevel = 3; }
+        else if (arg.rfind("-passes=", 0) == 0)
+        {
+            passPipeline = arg.substr(8);
+            customPasses = true;
+        }
+        else if (arg == "-time-passes") { timePasses = true; }
+        else if (arg == "-verify-dom") { ME::Analysis::DomInfo::setVerifyUpdates(true); }
+        else if (arg == "-fdirect-ssa") { directSSA = true; }
+        else if (arg == "-Rpass=inline") { ME::InlinerPass::setRemarks(true); }
+        else if (arg.rfind("-inline-threshold=", 0) == 0)
+        {
+            // -inline-threshold=<n>: 内联的代价阈值, 可以为负数 (只内联常数实参带来足够收益的调用)
+            string value  = arg.substr(18);
+            string digits = !value.empty() && value[0] == '-' ? value.substr(1) : value;
+            if (digits.empty() || digits.find_first_not_of("0123456789") != string::npos)
+            {
+                cerr << "Error: -inline-threshold option requires an integer" << endl;
+                return 1;
+            }
+            ME::InlinerPass::setThreshold(stoi(value));
+        }
+        else if (arg.rfind("-unroll-factor=", 0) == 0)
+        {
+            // -unroll-factor=<n>: 部分展开的因子, 小于 2 时只做完全展开
+            string value = arg.substr(15);
+            if (value.empty() || value.find_first_not_of("0123456789") != string::npos)
+            {
+                cerr << "Error: -unroll-factor option requires a non-negative integer" << endl;
+                return 1;
+            }
+            ME::LoopUnrollPass::setFactor(stoul(value));
+        }
+        else if (arg.rfind("-j", 0) == 0)
+        {
+            // -j<N> 或 -j <N>: 函数级 pass 的并行线程数, 0 表示使用全部硬件线程
+            string count = arg.size() > 2 ? arg.substr(2) : (i + 1 < argc ? string(argv[++i]) : string());
+            if (count.empty() || count.find_first_not_of("0123456789") != string::npos)
+            {
+                cerr << "Error: -j option requires a thread count" << endl;
+                return 1;
+            }
+            threadCount = stoul(count);
+            if (threadCount == 0) threadCount = max(1u, thread::hardware_concurrency());
+        }
         else if (arg[0] != '-') { inputFile = arg; }
         else
         {
@@ -80,10 +135,27 @@ int main(int argc, char** argv)
     if (inputFile.empty())
     {
         cerr << "Error: No input file specified" << endl;
-        cerr << "Usage: " << argv[0] << " [-lexer|-parser|-llvm|-S] [-o output_file] input_file [-O]" << endl;
+        cerr << "Usage: " << argv[0]
+             << " [-lexer|-parser|-llvm|-S] [-o output_file] input_file [-O<level>] [-passes=<pipeline>] [-time-passes] [-verify-dom] [-fdirect-ssa] [-j<threads>]"
+             << " [-inline-threshold=<n>] [-Rpass=inline] [-unroll-factor=<n>]"
+             << endl;
         return 1;
     }
 
+    {
+        // -passes= 指定的流水线优先于 -O<level> 的预设
+        string pipelineError;
+        bool   pipelineOk = customPasses ? passManager.parsePipeline(passPipeline, pipelineError)
+                                         : passManager.buildPreset(optimizeLevel, pipelineError);
+        if (!pipelineOk)
+        {
+            cerr << "Error: invalid pass pipeline: " << pipelineError << endl;
+            return 1;
+        }
+        passManager.setTimePasses(timePasses);
+        passManager.setThreads(threadCount);
+    }
+
     if (!outputFile.empty())
     {
         outFile.open(outputFile);
@@ -291,9 +363,11 @@ int main(int argc, char** argv)
         ME::ASTCodeGen codegen(checker.getGlbSymbols(), checker.getFuncDecls());
         ME::Module     m;
 
+        // -fdirect-ssa: 生成代码时直接构造 SSA，标量变量不经过 alloca/load/store
+        codegen.setDirectSSA(directSSA);
         apply(codegen, *ast, &m);
 
-        if (optimizeLevel > 0)
+        if (!passManager.empty())
         {
             /*
              * Lab 4: 中间代码优化
@@ -307,9 +381,10 @@ int main(int argc, char** argv)
              * - 激进死代码消除（基于控制依赖图，需删除死循环）
              * - 难度不低于上述 pass 的其它优化
              */
-            // 下面这个 pass 可以作为参考，主要是示范如何通过cache获取分析pass的结果
-            ME::UnifyReturnPass unifyReturnPass;
-            unifyReturnPass.runOnModule(m);
+            // 各个 pass 的注册与 -O<level> 预设见 middleend/pass/pass_manager.cpp
+            // UnifyReturnPass (middleend/pass/unify_return.cpp) 可以作为参考，主要是示范如何通过cache获取分析pass的结果
+            passManager.run(m);
+            if (timePasses) passManager.printTimeReport(cerr);
         }
 
         if (step == "-llvm")
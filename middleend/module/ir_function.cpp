@@ -3,7 +3,7 @@
 namespace ME
 {
     Function::Function(FuncDefInst* fd)
-        : funcDef(fd), blocks(), maxLabel(0), maxReg(0), loopStartLabel(0), loopEndLabel(0)
+        : funcDef(fd), blocks(), parent(nullptr), maxLabel(0), maxReg(0), loopStartLabel(0), loopEndLabel(0)
     {}
     Function::~Function()
     {
@@ -6,11 +6,14 @@
 
 namespace ME
 {
+    class Module;
+
     class Function : public Visitable
     {
       public:
         FuncDefInst*             funcDef;
         std::map<size_t, Block*> blocks;
+        Module*                  parent;  // 所属模块，用于在函数级分析中获取模块级分析 (如调用图)
 
       private:
         size_t maxLabel;
@@ -431,7 +431,17 @@ namespace ME
 
         using ValOp   = Operand*;
         using LabelOp = Operand*;
-        std::map<LabelOp, ValOp> incomingVals;  // label -> value
+
+        // 按标签编号而非指针地址排序，保证输出不依赖操作数的分配顺序 (多线程运行 pass 时尤其如此)
+        struct LabelLess
+        {
+            bool operator()(LabelOp a, LabelOp b) const
+            {
+                return static_cast<LabelOperand*>(a)->lnum < static_cast<LabelOperand*>(b)->lnum;
+            }
+        };
+        using IncomingMap = std::map<LabelOp, ValOp, LabelLess>;
+        IncomingMap incomingVals;  // label -> value
 
       public:
         PhiInst(DataType t, Operand* r, const std::string& c = "")
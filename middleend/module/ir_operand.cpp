@@ -13,62 +13,27 @@ namespace ME
 
     RegOperand* OperandFactory::getRegOperand(size_t id)
     {
-        auto it = RegOperandMap.find(id);
-        if (it == RegOperandMap.end())
-        {
-            RegOperand* op    = new RegOperand(id);
-            RegOperandMap[id] = op;
-            return op;
-        }
-        return it->second;
+        return intern(RegOperandMap, id, [&] { return new RegOperand(id); });
     }
 
     ImmeI32Operand* OperandFactory::getImmeI32Operand(int value)
     {
-        auto it = ImmeI32OperandMap.find(value);
-        if (it == ImmeI32OperandMap.end())
-        {
-            ImmeI32Operand* op       = new ImmeI32Operand(value);
-            ImmeI32OperandMap[value] = op;
-            return op;
-        }
-        return it->second;
+        return intern(ImmeI32OperandMap, value, [&] { return new ImmeI32Operand(value); });
     }
 
     ImmeF32Operand* OperandFactory::getImmeF32Operand(float value)
     {
-        auto it = ImmeF32OperandMap.find(value);
-        if (it == ImmeF32OperandMap.end())
-        {
-            ImmeF32Operand* op       = new ImmeF32Operand(value);
-            ImmeF32OperandMap[value] = op;
-            return op;
-        }
-        return it->second;
+        return intern(ImmeF32OperandMap, value, [&] { return new ImmeF32Operand(value); });
     }
 
     GlobalOperand* OperandFactory::getGlobalOperand(const std::string& name)
     {
-        auto it = GlobalOperandMap.find(name);
-        if (it == GlobalOperandMap.end())
-        {
-            GlobalOperand* op      = new GlobalOperand(name);
-            GlobalOperandMap[name] = op;
-            return op;
-        }
-        return it->second;
+        return intern(GlobalOperandMap, name, [&] { return new GlobalOperand(name); });
     }
 
     LabelOperand* OperandFactory::getLabelOperand(size_t num)
     {
-        auto it = LabelOperandMap.find(num);
-        if (it == LabelOperandMap.end())
-        {
-            LabelOperand* op     = new LabelOperand(num);
-            LabelOperandMap[num] = op;
-            return op;
-        }
-        return it->second;
+        return intern(LabelOperandMap, num, [&] { return new LabelOperand(num); });
     }
 
     OperandFactory& ofInstance = OperandFactory::getInstance();
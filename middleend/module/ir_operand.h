@@ -7,6 +7,8 @@
 #include <string>
 #include <sstream>
 #include <map>
+#include <mutex>
+#include <shared_mutex>
 
 namespace ME
 {
@@ -113,8 +115,13 @@ namespace ME
     };
 
     class OperandFactory
-    {
+    { /*
+       * 操作数均为全局共享的不可变对象，由工厂按值去重
+       * 函数级 pass 可能在多个线程上并发运行，因此查找与插入由读写锁保护
+       */
       private:
+        mutable std::shared_mutex mtx;
+
         std::map<int, ImmeI32Operand*>        ImmeI32OperandMap;
         std::map<float, ImmeF32Operand*>      ImmeF32OperandMap;
         std::map<size_t, RegOperand*>         RegOperandMap;
@@ -124,6 +131,20 @@ namespace ME
         OperandFactory() = default;
         ~OperandFactory();
 
+        template <typename Map, typename Key, typename Create>
+        typename Map::mapped_type intern(Map& map, const Key& key, Create create)
+        {
+            {
+                std::shared_lock<std::shared_mutex> lock(mtx);
+                auto                                it = map.find(key);
+                if (it != map.end()) return it->second;
+            }
+            std::unique_lock<std::shared_mutex> lock(mtx);
+            auto&                               slot = map[key];
+            if (!slot) slot = create();
+            return slot;
+        }
+
       public:
         RegOperand*     getRegOperand(size_t id);
         ImmeI32Operand* getImmeI32Operand(int value);
@@ -0,0 +1,82 @@
+#include <middleend/module/ir_utils.h>
+#include <middleend/module/ir_operand.h>
+
+namespace ME
+{
+    size_t labelOf(Operand* op) { return static_cast<LabelOperand*>(op)->lnum; }
+
+    ICmpOp swapPredicate(ICmpOp pred)
+    {
+        switch (pred)
+        {
+            case ICmpOp::SLT: return ICmpOp::SGT;
+            case ICmpOp::SGT: return ICmpOp::SLT;
+            case ICmpOp::SLE: return ICmpOp::SGE;
+            case ICmpOp::SGE: return ICmpOp::SLE;
+            case ICmpOp::ULT: return ICmpOp::UGT;
+            case ICmpOp::UGT: return ICmpOp::ULT;
+            case ICmpOp::ULE: return ICmpOp::UGE;
+            case ICmpOp::UGE: return ICmpOp::ULE;
+            default: return pred;
+        }
+    }
+
+    FCmpOp swapPredicate(FCmpOp pred)
+    {
+        switch (pred)
+        {
+            case FCmpOp::OGT: return FCmpOp::OLT;
+            case FCmpOp::OGE: return FCmpOp::OLE;
+            case FCmpOp::OLT: return FCmpOp::OGT;
+            case FCmpOp::OLE: return FCmpOp::OGE;
+            case FCmpOp::UGT: return FCmpOp::ULT;
+            case FCmpOp::UGE: return FCmpOp::ULE;
+            case FCmpOp::ULT: return FCmpOp::UGT;
+            case FCmpOp::ULE: return FCmpOp::UGE;
+            default: return pred;
+        }
+    }
+
+    ICmpOp invertPredicate(ICmpOp pred)
+    {
+        switch (pred)
+        {
+            case ICmpOp::EQ: return ICmpOp::NE;
+            case ICmpOp::NE: return ICmpOp::EQ;
+            case ICmpOp::SLT: return ICmpOp::SGE;
+            case ICmpOp::SGE: return ICmpOp::SLT;
+            case ICmpOp::SGT: return ICmpOp::SLE;
+            case ICmpOp::SLE: return ICmpOp::SGT;
+            case ICmpOp::ULT: return ICmpOp::UGE;
+            case ICmpOp::UGE: return ICmpOp::ULT;
+            case ICmpOp::UGT: return ICmpOp::ULE;
+            case ICmpOp::ULE: return ICmpOp::UGT;
+            default: return pred;
+        }
+    }
+
+    bool evaluateICmp(ICmpOp pred, int lhs, int rhs)
+    {
+        unsigned ulhs = static_cast<unsigned>(lhs), urhs = static_cast<unsigned>(rhs);
+        switch (pred)
+        {
+            case ICmpOp::EQ: return lhs == rhs;
+            case ICmpOp::NE: return lhs != rhs;
+            case ICmpOp::UGT: return ulhs > urhs;
+            case ICmpOp::UGE: return ulhs >= urhs;
+            case ICmpOp::ULT: return ulhs < urhs;
+            case ICmpOp::ULE: return ulhs <= urhs;
+            case ICmpOp::SGT: return lhs > rhs;
+            case ICmpOp::SGE: return lhs >= rhs;
+            case ICmpOp::SLT: return lhs < rhs;
+            default: return lhs <= rhs;
+        }
+    }
+
+    long long getGEPStride(const GEPInst& gep, size_t index)
+    {
+        long long stride = 1;
+        for (size_t k = index; k < gep.dims.size(); ++k) stride *= gep.dims[k];
+        return stride;
+    }
+}  // namespace ME
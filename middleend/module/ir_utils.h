@@ -0,0 +1,28 @@
+#ifndef __MIDDLEEND_MODULE_IR_UTILS_H__
+#define __MIDDLEEND_MODULE_IR_UTILS_H__
+
+#include <middleend/module/ir_instruction.h>
+#include <cstddef>
+
+/*
+ * pass 与分析共用的 IR 辅助函数
+ * - labelOf: 标签操作数对应的块编号。
+ * - swapPredicate: 交换比较两侧操作数后的等价谓词 (对称谓词不变); invertPredicate: 整数比较结果取反后的谓词。
+ * - evaluateICmp: 按 i32 语义计算两个常数的比较结果，无符号谓词按 32 位无符号数比较。
+ * - getGEPStride: getelementptr 第 index 个下标的步长 (以标量元素为单位)，即 dims[index..] 的乘积;
+ *   第 0 个下标跨过整个 dims 描述的对象。
+ */
+
+namespace ME
+{
+    size_t labelOf(Operand* op);
+
+    ICmpOp swapPredicate(ICmpOp pred);
+    FCmpOp swapPredicate(FCmpOp pred);
+    ICmpOp invertPredicate(ICmpOp pred);
+    bool   evaluateICmp(ICmpOp pred, int lhs, int rhs);
+
+    long long getGEPStride(const GEPInst& gep, size_t index);
+}  // namespace ME
+
+#endif  // __MIDDLEEND_MODULE_IR_UTILS_H__
@@ -0,0 +1,217 @@
+#include <middleend/pass/adce.h>
+#include <middleend/pass/analysis/analysis_manager.h>
+#include <middleend/pass/analysis/dominfo.h>
+#include <middleend/pass/analysis/loop_info.h>
+#include <middleend/pass/analysis/postdominfo.h>
+#include <middleend/module/ir_module.h>
+#include <middleend/module/ir_operand.h>
+#include <middleend/module/ir_utils.h>
+#include <middleend/visitor/utils/operand_visitor.h>
+#include <algorithm>
+
+namespace ME
+{
+    namespace
+    {
+        bool isPointerType(DataType type) { return type == DataType::PTR || type == DataType::F32_PTR; }
+    }  // namespace
+
+    PreservedAnalyses ADCEPass::runOnFunction(Function& function)
+    {
+        cfg         = Analysis::AM.get<Analysis::CFG>(function);
+        controlDeps = Analysis::AM.get<Analysis::ControlDependence>(function);
+        aa          = Analysis::AM.get<Analysis::AliasAnalysis>(function);
+        callGraph   = Analysis::AM.get<Analysis::CallGraph>(*function.parent);
+
+        // 直接后支配者为自身表示只被虚拟出口后支配
+        const auto& ipdom = Analysis::AM.get<Analysis::PostDomInfo>(function)->getImmPostDom();
+
+        readsAllLocals = false;
+        defs.clear();
+        instBlock.clear();
+        localWriters.clear();
+        readLocals.clear();
+        live.clear();
+        liveBlocks.assign(cfg->size(), 0);
+        worklist.clear();
+
+        std::vector<Instruction*> roots;
+        for (size_t id : cfg->getRPO())
+            for (auto* inst : cfg->getBlock(id)->insts)
+            {
+                instBlock[inst] = id;
+                if (Operand* def = getDefOperand(*inst)) defs[def] = inst;
+                if (inst->opcode == Operator::BR_COND && static_cast<size_t>(ipdom[id]) == id)
+                    roots.push_back(inst);
+                else if (classify(inst))
+                    roots.push_back(inst);
+            }
+        for (auto* inst : roots) markLive(inst);
+        propagate();
+
+        // 不活跃的条件跳转改为跳到直接后支配者，其它不活跃的指令删除
+        bool cfgChanged   = false;
+        bool changed      = false;
+        bool callsRemoved = false;
+        for (size_t id : cfg->getRPO())
+        {
+            Block* block = cfg->getBlock(id);
+            auto&  insts = block->insts;
+            if (!insts.empty() && insts.back()->opcode == Operator::BR_COND && !live.count(insts.back()))
+            {
+                auto*  br     = static_cast<BrCondInst*>(insts.back());
+                size_t target = static_cast<size_t>(ipdom[id]);
+
+                // 原后继中除 target 外不再以本块为前驱; 它们若仍然可达，phi 中来自本块的来源也必然不活跃
+                Operand* label = getLabelOperand(id);
+                for (size_t succ : cfg->succs(id))
+                {
+                    if (succ == target) continue;
+                    for (auto* inst : cfg->getBlock(succ)->insts)
+                    {
+                        if (inst->opcode != Operator::PHI) break;
+                        static_cast<PhiInst*>(inst)->incomingVals.erase(label);
+                    }
+                }
+                insts.back() = new BrUncondInst(getLabelOperand(target));
+                live.insert(insts.back());
+                delete br;
+                cfgChanged = true;
+            }
+
+            auto dead = std::stable_partition(insts.begin(), insts.end(), [&](Instruction* inst) {
+                return inst->isTerminator() || live.count(inst);
+            });
+            if (dead == insts.end()) continue;
+            for (auto it = dead; it != insts.end(); ++it)
+            {
+                callsRemoved |= (*it)->opcode == Operator::CALL;
+                delete *it;
+            }
+            insts.erase(dead, insts.end());
+            changed = true;
+        }
+
+        defs.clear();
+        instBlock.clear();
+        localWriters.clear();
+        readLocals.clear();
+        live.clear();
+
+        if (cfgChanged)
+        {
+            Analysis::CFG::removeUnreachableBlocks(function);
+            return PreservedAnalyses::none();
+        }
+        if (!changed) return PreservedAnalyses::all();
+
+        // 只删除了指令，控制流不变; 删除了调用时调用图中记录的调用点失效
+        PreservedAnalyses pa = PreservedAnalyses::none();
+        pa.preserve<Analysis::CFG>()
+            .preserve<Analysis::DomInfo>()
+            .preserve<Analysis::PostDomInfo>()
+            .preserve<Analysis::ControlDependence>()
+            .preserve<Analysis::LoopInfo>();
+        if (!callsRemoved) pa.preserve<Analysis::CallGraph>();
+        return pa;
+    }
+
+    bool ADCEPass::classify(Instruction* inst)
+    {
+        switch (inst->opcode)
+        {
+            case Operator::RET: return true;
+            case Operator::STORE:
+            {
+                auto& loc = aa->getLocation(static_cast<StoreInst*>(inst)->ptr);
+                if (loc.kind != Analysis::MemoryLocation::Kind::Alloca) return true;
+                localWriters[loc.base].push_back(inst);
+                return false;
+            }
+            case Operator::CALL:
+            {
+                auto*       call    = static_cast<CallInst*>(inst);
+                const auto& summary = callGraph->getSummary(*call);
+                if (summary.doesIO || summary.writesGlobals) return true;
+                if (!summary.writesArgMemory) return false;
+
+                std::vector<Operand*> bases;
+                for (auto& [type, arg] : call->args)
+                {
+                    if (!isPointerType(type)) continue;
+                    auto& loc = aa->getLocation(arg);
+                    if (loc.kind != Analysis::MemoryLocation::Kind::Alloca) return true;
+                    bases.push_back(loc.base);
+                }
+                for (Operand* base : bases) localWriters[base].push_back(inst);
+                return false;
+            }
+            default: return false;
+        }
+    }
+
+    void ADCEPass::markLive(Instruction* inst)
+    {
+        if (live.insert(inst).second) worklist.push_back(inst);
+    }
+
+    void ADCEPass::markBlockLive(size_t block)
+    {
+        if (liveBlocks[block]) return;
+        liveBlocks[block] = 1;
+        for (size_t controller : controlDeps->getControllingBlocks(block))
+            markLive(Analysis::CFG::getTerminator(cfg->getBlock(controller)));
+    }
+
+    void ADCEPass::markRead(Operand* ptr)
+    {
+        auto& loc = aa->getLocation(ptr);
+        if (loc.kind == Analysis::MemoryLocation::Kind::Alloca)
+        {
+            if (readsAllLocals || !readLocals.insert(loc.base).second) return;
+            auto it = localWriters.find(loc.base);
+            if (it != localWriters.end())
+                for (auto* writer : it->second) markLive(writer);
+            return;
+        }
+        if (loc.kind != Analysis::MemoryLocation::Kind::Unknown || readsAllLocals) return;
+        readsAllLocals = true;
+        for (auto& [base, writers] : localWriters)
+            for (auto* writer : writers) markLive(writer);
+    }
+
+    void ADCEPass::propagate()
+    {
+        while (!worklist.empty())
+        {
+            Instruction* inst = worklist.back();
+            worklist.pop_back();
+
+            // 无条件跳转不决定任何值，保留它不要求所在块被执行
+            if (inst->opcode != Operator::BR_UNCOND) markBlockLive(instBlock[inst]);
+
+            for (Operand** use : collectOperands(*inst).uses)
+            {
+                auto it = defs.find(*use);
+                if (it != defs.end()) markLive(it->second);
+            }
+
+            switch (inst->opcode)
+            {
+                case Operator::PHI:
+                    for (auto& [label, val] : static_cast<PhiInst*>(inst)->incomingVals)
+                    {
+                        size_t pred = labelOf(label);
+                        if (cfg->contains(pred)) markBlockLive(pred);
+                    }
+                    break;
+                case Operator::LOAD: markRead(static_cast<LoadInst*>(inst)->ptr); break;
+                case Operator::CALL:
+                    for (auto& [type, arg] : static_cast<CallInst*>(inst)->args)
+                        if (isPointerType(type)) markRead(arg);
+                    break;
+                default: break;
+            }
+        }
+    }
+}  // namespace ME
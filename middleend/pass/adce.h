@@ -0,0 +1,65 @@
+#ifndef __MIDDLEEND_PASS_ADCE_H__
+#define __MIDDLEEND_PASS_ADCE_H__
+
+#include <interfaces/middleend/pass.h>
+#include <middleend/module/ir_function.h>
+#include <middleend/module/ir_block.h>
+#include <middleend/module/ir_instruction.h>
+#include <middleend/pass/analysis/alias_analysis.h>
+#include <middleend/pass/analysis/call_graph.h>
+#include <middleend/pass/analysis/cfg.h>
+#include <middleend/pass/analysis/control_dependence.h>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/*
+ * 激进死代码消除 (adce，也注册为 dce)
+ * - 先假定所有指令都是死的，只把有副作用的指令标为活跃:
+ *   ret; 写全局变量、指针形参或地址无法确定的内存的 store; 做 I/O、写全局变量或写上述内存的 call;
+ *   条件跳转所在块的直接后支配者为虚拟出口时 (分支通向不同的死循环或出口)，该跳转也视为活跃。
+ * - 活跃性沿以下关系传播到不动点:
+ *   - 活跃指令的操作数的定义; phi 的各来源块视为活跃块。
+ *   - 活跃块所控制依赖的块的条件跳转 (ControlDependence)。无条件跳转总是保留，但不使所在块活跃。
+ *   - 只写本地 alloca 的 store / call 暂不活跃，直到某条活跃的 load 或 call 可能读取该 alloca
+ *     (由 AliasAnalysis 确定基对象，基对象无法确定时视为读取所有 alloca)。
+ * - 改写: 不活跃的条件跳转改为跳转到所在块的直接后支配者 (它所控制的区域中没有活跃指令)，
+ *   其余不活跃的指令直接删除; 随后重建 CFG 删除不可达块，因此没有副作用的循环整个被删除。
+ * - 不考虑被删除的循环或调用是否终止。
+ */
+
+namespace ME
+{
+    class ADCEPass : public FunctionPass
+    {
+      public:
+        ADCEPass()  = default;
+        ~ADCEPass() = default;
+
+        PreservedAnalyses runOnFunction(Function& function) override;
+
+      private:
+        Analysis::CFG*                                          cfg            = nullptr;
+        Analysis::ControlDependence*                            controlDeps    = nullptr;
+        Analysis::AliasAnalysis*                                aa             = nullptr;
+        Analysis::CallGraph*                                    callGraph      = nullptr;
+        bool                                                    readsAllLocals = false;
+        std::unordered_map<Operand*, Instruction*>              defs;
+        std::unordered_map<Instruction*, size_t>                instBlock;
+        std::unordered_map<Operand*, std::vector<Instruction*>> localWriters;  // alloca -> 只写它的 store / call
+        std::unordered_set<Operand*>                            readLocals;
+        std::unordered_set<Instruction*>                        live;
+        std::vector<char>                                       liveBlocks;
+        std::vector<Instruction*>                               worklist;
+
+      private:
+        // 返回指令是否是活跃性的起点; 只写本地 alloca 的指令登记到 localWriters
+        bool classify(Instruction* inst);
+        void markLive(Instruction* inst);
+        void markBlockLive(size_t block);
+        void markRead(Operand* ptr);
+        void propagate();
+    };
+}  // namespace ME
+
+#endif  // __MIDDLEEND_PASS_ADCE_H__
@@ -0,0 +1,218 @@
+#include <middleend/pass/analysis/alias_analysis.h>
+#include <middleend/pass/analysis/call_graph.h>
+#include <middleend/module/ir_function.h>
+#include <middleend/module/ir_block.h>
+#include <middleend/module/ir_instruction.h>
+#include <middleend/module/ir_operand.h>
+#include <middleend/module/ir_utils.h>
+#include <middleend/visitor/utils/operand_visitor.h>
+#include <algorithm>
+
+namespace ME::Analysis
+{
+    namespace
+    {
+        void addTerm(MemoryLocation& loc, Operand* index, long long stride)
+        {
+            auto it = std::lower_bound(loc.terms.begin(),
+                loc.terms.end(),
+                index,
+                [](const std::pair<Operand*, long long>& term, Operand* op) { return term.first < op; });
+            if (it != loc.terms.end() && it->first == index)
+            {
+                it->second += stride;
+                if (it->second == 0) loc.terms.erase(it);
+            }
+            else
+                loc.terms.insert(it, {index, stride});
+        }
+
+        bool isPointerType(DataType type) { return type == DataType::PTR || type == DataType::F32_PTR; }
+    }  // namespace
+
+    void AliasAnalysis::build(Function& func, const CallGraph* graph)
+    {
+        callGraph = graph;
+        defs.clear();
+        args.clear();
+        locations.clear();
+        for (auto& arg : func.funcDef->argRegs) args.insert(arg.second);
+        for (auto& [id, block] : func.blocks)
+            for (auto* inst : block->insts)
+                if (Operand* def = getDefOperand(*inst)) defs[def] = inst;
+    }
+
+    const MemoryLocation& AliasAnalysis::getLocation(Operand* ptr) const
+    {
+        auto it = locations.find(ptr);
+        if (it != locations.end()) return it->second;
+
+        // 先放入 Unknown 占位，phi 成环时得到保守的结果
+        locations.emplace(ptr, MemoryLocation());
+        MemoryLocation loc = decompose(ptr);
+        return locations[ptr] = std::move(loc);
+    }
+
+    MemoryLocation AliasAnalysis::decompose(Operand* ptr) const
+    {
+        MemoryLocation loc;
+        if (!ptr) return loc;
+        if (ptr->getType() == OperandType::GLOBAL)
+        {
+            loc.kind        = MemoryLocation::Kind::Global;
+            loc.base        = ptr;
+            loc.offsetKnown = true;
+            return loc;
+        }
+        if (ptr->getType() != OperandType::REG) return loc;
+        if (args.count(ptr))
+        {
+            loc.kind        = MemoryLocation::Kind::Argument;
+            loc.base        = ptr;
+            loc.offsetKnown = true;
+            return loc;
+        }
+
+        auto it = defs.find(ptr);
+        if (it == defs.end()) return loc;
+        Instruction* inst = it->second;
+
+        if (inst->opcode == Operator::ALLOCA)
+        {
+            loc.kind        = MemoryLocation::Kind::Alloca;
+            loc.base        = ptr;
+            loc.offsetKnown = true;
+            return loc;
+        }
+
+        if (inst->opcode == Operator::GETELEMENTPTR)
+        {
+            auto* gep = static_cast<GEPInst*>(inst);
+            loc       = getLocation(gep->basePtr);
+            if (loc.kind == MemoryLocation::Kind::Unknown || !loc.offsetKnown) return loc;
+
+            for (size_t j = 0; j < gep->idxs.size(); ++j)
+            {
+                long long stride = getGEPStride(*gep, j);
+                Operand*  idx    = gep->idxs[j];
+                if (idx->getType() == OperandType::IMMEI32)
+                    loc.offset += stride * static_cast<ImmeI32Operand*>(idx)->value;
+                else if (idx->getType() == OperandType::REG)
+                    addTerm(loc, idx, stride);
+                else
+                {
+                    loc.offsetKnown = false;
+                    loc.offset      = 0;
+                    loc.terms.clear();
+                    break;
+                }
+            }
+            return loc;
+        }
+
+        if (inst->opcode == Operator::PHI)
+        {
+            bool first = true;
+            for (auto& [label, val] : static_cast<PhiInst*>(inst)->incomingVals)
+            {
+                MemoryLocation in = getLocation(val);
+                if (in.kind == MemoryLocation::Kind::Unknown) return MemoryLocation();
+                if (first)
+                {
+                    loc   = std::move(in);
+                    first = false;
+                    continue;
+                }
+                if (in.base != loc.base) return MemoryLocation();
+                if (!in.offsetKnown || in.offset != loc.offset || in.terms != loc.terms)
+                {
+                    loc.offsetKnown = false;
+                    loc.offset      = 0;
+                    loc.terms.clear();
+                }
+            }
+            return loc;
+        }
+
+        return loc;
+    }
+
+    bool AliasAnalysis::mayShareObject(Operand* a, Operand* b) const
+    {
+        getLocation(a);
+        const MemoryLocation& locB = getLocation(b);
+        const MemoryLocation& locA = locations.find(a)->second;
+
+        if (locA.kind == MemoryLocation::Kind::Unknown || locB.kind == MemoryLocation::Kind::Unknown) return true;
+        if (locA.base == locB.base) return true;
+        if (locA.kind == MemoryLocation::Kind::Alloca || locB.kind == MemoryLocation::Kind::Alloca) return false;
+        return !(locA.isIdentifiedObject() && locB.isIdentifiedObject());
+    }
+
+    AliasResult AliasAnalysis::alias(Operand* a, Operand* b) const
+    {
+        if (a == b) return AliasResult::MustAlias;
+        if (!mayShareObject(a, b)) return AliasResult::NoAlias;
+
+        const MemoryLocation& locA = locations.find(a)->second;
+        const MemoryLocation& locB = locations.find(b)->second;
+        if (locA.kind == MemoryLocation::Kind::Unknown || locA.base != locB.base) return AliasResult::MayAlias;
+        if (!locA.offsetKnown || !locB.offsetKnown || locA.terms != locB.terms) return AliasResult::MayAlias;
+        return locA.offset == locB.offset ? AliasResult::MustAlias : AliasResult::NoAlias;
+    }
+
+    ModRefInfo AliasAnalysis::getModRef(const CallInst& call, Operand* ptr) const
+    {
+        static const FunctionSummary unknown = [] {
+            FunctionSummary summary;
+            summary.readsGlobals    = true;
+            summary.writesGlobals   = true;
+            summary.readsArgMemory  = true;
+            summary.writesArgMemory = true;
+            return summary;
+        }();
+        const FunctionSummary& summary = callGraph ? callGraph->getSummary(call) : unknown;
+
+        ModRefInfo result = ModRefInfo::NoModRef;
+        if (getLocation(ptr).kind != MemoryLocation::Kind::Alloca)
+        {
+            if (summary.readsGlobals) result = result | ModRefInfo::Ref;
+            if (summary.writesGlobals) result = result | ModRefInfo::Mod;
+        }
+        if (!summary.readsArgMemory && !summary.writesArgMemory) return result;
+
+        for (auto& [type, arg] : call.args)
+        {
+            if (!isPointerType(type) || !mayShareObject(arg, ptr)) continue;
+            if (summary.readsArgMemory) result = result | ModRefInfo::Ref;
+            if (summary.writesArgMemory) result = result | ModRefInfo::Mod;
+        }
+        return result;
+    }
+
+    ModRefInfo AliasAnalysis::getModRef(Instruction& inst, Operand* ptr) const
+    {
+        switch (inst.opcode)
+        {
+            case Operator::LOAD:
+                return isNoAlias(static_cast<LoadInst&>(inst).ptr, ptr) ? ModRefInfo::NoModRef : ModRefInfo::Ref;
+            case Operator::STORE:
+                return isNoAlias(static_cast<StoreInst&>(inst).ptr, ptr) ? ModRefInfo::NoModRef : ModRefInfo::Mod;
+            case Operator::CALL: return getModRef(static_cast<CallInst&>(inst), ptr);
+            default: return ModRefInfo::NoModRef;
+        }
+    }
+
+    template <>
+    AliasAnalysis* Manager::get<AliasAnalysis>(Function& func)
+    {
+        if (auto* cached = getCached<AliasAnalysis>(func)) return cached;
+
+        registerDependency<AliasAnalysis, CallGraph>();
+        CallGraph* callGraph = func.parent ? get<CallGraph>(*func.parent) : nullptr;
+
+        auto* aliasAnalysis = new AliasAnalysis();
+        aliasAnalysis->build(func, callGraph);
+        return cache<AliasAnalysis>(func, aliasAnalysis);
+    }
+}  // namespace ME::Analysis
@@ -0,0 +1,111 @@
+#ifndef __MIDDLEEND_PASS_ANALYSIS_ALIAS_ANALYSIS_H__
+#define __MIDDLEEND_PASS_ANALYSIS_ALIAS_ANALYSIS_H__
+
+#include <middleend/pass/analysis/analysis_manager.h>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/*
+ * 别名分析与 mod/ref 查询
+ * - 通过 Analysis::AM.get<AliasAnalysis>(function) 获取，依赖模块级的 CallGraph (函数须设置 parent)。
+ * - 指针被分解为 "基对象 + 偏移": 基对象为 alloca 的结果、全局变量或指针形参; 偏移以标量元素为单位，
+ *   由 getelementptr 链按 dims 计算，分为常数部分与 "变量下标 * 步长" 的符号部分。
+ *   各 incoming 基对象相同的 phi 保留基对象，但偏移视为未知。其余来源的指针为 Unknown。
+ * - alias(a, b) 回答通过 a、b 各访问一个标量元素时是否重叠 (load/store 的访问都是如此):
+ *   - 不同的 alloca / 全局变量互不别名; alloca 不可能经由形参传入，与形参也互不别名;
+ *     全局变量与形参、形参与形参之间可能别名 (调用者可能传入同一数组)。
+ *   - 基对象相同且符号部分相同时，由常数部分是否相等给出 MustAlias / NoAlias，否则为 MayAlias。
+ * - getModRef(call, ptr): SysY 中指针不能被存入内存，被调用者只能经由全局变量或本次调用的指针实参访问调用者的数组，
+ *   因此 (1) 若 ptr 可能指向全局变量，按 CallGraph 摘要中对全局变量的读写计入;
+ *   (2) 对每个可能与 ptr 属于同一对象的指针实参 (被调用者可以访问实参之后的整个对象)，按摘要中对形参内存的读写计入。
+ *   未逃逸到本次调用实参中的局部数组因此不会被调用修改。
+ * - 分解结果按指针缓存; 分析对象只应由处理该函数的线程使用。
+ */
+
+namespace ME
+{
+    class Operand;
+    class Function;
+    class Instruction;
+    class CallInst;
+}  // namespace ME
+
+namespace ME::Analysis
+{
+    class CallGraph;
+
+    enum class AliasResult
+    {
+        NoAlias,
+        MayAlias,
+        MustAlias
+    };
+
+    enum class ModRefInfo
+    {
+        NoModRef = 0,
+        Ref      = 1,
+        Mod      = 2,
+        ModRef   = 3
+    };
+
+    inline ModRefInfo operator|(ModRefInfo a, ModRefInfo b) { return ModRefInfo((int)a | (int)b); }
+    inline bool       isModSet(ModRefInfo info) { return (int)info & (int)ModRefInfo::Mod; }
+    inline bool       isRefSet(ModRefInfo info) { return (int)info & (int)ModRefInfo::Ref; }
+
+    struct MemoryLocation
+    {
+        enum class Kind
+        {
+            Alloca,
+            Global,
+            Argument,
+            Unknown
+        };
+
+        Kind      kind        = Kind::Unknown;
+        Operand*  base        = nullptr;
+        bool      offsetKnown = false;
+        long long offset      = 0;                         // 常数部分
+        std::vector<std::pair<Operand*, long long>> terms;  // (变量下标, 步长)，按操作数地址排序
+
+        bool isIdentifiedObject() const { return kind == Kind::Alloca || kind == Kind::Global; }
+    };
+
+    class AliasAnalysis
+    {
+      public:
+        static inline const size_t TID = getTID<AliasAnalysis>();
+
+      private:
+        const CallGraph*                                   callGraph = nullptr;
+        std::unordered_map<Operand*, Instruction*>         defs;
+        std::unordered_set<Operand*>                       args;
+        mutable std::unordered_map<Operand*, MemoryLocation> locations;
+
+      public:
+        void build(Function& func, const CallGraph* callGraph);
+
+        const MemoryLocation& getLocation(Operand* ptr) const;
+
+        AliasResult alias(Operand* a, Operand* b) const;
+        bool        isNoAlias(Operand* a, Operand* b) const { return alias(a, b) == AliasResult::NoAlias; }
+        bool        isMustAlias(Operand* a, Operand* b) const { return alias(a, b) == AliasResult::MustAlias; }
+
+        // a 与 b 是否可能指向同一个对象 (不考虑偏移)
+        bool mayShareObject(Operand* a, Operand* b) const;
+
+        ModRefInfo getModRef(const CallInst& call, Operand* ptr) const;
+        // load 读、store 写、call 按上面的规则; 其余指令不访问内存
+        ModRefInfo getModRef(Instruction& inst, Operand* ptr) const;
+
+      private:
+        MemoryLocation decompose(Operand* ptr) const;
+    };
+
+    template <>
+    AliasAnalysis* Manager::get<AliasAnalysis>(Function& func);
+}  // namespace ME::Analysis
+
+#endif  // __MIDDLEEND_PASS_ANALYSIS_ALIAS_ANALYSIS_H__
@@ -1,19 +1,35 @@
 #include <middleend/pass/analysis/analysis_manager.h>
+#include <algorithm>
+#include <iterator>
 
 namespace ME::Analysis
 {
     Manager& AM = Manager::getInstance();
 
-    Manager::~Manager()
+    void PreservedAnalyses::intersect(const PreservedAnalyses& other)
     {
-        for (auto& funcCachePair : analysisCache)
+        if (other.preserveAll) return;
+        if (preserveAll)
         {
-            for (auto& analysisPair : funcCachePair.second)
-            {
-                auto deleterIt = deleterMap.find(analysisPair.first);
-                if (deleterIt != deleterMap.end()) deleterIt->second(analysisPair.second);
-            }
+            *this = other;
+            return;
         }
+
+        std::set<size_t> result;
+        std::set_intersection(preserved.begin(),
+            preserved.end(),
+            other.preserved.begin(),
+            other.preserved.end(),
+            std::inserter(result, result.begin()));
+        preserved = std::move(result);
+    }
+
+    Manager::~Manager()
+    {
+        for (auto& funcCachePair : analysisCache)
+            for (auto& analysisPair : funcCachePair.second) destroy(analysisPair.first, analysisPair.second);
+        for (auto& moduleCachePair : moduleCache)
+            for (auto& analysisPair : moduleCachePair.second) destroy(analysisPair.first, analysisPair.second);
     }
 
     Manager& Manager::getInstance()
@@ -22,15 +38,117 @@ namespace ME::Analysis
         return instance;
     }
 
-    void Manager::invalidate(Function& func)
+    Manager::CacheStats Manager::getTotalStats() const
     {
-        auto it = analysisCache.find(&func);
-        if (it == analysisCache.end()) return;
-        for (auto& analysisPair : it->second)
+        std::lock_guard<std::mutex> lock(mtx);
+        CacheStats                  total;
+        for (auto& [tid, stats] : cacheStats)
+        {
+            total.hits += stats.hits;
+            total.misses += stats.misses;
+        }
+        return total;
+    }
+
+    void Manager::resetStats()
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        cacheStats.clear();
+    }
+
+    void Manager::destroy(size_t tid, void* analysis)
+    {
+        auto deleterIt = deleterMap.find(tid);
+        if (deleterIt != deleterMap.end()) deleterIt->second(analysis);
+    }
+
+    std::set<size_t> Manager::abandon(AnalysisMap& map, const PreservedAnalyses& pa)
+    {
+        if (pa.areAllPreserved() || map.empty()) return {};
+
+        // 未被保留的分析作为起点，沿依赖图向上传播
+        // 即使某个分析被声明为保留，只要它依赖的分析失效了，它也需要重新计算
+        std::set<size_t>    dead;
+        std::vector<size_t> worklist;
+        for (auto& [tid, analysis] : map)
+        {
+            if (pa.isPreserved(tid)) continue;
+            if (dead.insert(tid).second) worklist.push_back(tid);
+        }
+        while (!worklist.empty())
+        {
+            size_t tid = worklist.back();
+            worklist.pop_back();
+
+            auto it = dependents.find(tid);
+            if (it == dependents.end()) continue;
+            for (size_t user : it->second)
+                if (dead.insert(user).second) worklist.push_back(user);
+        }
+
+        purge(map, dead);
+        return dead;
+    }
+
+    void Manager::purge(AnalysisMap& map, const std::set<size_t>& dead)
+    {
+        for (size_t tid : dead)
         {
-            auto deleterIt = deleterMap.find(analysisPair.first);
-            if (deleterIt != deleterMap.end()) deleterIt->second(analysisPair.second);
+            auto it = map.find(tid);
+            if (it == map.end()) continue;
+            destroy(tid, it->second);
+            map.erase(it);
         }
-        analysisCache.erase(it);
+    }
+
+    void Manager::purgeFunctionDependents(const std::set<size_t>& dead)
+    {
+        if (dead.empty()) return;
+        for (auto& [func, map] : analysisCache) purge(map, dead);
+    }
+
+    void Manager::invalidate(Function& func) { invalidate(func, PreservedAnalyses::none()); }
+
+    void Manager::invalidate(Function& func, const PreservedAnalyses& pa)
+    {
+        invalidateFunctionAnalyses(func, pa);
+
+        // 模块级分析 (如调用图、函数副作用摘要) 汇总自各个函数体
+        // 函数被修改后，未被保留的模块级分析同样需要失效
+        std::lock_guard<std::mutex> lock(mtx);
+        for (auto& [module, map] : moduleCache) purgeFunctionDependents(abandon(map, pa));
+    }
+
+    void Manager::invalidate(Module& module) { invalidate(module, PreservedAnalyses::none()); }
+
+    void Manager::invalidate(Module& module, const PreservedAnalyses& pa)
+    {
+        if (pa.areAllPreserved()) return;
+
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            for (auto& [func, map] : analysisCache) abandon(map, pa);
+        }
+        invalidateModuleAnalyses(module, pa);
+    }
+
+    void Manager::invalidateFunctionAnalyses(Function& func, const PreservedAnalyses& pa)
+    {
+        if (pa.areAllPreserved()) return;
+
+        std::lock_guard<std::mutex> lock(mtx);
+        auto                        it = analysisCache.find(&func);
+        if (it == analysisCache.end()) return;
+        abandon(it->second, pa);
+        if (it->second.empty()) analysisCache.erase(it);
+    }
+
+    void Manager::invalidateModuleAnalyses(Module& module, const PreservedAnalyses& pa)
+    {
+        if (pa.areAllPreserved()) return;
+
+        std::lock_guard<std::mutex> lock(mtx);
+        auto                        it = moduleCache.find(&module);
+        if (it != moduleCache.end()) purgeFunctionDependents(abandon(it->second, pa));
     }
 }  // namespace ME::Analysis
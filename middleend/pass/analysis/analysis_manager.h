@@ -2,6 +2,7 @@
 #define __INTERFACES_MIDDLEEND_ANALYSIS_MANAGER_H__
 
 #include <functional>
+#include <mutex>
 #include <set>
 #include <type_utils.h>
 #include <unordered_map>
@@ -12,7 +13,16 @@
  *
  * 用法速览:
  * - 注册/获取分析: 通过 AM.get<YourAnalysis>(function) 获得并缓存某函数上的分析结果。
- * - 缓存失效: 当函数 IR 发生改变后，调用 AM.invalidate(function) 使相关分析失效。
+ *   模块级分析 (如调用图) 则通过 AM.get<YourAnalysis>(module) 获取。
+ * - 缓存失效: 当函数 IR 发生改变后，调用 AM.invalidate(function, pa) 使未被保留的分析失效。
+ *   pa 为 pass 返回的 PreservedAnalyses，未被保留的分析以及所有 (传递地) 依赖于它的分析都会被清理。
+ *   AM.invalidate(function) 等价于 pa = PreservedAnalyses::none()。
+ * - 依赖关系: 在 get<> 特化中通过 registerDependency<Target, Dep>() 声明 "Target 由 Dep 计算而来"，
+ *   例如 DomInfo 依赖 CFG，CFG 失效时 DomInfo 也会随之失效。
+ *   函数级分析也可以依赖模块级分析 (如 AliasAnalysis 依赖 CallGraph)，模块级分析失效时所有函数上的依赖者一并失效。
+ * - 线程安全: 缓存的查找、插入与失效由互斥锁保护，分析本身的构建在锁外进行。
+ *   并行执行函数 pass 时，各线程只调用 invalidateFunctionAnalyses 失效自己负责的函数，
+ *   模块级分析在所有线程结束后再由 invalidateModuleAnalyses 统一失效，避免其它线程仍在使用时被释放。
  * - 分析类需定义静态常量 TID = getTID<AP>()，用于唯一标识。
  *   该标识实际上是 getTID<AP>() 实例化后的函数地址。不同实例的 getTID<AP>()
  *   所在地址不同，因此我们可以将它用作每个类的唯一 ID
@@ -27,17 +37,72 @@ namespace ME
 
     namespace Analysis
     {
+        class PreservedAnalyses
+        { /*
+           * pass 运行后仍然有效的分析集合
+           * - all(): IR 未被修改，所有分析均有效
+           * - none(): 不保留任何分析
+           * - preserve<T>(): 在 none() 的基础上声明分析 T 仍然有效
+           */
+          private:
+            bool             preserveAll = false;
+            std::set<size_t> preserved;
+
+          public:
+            static PreservedAnalyses all()
+            {
+                PreservedAnalyses pa;
+                pa.preserveAll = true;
+                return pa;
+            }
+            static PreservedAnalyses none() { return PreservedAnalyses(); }
+
+            template <typename Target>
+            PreservedAnalyses& preserve()
+            {
+                preserved.insert(Target::TID);
+                return *this;
+            }
+
+            template <typename Target>
+            bool isPreserved() const
+            {
+                return isPreserved(Target::TID);
+            }
+            bool isPreserved(size_t tid) const { return preserveAll || preserved.count(tid); }
+            bool areAllPreserved() const { return preserveAll; }
+
+            // 求交集，用于合并多个函数上的运行结果
+            void intersect(const PreservedAnalyses& other);
+        };
+
         class Manager
         {
           private:
+            mutable std::mutex mtx;
+
             // 此处使用 utils/type_utils.h 的 getTID 来为每个分析类生成一个唯一的 ID
             // 类型为 uintptr_t(函数地址) -> size_t
             using AnalysisMap = std::unordered_map<size_t, void*>;
             std::unordered_map<Function*, AnalysisMap> analysisCache;
+            std::unordered_map<Module*, AnalysisMap>   moduleCache;
 
             using Deleter = void (*)(void*);
             std::unordered_map<size_t, Deleter> deleterMap;
 
+            // dependents[Dep] 为直接依赖 Dep 的分析集合
+            std::unordered_map<size_t, std::set<size_t>> dependents;
+
+          public:
+            struct CacheStats
+            {
+                size_t hits   = 0;
+                size_t misses = 0;
+            };
+
+          private:
+            std::unordered_map<size_t, CacheStats> cacheStats;
+
             Manager() = default;
             ~Manager();
 
@@ -47,9 +112,37 @@ namespace ME
             template <typename Target>
             Target* get(Function& func);
 
+            template <typename Target>
+            Target* get(Module& module);
+
+            // 失效函数级与模块级分析
             void invalidate(Function& func);
+            void invalidate(Function& func, const PreservedAnalyses& pa);
+            // 失效模块级分析以及模块内所有函数的分析
+            void invalidate(Module& module);
+            void invalidate(Module& module, const PreservedAnalyses& pa);
+
+            void invalidateFunctionAnalyses(Function& func, const PreservedAnalyses& pa);
+            void invalidateModuleAnalyses(Module& module, const PreservedAnalyses& pa);
+
+            template <typename Target>
+            CacheStats getStats() const
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                auto                        it = cacheStats.find(Target::TID);
+                return it == cacheStats.end() ? CacheStats() : it->second;
+            }
+            CacheStats getTotalStats() const;
+            void       resetStats();
 
           private:
+            template <typename Target, typename Dep>
+            void registerDependency()
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                dependents[Dep::TID].insert(Target::TID);
+            }
+
             template <typename Target>
             void registerDeleter()
             {
@@ -60,22 +153,66 @@ namespace ME
                 }
             }
 
+            // 返回最终被缓存的分析结果: 若其它线程已抢先缓存了同一分析，则丢弃 analysis 并返回已有结果
+            template <typename Target>
+            Target* cache(Function& func, Target* analysis)
+            {
+                return insert(analysisCache, &func, analysis);
+            }
+
             template <typename Target>
-            void cache(Function& func, Target* analysis)
+            Target* cache(Module& module, Target* analysis)
+            {
+                return insert(moduleCache, &module, analysis);
+            }
+
+            template <typename Key, typename Target>
+            Target* insert(std::unordered_map<Key*, AnalysisMap>& cacheMap, Key* key, Target* analysis)
             {
-                analysisCache[&func][Target::TID] = analysis;
+                std::lock_guard<std::mutex> lock(mtx);
+                registerDeleter<Target>();
+                auto [it, inserted] = cacheMap[key].emplace(Target::TID, analysis);
+                if (!inserted) delete analysis;
+                return static_cast<Target*>(it->second);
             }
 
             template <typename Target>
             Target* getCached(Function& func)
             {
-                if (analysisCache.count(&func))
+                return static_cast<Target*>(lookup(analysisCache, &func, Target::TID));
+            }
+
+            template <typename Target>
+            Target* getCached(Module& module)
+            {
+                return static_cast<Target*>(lookup(moduleCache, &module, Target::TID));
+            }
+
+            template <typename Key>
+            void* lookup(std::unordered_map<Key*, AnalysisMap>& cacheMap, Key* key, size_t tid)
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                auto&                       stats = cacheStats[tid];
+                auto                        it    = cacheMap.find(key);
+                if (it != cacheMap.end())
                 {
-                    auto& funcCache = analysisCache.at(&func);
-                    if (funcCache.count(Target::TID)) return static_cast<Target*>(funcCache.at(Target::TID));
+                    auto ait = it->second.find(tid);
+                    if (ait != it->second.end())
+                    {
+                        ++stats.hits;
+                        return ait->second;
+                    }
                 }
+                ++stats.misses;
                 return nullptr;
             }
+
+            // 从 map 中删除所有未被 pa 保留的分析以及依赖它们的分析，返回失效的分析集合 (含传递依赖者)
+            std::set<size_t> abandon(AnalysisMap& map, const PreservedAnalyses& pa);
+            void             purge(AnalysisMap& map, const std::set<size_t>& dead);
+            // 模块级分析失效后，删除各函数上依赖它们的函数级分析 (如依赖调用图的别名分析)
+            void purgeFunctionDependents(const std::set<size_t>& dead);
+            void destroy(size_t tid, void* analysis);
         };
 
         extern Manager& AM;
@@ -0,0 +1,141 @@
+#include <middleend/pass/analysis/available_exprs.h>
+#include <middleend/pass/analysis/cfg.h>
+#include <middleend/module/ir_function.h>
+#include <middleend/module/ir_block.h>
+#include <middleend/module/ir_instruction.h>
+#include <middleend/visitor/utils/operand_visitor.h>
+
+namespace ME::Analysis
+{
+    namespace
+    {
+        struct AvailableExprsProblem : BitVectorProblem<Direction::Forward, MeetOp::Intersection>
+        {
+            const char* name() const { return "available-exprs"; }
+        };
+    }  // namespace
+
+    bool AvailableExpressions::makeKey(Instruction& inst, ExprKey& key)
+    {
+        auto& attrs = key.first;
+        attrs.push_back(static_cast<long long>(inst.opcode));
+        switch (inst.opcode)
+        {
+            case Operator::ADD:
+            case Operator::SUB:
+            case Operator::MUL:
+            case Operator::DIV:
+            case Operator::MOD:
+            case Operator::FADD:
+            case Operator::FSUB:
+            case Operator::FMUL:
+            case Operator::FDIV:
+            case Operator::BITXOR:
+            case Operator::BITAND:
+            case Operator::SHL:
+            case Operator::ASHR:
+            case Operator::LSHR: attrs.push_back(static_cast<long long>(static_cast<ArithmeticInst&>(inst).dt)); break;
+            case Operator::ICMP:
+                attrs.push_back(static_cast<long long>(static_cast<IcmpInst&>(inst).dt));
+                attrs.push_back(static_cast<long long>(static_cast<IcmpInst&>(inst).cond));
+                break;
+            case Operator::FCMP:
+                attrs.push_back(static_cast<long long>(static_cast<FcmpInst&>(inst).dt));
+                attrs.push_back(static_cast<long long>(static_cast<FcmpInst&>(inst).cond));
+                break;
+            case Operator::LOAD: attrs.push_back(static_cast<long long>(static_cast<LoadInst&>(inst).dt)); break;
+            case Operator::GETELEMENTPTR:
+            {
+                auto& gep = static_cast<GEPInst&>(inst);
+                attrs.push_back(static_cast<long long>(gep.dt));
+                attrs.push_back(static_cast<long long>(gep.idxType));
+                for (int dim : gep.dims) attrs.push_back(dim);
+                break;
+            }
+            case Operator::ZEXT:
+                attrs.push_back(static_cast<long long>(static_cast<ZextInst&>(inst).from));
+                attrs.push_back(static_cast<long long>(static_cast<ZextInst&>(inst).to));
+                break;
+            case Operator::SITOFP:
+            case Operator::FPTOSI: break;
+            default: return false;
+        }
+
+        if (!getDefOperand(inst)) return false;
+        InstOperands ops = collectOperands(inst);
+        for (auto* use : ops.uses) key.second.push_back(*use);
+        return true;
+    }
+
+    void AvailableExpressions::build(CFG& cfg)
+    {
+        size_t blockCount = cfg.size();
+
+        exprs.clear();
+        exprIds.clear();
+        exprOf.clear();
+        std::vector<bool> isLoadExpr;
+        for (size_t id : cfg.getRPO())
+        {
+            for (auto* inst : cfg.getBlock(id)->insts)
+            {
+                ExprKey key;
+                if (!makeKey(*inst, key)) continue;
+                auto [it, inserted] = exprIds.emplace(std::move(key), exprs.size());
+                if (inserted)
+                {
+                    exprs.push_back(inst);
+                    isLoadExpr.push_back(inst->opcode == Operator::LOAD);
+                }
+                exprOf[inst] = it->second;
+            }
+        }
+
+        loadExprs = Cele::dynamic_bitset(exprs.size());
+        for (size_t i = 0; i < exprs.size(); ++i)
+            if (isLoadExpr[i]) loadExprs.set(i);
+
+        AvailableExprsProblem problem;
+        problem.init(blockCount, exprs.size());
+        for (size_t id : cfg.getRPO())
+        {
+            auto& gen  = problem.gen[id];
+            auto& kill = problem.kill[id];
+            for (auto* inst : cfg.getBlock(id)->insts)
+            {
+                if (inst->opcode == Operator::STORE || inst->opcode == Operator::CALL)
+                {
+                    gen.and_not_changed(loadExprs);
+                    kill |= loadExprs;
+                    continue;
+                }
+                auto it = exprOf.find(inst);
+                if (it != exprOf.end()) gen.set(it->second);
+            }
+        }
+
+        auto result = DataflowSolver<AvailableExprsProblem>::solve(cfg, problem);
+        availIn     = std::move(result.in);
+        availOut    = std::move(result.out);
+        stats       = result.stats;
+    }
+
+    size_t AvailableExpressions::getExprId(Instruction* inst) const
+    {
+        auto it = exprOf.find(inst);
+        return it == exprOf.end() ? npos : it->second;
+    }
+
+    template <>
+    AvailableExpressions* Manager::get<AvailableExpressions>(Function& func)
+    {
+        if (auto* cached = getCached<AvailableExpressions>(func)) return cached;
+
+        registerDependency<AvailableExpressions, CFG>();
+        auto* cfg = get<CFG>(func);
+
+        auto* available = new AvailableExpressions();
+        available->build(*cfg);
+        return cache<AvailableExpressions>(func, available);
+    }
+}  // namespace ME::Analysis
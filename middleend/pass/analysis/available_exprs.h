@@ -0,0 +1,63 @@
+#ifndef __MIDDLEEND_PASS_ANALYSIS_AVAILABLE_EXPRS_H__
+#define __MIDDLEEND_PASS_ANALYSIS_AVAILABLE_EXPRS_H__
+
+#include <middleend/pass/analysis/analysis_manager.h>
+#include <middleend/pass/analysis/dataflow.h>
+#include <dynamic_bitset.h>
+#include <map>
+#include <unordered_map>
+
+/*
+ * 可用表达式分析
+ * - 通过 Analysis::AM.get<AvailableExpressions>(function) 获取，依赖 CFG。
+ * - 跟踪的表达式为算术、比较、类型转换、getelementptr 与 load: 操作码、类型属性与操作数都相同的指令
+ *   视为同一个表达式。操作数已被驻留，因此按指针比较即按值比较。
+ *   表达式按逆后序中首次出现的位置编号，exprs[i] 为第 i 个表达式首次出现的指令。
+ * - SSA 寄存器的值不会改变，算术类表达式一经计算便一直可用; load 会被任意 store 与 call 杀死
+ *   (尚未使用别名分析，按最保守的方式处理)。
+ * - availIn/availOut 以块编号为下标，第 i 位表示表达式 i 在块首/块尾沿所有路径都已被计算过。
+ */
+
+namespace ME
+{
+    class Instruction;
+}  // namespace ME
+
+namespace ME::Analysis
+{
+    class AvailableExpressions
+    {
+      public:
+        static inline const size_t TID = getTID<AvailableExpressions>();
+
+        std::vector<Instruction*>         exprs;
+        std::vector<Cele::dynamic_bitset> availIn;   // 以块编号为下标
+        std::vector<Cele::dynamic_bitset> availOut;  // 以块编号为下标
+        DataflowStats                     stats;
+
+      private:
+        using ExprKey = std::pair<std::vector<long long>, std::vector<Operand*>>;
+
+        std::map<ExprKey, size_t>                 exprIds;
+        std::unordered_map<Instruction*, size_t>  exprOf;
+        Cele::dynamic_bitset                      loadExprs;
+
+      public:
+        void build(CFG& cfg);
+
+        // 指令计算的表达式编号，不参与分析的指令返回 npos
+        size_t getExprId(Instruction* inst) const;
+        bool   isLoad(size_t expr) const { return loadExprs.test(expr); }
+        bool   isAvailableIn(size_t block, size_t expr) const { return availIn[block].test(expr); }
+
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
+      private:
+        static bool makeKey(Instruction& inst, ExprKey& key);
+    };
+
+    template <>
+    AvailableExpressions* Manager::get<AvailableExpressions>(Function& func);
+}  // namespace ME::Analysis
+
+#endif  // __MIDDLEEND_PASS_ANALYSIS_AVAILABLE_EXPRS_H__
@@ -0,0 +1,365 @@
+#include <middleend/pass/analysis/call_graph.h>
+#include <middleend/module/ir_module.h>
+#include <middleend/module/ir_function.h>
+#include <middleend/module/ir_block.h>
+#include <middleend/module/ir_instruction.h>
+#include <middleend/module/ir_operand.h>
+#include <middleend/visitor/utils/operand_visitor.h>
+#include <algorithm>
+#include <cstdint>
+#include <unordered_set>
+
+namespace ME::Analysis
+{
+    namespace
+    {
+        // 指针来源，可按位组合
+        enum PointerRoot : unsigned
+        {
+            RootLocal  = 1,
+            RootGlobal = 2,
+            RootArg    = 4,
+            RootAny    = RootGlobal | RootArg
+        };
+
+        class PointerClassifier
+        {
+            std::unordered_map<Operand*, Instruction*> defs;
+            std::unordered_set<Operand*>               args;
+            std::unordered_map<Operand*, unsigned>     memo;
+            std::unordered_map<Operand*, size_t>       onStack;  // 正在计算的指针 -> 递归深度
+            size_t                                     lowest = SIZE_MAX;  // 遇到的仍在计算中的最浅深度
+
+          public:
+            explicit PointerClassifier(Function& func)
+            {
+                for (auto& arg : func.funcDef->argRegs) args.insert(arg.second);
+                for (auto& [id, block] : func.blocks)
+                    for (auto* inst : block->insts)
+                        if (Operand* def = getDefOperand(*inst)) defs[def] = inst;
+            }
+
+            unsigned classify(Operand* ptr)
+            {
+                if (!ptr) return RootAny;
+                if (ptr->getType() == OperandType::GLOBAL) return RootGlobal;
+                if (ptr->getType() != OperandType::REG) return RootAny;
+                if (args.count(ptr)) return RootArg;
+
+                auto memoIt = memo.find(ptr);
+                if (memoIt != memo.end()) return memoIt->second;
+
+                // phi 成环时回到正在计算的指针不引入新的来源，但依赖它的中间结果尚不完整，
+                // 只有环上最先进入的指针在计算结束后缓存结果，其余的留待之后重新计算 (届时命中环首的缓存)
+                auto stackIt = onStack.find(ptr);
+                if (stackIt != onStack.end())
+                {
+                    lowest = std::min(lowest, stackIt->second);
+                    return 0;
+                }
+                size_t depth = onStack.size();
+                size_t outer = lowest;
+                onStack[ptr] = depth;
+                lowest       = SIZE_MAX;
+
+                unsigned     root = RootAny;
+                auto         it   = defs.find(ptr);
+                Instruction* inst = it == defs.end() ? nullptr : it->second;
+                if (inst && inst->opcode == Operator::ALLOCA)
+                    root = RootLocal;
+                else if (inst && inst->opcode == Operator::GETELEMENTPTR)
+                    root = classify(static_cast<GEPInst*>(inst)->basePtr);
+                else if (inst && inst->opcode == Operator::PHI)
+                {
+                    root = 0;
+                    for (auto& [label, val] : static_cast<PhiInst*>(inst)->incomingVals) root |= classify(val);
+                }
+
+                onStack.erase(ptr);
+                if (lowest >= depth)
+                {
+                    memo[ptr] = root;
+                    lowest    = outer;
+                }
+                else
+                    lowest = std::min(outer, lowest);
+                return root;
+            }
+        };
+
+        void noteAccess(FunctionSummary& summary, unsigned root, bool write)
+        {
+            if (root & RootGlobal) (write ? summary.writesGlobals : summary.readsGlobals) = true;
+            if (root & RootArg) (write ? summary.writesArgMemory : summary.readsArgMemory) = true;
+        }
+
+        bool isPointerType(DataType type) { return type == DataType::PTR || type == DataType::F32_PTR; }
+
+        // 外部函数的摘要: 对指针实参的读写记为形参内存的读写
+        FunctionSummary externalSummary(const std::string& name)
+        {
+            FunctionSummary summary;
+            if (name == "getint" || name == "getch" || name == "getfloat" || name == "putint" || name == "putch" ||
+                name == "putfloat" || name == "_sysy_starttime" || name == "_sysy_stoptime")
+                summary.doesIO = true;
+            else if (name == "getarray" || name == "getfarray")
+            {
+                summary.doesIO          = true;
+                summary.writesArgMemory = true;
+            }
+            else if (name == "putarray" || name == "putfarray")
+            {
+                summary.doesIO         = true;
+                summary.readsArgMemory = true;
+            }
+            else if (name.rfind("llvm.memset", 0) == 0)
+                summary.writesArgMemory = true;
+            else
+            {
+                // 未知的外部函数: 最保守的假设
+                summary.readsGlobals    = true;
+                summary.writesGlobals   = true;
+                summary.readsArgMemory  = true;
+                summary.writesArgMemory = true;
+                summary.doesIO          = true;
+            }
+            return summary;
+        }
+    }  // namespace
+
+    bool FunctionSummary::merge(const FunctionSummary& other)
+    {
+        FunctionSummary before = *this;
+        readsGlobals |= other.readsGlobals;
+        writesGlobals |= other.writesGlobals;
+        readsArgMemory |= other.readsArgMemory;
+        writesArgMemory |= other.writesArgMemory;
+        doesIO |= other.doesIO;
+        return before.readsGlobals != readsGlobals || before.writesGlobals != writesGlobals ||
+               before.readsArgMemory != readsArgMemory || before.writesArgMemory != writesArgMemory ||
+               before.doesIO != doesIO;
+    }
+
+    CallGraph::~CallGraph()
+    {
+        for (auto* node : nodes) delete node;
+    }
+
+    CallGraph::Node* CallGraph::addNode(const std::string& name)
+    {
+        auto it = byName.find(name);
+        if (it != byName.end()) return it->second;
+        auto* node   = new Node();
+        node->name   = name;
+        byName[name] = node;
+        nodes.push_back(node);
+        return node;
+    }
+
+    void CallGraph::build(Module& module)
+    {
+        for (auto* node : nodes) delete node;
+        nodes.clear();
+        byName.clear();
+        byFunc.clear();
+        sccs.clear();
+
+        for (auto* func : module.functions)
+        {
+            Node* node   = addNode(func->funcDef->funcName);
+            node->func   = func;
+            byFunc[func] = node;
+        }
+        for (auto* decl : module.funcDecls) addNode(decl->funcName)->decl = decl;
+
+        for (auto* func : module.functions)
+        {
+            Node* caller = byFunc[func];
+            for (auto& [id, block] : func->blocks)
+            {
+                for (auto* inst : block->insts)
+                {
+                    if (inst->opcode != Operator::CALL) continue;
+                    auto* call = static_cast<CallInst*>(inst);
+                    caller->callSites.push_back(call);
+
+                    Node* callee = addNode(call->funcName);
+                    if (std::find(caller->callees.begin(), caller->callees.end(), callee) != caller->callees.end())
+                        continue;
+                    caller->callees.push_back(callee);
+                    callee->callers.push_back(caller);
+                }
+            }
+        }
+
+        computeSCCs();
+        computeSummaries();
+    }
+
+    void CallGraph::computeSCCs()
+    {
+        // 非递归 Tarjan: 分量在其所有可达分量之后才被弹出，天然是自底向上的顺序
+        std::unordered_map<Node*, size_t> index, lowLink;
+        std::unordered_set<Node*>         onStack;
+        std::vector<Node*>                stack;
+        size_t                            counter = 0;
+
+        std::vector<std::pair<Node*, size_t>> callStack;
+        for (auto* root : nodes)
+        {
+            if (index.count(root)) continue;
+            callStack.push_back({root, 0});
+            index[root] = lowLink[root] = counter++;
+            stack.push_back(root);
+            onStack.insert(root);
+
+            while (!callStack.empty())
+            {
+                auto& [node, next] = callStack.back();
+                if (next < node->callees.size())
+                {
+                    Node* callee = node->callees[next++];
+                    if (!index.count(callee))
+                    {
+                        index[callee] = lowLink[callee] = counter++;
+                        stack.push_back(callee);
+                        onStack.insert(callee);
+                        callStack.push_back({callee, 0});
+                    }
+                    else if (onStack.count(callee))
+                        lowLink[node] = std::min(lowLink[node], index[callee]);
+                    continue;
+                }
+
+                Node* done = node;
+                callStack.pop_back();
+                if (!callStack.empty())
+                    lowLink[callStack.back().first] = std::min(lowLink[callStack.back().first], lowLink[done]);
+                if (lowLink[done] != index[done]) continue;
+
+                std::vector<Node*> component;
+                Node*              member = nullptr;
+                do
+                {
+                    member = stack.back();
+                    stack.pop_back();
+                    onStack.erase(member);
+                    member->scc = sccs.size();
+                    component.push_back(member);
+                } while (member != done);
+                sccs.push_back(std::move(component));
+            }
+        }
+
+        // 分量内按模块中的顺序排列，保证输出稳定
+        std::unordered_map<Node*, size_t> order;
+        for (size_t i = 0; i < nodes.size(); ++i) order[nodes[i]] = i;
+        for (auto& component : sccs)
+            std::sort(component.begin(), component.end(), [&](Node* a, Node* b) { return order[a] < order[b]; });
+    }
+
+    void CallGraph::computeSummaries()
+    {
+        for (auto& component : sccs)
+        {
+            bool recursive = component.size() > 1;
+            for (auto* node : component)
+                if (std::find(node->callees.begin(), node->callees.end(), node) != node->callees.end()) recursive = true;
+
+            // 函数体自身的访存不依赖被调用者，只需计算一次
+            for (auto* node : component)
+            {
+                node->summary.isRecursive = recursive;
+                if (node->isExternal())
+                {
+                    node->summary = externalSummary(node->name);
+                    continue;
+                }
+
+                PointerClassifier classifier(*node->func);
+                for (auto& [id, block] : node->func->blocks)
+                {
+                    for (auto* inst : block->insts)
+                    {
+                        if (inst->opcode == Operator::LOAD)
+                            noteAccess(node->summary, classifier.classify(static_cast<LoadInst*>(inst)->ptr), false);
+                        else if (inst->opcode == Operator::STORE)
+                            noteAccess(node->summary, classifier.classify(static_cast<StoreInst*>(inst)->ptr), true);
+                    }
+                }
+            }
+
+            bool changed = true;
+            while (changed)
+            {
+                changed = false;
+                for (auto* node : component)
+                {
+                    if (node->isExternal()) continue;
+
+                    PointerClassifier classifier(*node->func);
+                    FunctionSummary   summary = node->summary;
+                    for (auto* call : node->callSites)
+                    {
+                        const FunctionSummary& calleeSummary = byName.at(call->funcName)->summary;
+                        summary.readsGlobals |= calleeSummary.readsGlobals;
+                        summary.writesGlobals |= calleeSummary.writesGlobals;
+                        summary.doesIO |= calleeSummary.doesIO;
+                        for (auto& [type, arg] : call->args)
+                        {
+                            if (!isPointerType(type)) continue;
+                            unsigned root = classifier.classify(arg);
+                            if (calleeSummary.readsArgMemory) noteAccess(summary, root, false);
+                            if (calleeSummary.writesArgMemory) noteAccess(summary, root, true);
+                        }
+                    }
+                    changed |= node->summary.merge(summary);
+                }
+            }
+        }
+    }
+
+    CallGraph::Node* CallGraph::getNode(const std::string& name) const
+    {
+        auto it = byName.find(name);
+        return it == byName.end() ? nullptr : it->second;
+    }
+
+    CallGraph::Node* CallGraph::getNode(Function* func) const
+    {
+        auto it = byFunc.find(func);
+        return it == byFunc.end() ? nullptr : it->second;
+    }
+
+    Function* CallGraph::resolve(const CallInst& call) const
+    {
+        Node* node = getNode(call.funcName);
+        return node ? node->func : nullptr;
+    }
+
+    const FunctionSummary& CallGraph::getSummary(const CallInst& call) const
+    {
+        static const FunctionSummary unknown = externalSummary("");
+        Node* node = getNode(call.funcName);
+        return node ? node->summary : unknown;
+    }
+
+    std::vector<Function*> CallGraph::bottomUp() const
+    {
+        std::vector<Function*> order;
+        for (auto& component : sccs)
+            for (auto* node : component)
+                if (node->func) order.push_back(node->func);
+        return order;
+    }
+
+    template <>
+    CallGraph* Manager::get<CallGraph>(Module& module)
+    {
+        if (auto* cached = getCached<CallGraph>(module)) return cached;
+
+        auto* callGraph = new CallGraph();
+        callGraph->build(module);
+        return cache<CallGraph>(module, callGraph);
+    }
+}  // namespace ME::Analysis
@@ -0,0 +1,107 @@
+#ifndef __MIDDLEEND_PASS_ANALYSIS_CALL_GRAPH_H__
+#define __MIDDLEEND_PASS_ANALYSIS_CALL_GRAPH_H__
+
+#include <middleend/pass/analysis/analysis_manager.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * 调用图与函数副作用摘要 (模块级分析)
+ * - 通过 Analysis::AM.get<CallGraph>(module) 获取。每个函数定义与外部声明各对应一个 Node，
+ *   CallInst 中的函数名在构建时一次性解析，之后通过 resolve / getNode 以 O(1) 查询。
+ * - 强连通分量由 Tarjan 算法求出，getSCCs() 按自底向上的顺序给出: 被调用者所在的分量先于调用者，
+ *   分量内按函数在模块中的顺序排列。bottomUp() 为展开后的函数序列，适合内联等自底向上处理的 pass。
+ * - 副作用摘要是传递的 (包含所有被调用者的效果)，按分量自底向上计算，分量内迭代到不动点:
+ *   - 访问的内存按指针的来源分类: 全局变量、指针形参 (调用者传入的数组)、本地 alloca;
+ *     只有前两类对调用者可见。来源无法确定的指针同时视为全局与形参内存。
+ *   - 调用带指针实参的函数时，被调用者对形参内存的读写按实参的来源计入调用者。
+ *   - sylib 的 get* / put* / 计时函数视为 I/O; getarray/getfarray 写入、putarray/putfarray 读取指针实参，
+ *     外部函数对指针实参的读写记在其摘要的 readsArgMemory / writesArgMemory 中。
+ *   - isRecursive 表示函数位于包含环的分量中 (含自身直接递归)。
+ * - 函数 pass 若改变了调用关系或函数的访存行为，不应在 PreservedAnalyses 中保留 CallGraph。
+ */
+
+namespace ME
+{
+    class Module;
+    class Function;
+    class CallInst;
+    class FuncDeclInst;
+}  // namespace ME
+
+namespace ME::Analysis
+{
+    struct FunctionSummary
+    {
+        bool readsGlobals    = false;
+        bool writesGlobals   = false;
+        bool readsArgMemory  = false;
+        bool writesArgMemory = false;
+        bool doesIO          = false;
+        bool isRecursive     = false;
+
+        // 不写任何调用者可见的内存且不做 I/O，删除结果未被使用的调用是安全的 (不考虑是否终止)
+        bool hasSideEffects() const { return writesGlobals || writesArgMemory || doesIO; }
+        // 结果只取决于标量实参: 可以按实参做记忆化或公共子表达式消除
+        bool isPure() const { return !hasSideEffects() && !readsGlobals && !readsArgMemory; }
+
+        bool merge(const FunctionSummary& other);
+    };
+
+    class CallGraph
+    {
+      public:
+        static inline const size_t TID = getTID<CallGraph>();
+
+        struct Node
+        {
+            std::string            name;
+            Function*              func = nullptr;  // 定义在模块内的函数
+            FuncDeclInst*          decl = nullptr;  // 外部声明 (sylib 等)
+            std::vector<Node*>     callees;         // 去重，按首次调用的顺序
+            std::vector<Node*>     callers;         // 去重，按模块中的顺序
+            std::vector<CallInst*> callSites;       // 本函数中的全部调用
+            size_t                 scc = 0;         // 所在分量在 getSCCs() 中的下标
+            FunctionSummary        summary;
+
+            bool isExternal() const { return func == nullptr; }
+        };
+
+      private:
+        std::vector<Node*>                     nodes;
+        std::unordered_map<std::string, Node*> byName;
+        std::unordered_map<Function*, Node*>   byFunc;
+        std::vector<std::vector<Node*>>        sccs;
+
+      public:
+        CallGraph() = default;
+        ~CallGraph();
+        CallGraph(const CallGraph&)            = delete;
+        CallGraph& operator=(const CallGraph&) = delete;
+
+        void build(Module& module);
+
+        const std::vector<Node*>& getNodes() const { return nodes; }
+        Node*                     getNode(const std::string& name) const;
+        Node*                     getNode(Function* func) const;
+        Function*                 resolve(const CallInst& call) const;
+
+        const std::vector<std::vector<Node*>>& getSCCs() const { return sccs; }
+        std::vector<Function*>                 bottomUp() const;
+
+        const FunctionSummary& getSummary(Function* func) const { return getNode(func)->summary; }
+        const FunctionSummary& getSummary(const CallInst& call) const;
+        bool                   isRecursive(Function* func) const { return getSummary(func).isRecursive; }
+
+      private:
+        Node* addNode(const std::string& name);
+        void  computeSCCs();
+        void  computeSummaries();
+    };
+
+    template <>
+    CallGraph* Manager::get<CallGraph>(Module& module);
+}  // namespace ME::Analysis
+
+#endif  // __MIDDLEEND_PASS_ANALYSIS_CALL_GRAPH_H__
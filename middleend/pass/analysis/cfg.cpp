@@ -4,138 +4,347 @@
 #include <middleend/module/ir_block.h>
 #include <middleend/module/ir_instruction.h>
 #include <middleend/module/ir_operand.h>
+#include <middleend/module/ir_utils.h>
 #include <algorithm>
 
 namespace ME::Analysis
 {
-    CFG::CFG() { id2block.clear(); }
+    CFG::CFG() : func(nullptr), entry(0) {}
 
-    void CFG::build(ME::Function& function)
+    Instruction* CFG::getTerminator(Block* block)
     {
-        func = &function;
-        id2block.clear();
+        for (auto* inst : block->insts)
+            if (inst->isTerminator()) return inst;
+        return nullptr;
+    }
 
-        for (auto& [blockId, block] : function.blocks) id2block[blockId] = block;
+    std::vector<size_t> CFG::getSuccessorIds(Block* block)
+    {
+        std::vector<size_t> succs;
+        Instruction*        terminator = getTerminator(block);
+        if (!terminator) return succs;
 
-        if (id2block.empty()) return;
+        auto addLabel = [&](Operand* op) {
+            if (!op || op->getType() != OperandType::LABEL) return;
+            size_t id = labelOf(op);
+            if (std::find(succs.begin(), succs.end(), id) == succs.end()) succs.push_back(id);
+        };
 
-        size_t maxBlockId = 0;
-        for (auto& [blockId, block] : id2block) maxBlockId = std::max(maxBlockId, blockId);
+        if (terminator->opcode == Operator::BR_COND)
+        {
+            auto* brInst = static_cast<BrCondInst*>(terminator);
+            addLabel(brInst->trueTar);
+            addLabel(brInst->falseTar);
+        }
+        else if (terminator->opcode == Operator::BR_UNCOND)
+            addLabel(static_cast<BrUncondInst*>(terminator)->target);
+
+        return succs;
+    }
 
-        G.clear();
-        invG.clear();
+    void CFG::build(ME::Function& function)
+    {
+        func = &function;
+        id2block.clear();
         G_id.clear();
         invG_id.clear();
+        postOrder.clear();
+        rpo.clear();
+        rpoIndex.clear();
+        orderValid = true;
+
+        if (function.blocks.empty()) return;
+
+        size_t n = function.blocks.rbegin()->first + 1;
+        entry    = function.blocks.begin()->first;
+        id2block.assign(n, nullptr);
+        G_id.assign(n, {});
+        invG_id.assign(n, {});
+        for (auto& [blockId, block] : function.blocks) id2block[blockId] = block;
 
-        G.resize(maxBlockId + 1);
-        invG.resize(maxBlockId + 1);
-        G_id.resize(maxBlockId + 1);
-        invG_id.resize(maxBlockId + 1);
-
-        std::map<size_t, bool> visited;
-        buildFromBlock(0, visited);
-
-        auto blocks_temp = func->blocks;
-        func->blocks.clear();
+        auto successorsOf = [&](size_t id) {
+            auto succs = getSuccessorIds(id2block[id]);
+            succs.erase(std::remove_if(succs.begin(),
+                            succs.end(),
+                            [&](size_t target) { return target >= n || id2block[target] == nullptr; }),
+                succs.end());
+            return succs;
+        };
+
+        // 显式栈 DFS: (块编号, 下一个待访问的后继下标)，出栈顺序即为后序
+        std::vector<char>                       visited(n, 0);
+        std::vector<std::pair<size_t, size_t>> stack;
+        visited[entry] = 1;
+        G_id[entry]    = successorsOf(entry);
+        stack.push_back({entry, 0});
+        while (!stack.empty())
+        {
+            size_t id = stack.back().first;
+            if (stack.back().second < G_id[id].size())
+            {
+                size_t succ = G_id[id][stack.back().second++];
+                invG_id[succ].push_back(id);
+                if (visited[succ]) continue;
+
+                visited[succ] = 1;
+                G_id[succ]    = successorsOf(succ);
+                stack.push_back({succ, 0});
+                continue;
+            }
+            postOrder.push_back(id);
+            stack.pop_back();
+        }
 
-        for (auto& [blockId, block] : blocks_temp)
-            if (visited[blockId]) func->blocks[blockId] = block;
+        if (eraseUnvisited(function, visited))
+            for (size_t id = 0; id < n; ++id)
+                if (!visited[id]) id2block[id] = nullptr;
 
-        id2block.clear();
-        for (auto& [blockId, block] : func->blocks) id2block[blockId] = block;
+        rpo.assign(postOrder.rbegin(), postOrder.rend());
+        rpoIndex.assign(n, npos);
+        for (size_t i = 0; i < rpo.size(); ++i) rpoIndex[rpo[i]] = i;
+    }
 
-        for (size_t i = 0; i <= maxBlockId; ++i)
+    bool CFG::removeUnreachableBlocks(ME::Function& function)
+    {
+        if (function.blocks.empty()) return false;
+
+        size_t              n     = function.blocks.rbegin()->first + 1;
+        size_t              start = function.blocks.begin()->first;
+        std::vector<char>   visited(n, 0);
+        std::vector<size_t> stack = {start};
+        visited[start]            = 1;
+        while (!stack.empty())
         {
-            if (!visited[i]) continue;
-
-            auto& edges = G_id[i];
-            edges.erase(
-                std::remove_if(edges.begin(), edges.end(), [&](size_t target_id) { return !visited[target_id]; }),
-                edges.end());
+            size_t id = stack.back();
+            stack.pop_back();
+            for (size_t succ : getSuccessorIds(function.blocks.at(id)))
+            {
+                if (succ >= n || visited[succ] || !function.blocks.count(succ)) continue;
+                visited[succ] = 1;
+                stack.push_back(succ);
+            }
         }
+        return eraseUnvisited(function, visited);
+    }
 
-        for (size_t i = 0; i <= maxBlockId; ++i)
+    bool CFG::eraseUnvisited(ME::Function& function, const std::vector<char>& visited)
+    {
+        // 删除不可达块，并清理可达块中 phi 指向这些块的来源
+        bool removed = false;
+        for (auto it = function.blocks.begin(); it != function.blocks.end();)
         {
-            if (!visited[i]) continue;
+            if (visited[it->first])
+            {
+                ++it;
+                continue;
+            }
+            delete it->second;
+            it      = function.blocks.erase(it);
+            removed = true;
+        }
+        if (!removed) return false;
 
-            auto& edges = invG_id[i];
-            edges.erase(
-                std::remove_if(edges.begin(), edges.end(), [&](size_t source_id) { return !visited[source_id]; }),
-                edges.end());
+        for (auto& [blockId, block] : function.blocks)
+        {
+            for (auto* inst : block->insts)
+            {
+                if (inst->opcode != Operator::PHI) continue;
+                auto& incoming = static_cast<PhiInst*>(inst)->incomingVals;
+                for (auto it = incoming.begin(); it != incoming.end();)
+                {
+                    size_t label = labelOf(it->first);
+                    if (label < visited.size() && !visited[label])
+                        it = incoming.erase(it);
+                    else
+                        ++it;
+                }
+            }
         }
+        return true;
     }
 
-    void CFG::buildFromBlock(size_t blockId, std::map<size_t, bool>& visited)
+    void CFG::computeOrder()
     {
-        if (visited[blockId] || id2block.find(blockId) == id2block.end()) return;
+        size_t n = id2block.size();
+        postOrder.clear();
+        rpo.clear();
+        rpoIndex.assign(n, npos);
+        orderValid = true;
+        if (!contains(entry)) return;
+
+        std::vector<char>                       visited(n, 0);
+        std::vector<std::pair<size_t, size_t>> stack;
+        visited[entry] = 1;
+        stack.push_back({entry, 0});
+        while (!stack.empty())
+        {
+            size_t id = stack.back().first;
+            if (stack.back().second < G_id[id].size())
+            {
+                size_t succ = G_id[id][stack.back().second++];
+                if (visited[succ]) continue;
+                visited[succ] = 1;
+                stack.push_back({succ, 0});
+                continue;
+            }
+            postOrder.push_back(id);
+            stack.pop_back();
+        }
 
-        visited[blockId]        = true;
-        ME::Block* currentBlock = id2block[blockId];
+        rpo.assign(postOrder.rbegin(), postOrder.rend());
+        for (size_t i = 0; i < rpo.size(); ++i) rpoIndex[rpo[i]] = i;
+    }
 
-        Instruction* terminator = nullptr;
-        for (auto inst : currentBlock->insts)
-        {
-            if (!inst->isTerminator()) continue;
+    const std::vector<size_t>& CFG::getRPO()
+    {
+        if (!orderValid) computeOrder();
+        return rpo;
+    }
 
-            terminator = inst;
-            break;
-        }
+    const std::vector<size_t>& CFG::getPostOrder()
+    {
+        if (!orderValid) computeOrder();
+        return postOrder;
+    }
 
-        if (!terminator) return;
+    size_t CFG::getRPOIndex(size_t id)
+    {
+        if (!orderValid) computeOrder();
+        return id < rpoIndex.size() ? rpoIndex[id] : npos;
+    }
 
-        if (terminator->opcode == Operator::BR_COND)
-        {
-            BrCondInst* brInst = static_cast<BrCondInst*>(terminator);
+    void CFG::grow(size_t id)
+    {
+        if (id < id2block.size()) return;
+        id2block.resize(id + 1, nullptr);
+        G_id.resize(id + 1);
+        invG_id.resize(id + 1);
+    }
 
-            if (brInst->trueTar->getType() == OperandType::LABEL && brInst->falseTar->getType() == OperandType::LABEL)
-            {
-                LabelOperand* trueLabel  = static_cast<LabelOperand*>(brInst->trueTar);
-                LabelOperand* falseLabel = static_cast<LabelOperand*>(brInst->falseTar);
+    void CFG::addBlock(ME::Block* block)
+    {
+        grow(block->blockId);
+        id2block[block->blockId] = block;
+        orderValid               = false;
+    }
 
-                size_t trueLabelId  = trueLabel->lnum;
-                size_t falseLabelId = falseLabel->lnum;
+    void CFG::addEdge(size_t from, size_t to)
+    {
+        grow(std::max(from, to));
+        auto& succs = G_id[from];
+        if (std::find(succs.begin(), succs.end(), to) != succs.end()) return;
+        succs.push_back(to);
+        invG_id[to].push_back(from);
+        orderValid = false;
+    }
 
-                if (id2block.find(trueLabelId) != id2block.end())
-                {
-                    G[blockId].push_back(id2block[trueLabelId]);
-                    G_id[blockId].push_back(trueLabelId);
-                    invG[trueLabelId].push_back(currentBlock);
-                    invG_id[trueLabelId].push_back(blockId);
+    void CFG::removeEdge(size_t from, size_t to)
+    {
+        if (std::max(from, to) >= id2block.size()) return;
+        auto& succs = G_id[from];
+        auto  it    = std::find(succs.begin(), succs.end(), to);
+        if (it == succs.end()) return;
+        succs.erase(it);
+
+        auto& preds = invG_id[to];
+        preds.erase(std::find(preds.begin(), preds.end(), from));
+        orderValid = false;
+    }
 
-                    buildFromBlock(trueLabelId, visited);
-                }
+    size_t CFG::splitEdge(size_t from, size_t to)
+    {
+        Block* fromBlock = getBlock(from);
+        Block* toBlock   = getBlock(to);
+        ASSERT(fromBlock && toBlock && "splitEdge on a block outside of the CFG");
 
-                if (id2block.find(falseLabelId) != id2block.end())
-                {
-                    G[blockId].push_back(id2block[falseLabelId]);
-                    G_id[blockId].push_back(falseLabelId);
-                    invG[falseLabelId].push_back(currentBlock);
-                    invG_id[falseLabelId].push_back(blockId);
+        Block* mid = func->createBlock();
+        mid->insertBack(new BrUncondInst(getLabelOperand(to)));
 
-                    buildFromBlock(falseLabelId, visited);
-                }
-            }
+        Operand* toLabel  = getLabelOperand(to);
+        Operand* midLabel = getLabelOperand(mid->blockId);
+
+        Instruction* terminator = getTerminator(fromBlock);
+        if (terminator && terminator->opcode == Operator::BR_COND)
+        {
+            auto* brInst = static_cast<BrCondInst*>(terminator);
+            if (brInst->trueTar == toLabel) brInst->trueTar = midLabel;
+            if (brInst->falseTar == toLabel) brInst->falseTar = midLabel;
         }
-        else if (terminator->opcode == Operator::BR_UNCOND)
+        else if (terminator && terminator->opcode == Operator::BR_UNCOND)
         {
-            BrUncondInst* brInst = static_cast<BrUncondInst*>(terminator);
+            auto* brInst = static_cast<BrUncondInst*>(terminator);
+            if (brInst->target == toLabel) brInst->target = midLabel;
+        }
 
-            if (brInst->target->getType() == OperandType::LABEL)
-            {
-                LabelOperand* targetLabel   = static_cast<LabelOperand*>(brInst->target);
-                size_t        targetLabelId = targetLabel->lnum;
+        Operand* fromLabel = getLabelOperand(from);
+        for (auto* inst : toBlock->insts)
+        {
+            if (inst->opcode != Operator::PHI) continue;
+            auto& incoming = static_cast<PhiInst*>(inst)->incomingVals;
+            auto  it       = incoming.find(fromLabel);
+            if (it == incoming.end()) continue;
+            Operand* val = it->second;
+            incoming.erase(it);
+            incoming[midLabel] = val;
+        }
 
-                if (id2block.find(targetLabelId) != id2block.end())
-                {
-                    G[blockId].push_back(id2block[targetLabelId]);
-                    G_id[blockId].push_back(targetLabelId);
-                    invG[targetLabelId].push_back(currentBlock);
-                    invG_id[targetLabelId].push_back(blockId);
+        addBlock(mid);
+        std::replace(G_id[from].begin(), G_id[from].end(), to, mid->blockId);
+        std::replace(invG_id[to].begin(), invG_id[to].end(), from, mid->blockId);
+        G_id[mid->blockId]    = {to};
+        invG_id[mid->blockId] = {from};
+        orderValid            = false;
 
-                    buildFromBlock(targetLabelId, visited);
-                }
-            }
+        return mid->blockId;
+    }
+
+    void CFG::removeForwardingBlock(size_t mid)
+    {
+        Block* midBlock = getBlock(mid);
+        ASSERT(midBlock && midBlock->insts.size() == 1 && preds(mid).size() == 1 && succs(mid).size() == 1 &&
+               "removeForwardingBlock on a block that is not a plain forwarding block");
+        size_t from = preds(mid)[0];
+        size_t to   = succs(mid)[0];
+        ASSERT(std::find(G_id[from].begin(), G_id[from].end(), to) == G_id[from].end() &&
+               "removeForwardingBlock would duplicate an existing edge");
+
+        Operand* toLabel  = getLabelOperand(to);
+        Operand* midLabel = getLabelOperand(mid);
+
+        Instruction* terminator = getTerminator(getBlock(from));
+        if (terminator && terminator->opcode == Operator::BR_COND)
+        {
+            auto* brInst = static_cast<BrCondInst*>(terminator);
+            if (brInst->trueTar == midLabel) brInst->trueTar = toLabel;
+            if (brInst->falseTar == midLabel) brInst->falseTar = toLabel;
         }
+        else if (terminator && terminator->opcode == Operator::BR_UNCOND)
+        {
+            auto* brInst = static_cast<BrUncondInst*>(terminator);
+            if (brInst->target == midLabel) brInst->target = toLabel;
+        }
+
+        Operand* fromLabel = getLabelOperand(from);
+        for (auto* inst : getBlock(to)->insts)
+        {
+            if (inst->opcode != Operator::PHI) continue;
+            auto& incoming = static_cast<PhiInst*>(inst)->incomingVals;
+            auto  it       = incoming.find(midLabel);
+            if (it == incoming.end()) continue;
+            Operand* val = it->second;
+            incoming.erase(it);
+            incoming[fromLabel] = val;
+        }
+
+        // 原地替换，使邻接表的顺序与拆分前一致
+        std::replace(G_id[from].begin(), G_id[from].end(), mid, to);
+        std::replace(invG_id[to].begin(), invG_id[to].end(), mid, from);
+        G_id[mid].clear();
+        invG_id[mid].clear();
+        id2block[mid] = nullptr;
+        func->blocks.erase(mid);
+        delete midBlock;
+        orderValid = false;
     }
 
     template <>
@@ -145,7 +354,6 @@ namespace ME::Analysis
 
         auto* cfg = new CFG();
         cfg->build(func);
-        cache<CFG>(func, cfg);
-        return cfg;
+        return cache<CFG>(func, cfg);
     }
 }  // namespace ME::Analysis
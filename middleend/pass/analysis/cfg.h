@@ -3,20 +3,25 @@
 
 #include <middleend/pass/analysis/analysis_manager.h>
 #include <middleend/module/ir_function.h>
-#include <map>
 #include <vector>
 
 /*
  * CFG (控制流图) 分析
  * - 通过 Analysis::AM.get<CFG>(function) 构建并缓存函数的基本块图。
- * - 提供 blockId->Block 的映射，以及正向/反向图与其 id 版本，便于后续分析使用。
- * - 必要时需调用 AM.invalidate(function) 来清理修改了结构的函数的 CFG 缓存。
+ * - 所有数据均以块编号 (blockId) 为下标存放在稠密数组中: id2block 为 blockId->Block 的映射，
+ *   G_id/invG_id 为正向/反向邻接表。不可达或已删除的编号在 id2block 中为 nullptr。
+ * - 构建时使用显式栈进行 DFS，同时得到后序，getRPO()/getPostOrder() 返回缓存的 (逆) 后序。
+ * - 只改动少量边的 pass 可以在修改跳转指令后调用 addEdge/removeEdge，或直接使用 splitEdge，
+ *   就地更新 CFG 并在返回的 PreservedAnalyses 中保留 CFG，避免整张图被重建。
+ * - 修改了函数结构却没有同步更新 CFG 的 pass 不应在返回的 PreservedAnalyses 中保留 CFG，
+ *   调用者据此清理该函数的 CFG 及依赖它的分析 (如 DomInfo)。
  */
 
 namespace ME
 {
     class Function;
     class Block;
+    class Instruction;
 }  // namespace ME
 
 namespace ME::Analysis
@@ -26,21 +31,64 @@ namespace ME::Analysis
       public:
         static inline const size_t TID = getTID<CFG>();
 
-        ME::Function*                func;
-        std::map<size_t, ME::Block*> id2block;
-
-        std::vector<std::vector<ME::Block*>> G{};
-        std::vector<std::vector<ME::Block*>> invG{};
+        ME::Function*           func;
+        size_t                  entry;
+        std::vector<ME::Block*> id2block;
 
         std::vector<std::vector<size_t>> G_id{};
         std::vector<std::vector<size_t>> invG_id{};
 
+      private:
+        std::vector<size_t> postOrder;
+        std::vector<size_t> rpo;
+        std::vector<size_t> rpoIndex;
+        bool                orderValid = false;
+
       public:
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
         CFG();
         ~CFG() = default;
 
         void build(ME::Function& function);
-        void buildFromBlock(size_t blockId, std::map<size_t, bool>& visited);
+
+        // 块编号的上界 (所有下标均小于该值)
+        size_t     size() const { return id2block.size(); }
+        ME::Block* getBlock(size_t id) const { return id < id2block.size() ? id2block[id] : nullptr; }
+        bool       contains(size_t id) const { return getBlock(id) != nullptr; }
+
+        const std::vector<size_t>& succs(size_t id) const { return G_id[id]; }
+        const std::vector<size_t>& preds(size_t id) const { return invG_id[id]; }
+
+        const std::vector<size_t>& getRPO();
+        const std::vector<size_t>& getPostOrder();
+        // 块在逆后序中的位置，不可达的块返回 npos
+        size_t getRPOIndex(size_t id);
+
+        // 只更新图本身，跳转指令需由调用者修改
+        void addBlock(ME::Block* block);
+        void addEdge(size_t from, size_t to);
+        void removeEdge(size_t from, size_t to);
+
+        // 在 from->to 之间插入一个新块: 同时修改 from 的跳转指令与 to 中 phi 的来源标签
+        // 返回新块的编号
+        size_t splitEdge(size_t from, size_t to);
+        // splitEdge 的逆操作: mid 只有一个前驱、只含跳到唯一后继的无条件跳转时，把前驱的跳转与后继中 phi 的来源
+        // 改回直接相连，并从函数中删除 mid
+        void removeForwardingBlock(size_t mid);
+
+        static ME::Instruction*    getTerminator(ME::Block* block);
+        static std::vector<size_t> getSuccessorIds(ME::Block* block);
+
+        // 删除从入口不可达的块及可达块中 phi 指向它们的来源 (build 也会这样做)，返回是否删除了块
+        // 供改写了跳转却不需要新 CFG 的 pass 在返回前清理函数
+        static bool removeUnreachableBlocks(ME::Function& function);
+
+      private:
+        static bool eraseUnvisited(ME::Function& function, const std::vector<char>& visited);
+
+        void computeOrder();
+        void grow(size_t id);
     };
 
     template <>
@@ -0,0 +1,45 @@
+#include <middleend/pass/analysis/control_dependence.h>
+#include <middleend/pass/analysis/postdominfo.h>
+#include <middleend/pass/analysis/cfg.h>
+#include <algorithm>
+
+namespace ME::Analysis
+{
+    void ControlDependence::build(CFG& cfg, PostDomInfo& postDomInfo)
+    {
+        const auto& frontier = postDomInfo.getPostDomFrontier();
+        controllers.assign(cfg.size(), {});
+        dependents.assign(cfg.size(), {});
+
+        // 按块编号递增处理 b，dependents 中的列表自然有序
+        for (size_t block = 0; block < frontier.size(); ++block)
+        {
+            for (int controller : frontier[block])
+            {
+                controllers[block].push_back(controller);
+                dependents[controller].push_back(block);
+            }
+        }
+    }
+
+    bool ControlDependence::isControlDependent(size_t block, size_t on) const
+    {
+        auto& list = controllers[block];
+        return std::binary_search(list.begin(), list.end(), on);
+    }
+
+    template <>
+    ControlDependence* Manager::get<ControlDependence>(Function& func)
+    {
+        if (auto* cached = getCached<ControlDependence>(func)) return cached;
+
+        registerDependency<ControlDependence, CFG>();
+        registerDependency<ControlDependence, PostDomInfo>();
+        auto* cfg         = get<CFG>(func);
+        auto* postDomInfo = get<PostDomInfo>(func);
+
+        auto* controlDependence = new ControlDependence();
+        controlDependence->build(*cfg, *postDomInfo);
+        return cache<ControlDependence>(func, controlDependence);
+    }
+}  // namespace ME::Analysis
@@ -0,0 +1,43 @@
+#ifndef __MIDDLEEND_PASS_ANALYSIS_CONTROL_DEPENDENCE_H__
+#define __MIDDLEEND_PASS_ANALYSIS_CONTROL_DEPENDENCE_H__
+
+#include <middleend/pass/analysis/analysis_manager.h>
+#include <vector>
+
+/*
+ * 控制依赖图
+ * - 通过 Analysis::AM.get<ControlDependence>(function) 获取，依赖 CFG 与 PostDomInfo。
+ * - 块 b 控制依赖于块 a，当且仅当 a 的跳转决定了 b 是否执行: a 有一个后继被 b 后支配，而 b 不严格后支配 a。
+ *   这正是后支配边界: getControllingBlocks(b) = PDF(b)，getDependentBlocks(a) 为其反向关系。
+ * - 死循环经由 PostDomInfo 的虚拟出口处理，因此 "进入死循环" 与 "正常返回" 两个分支同样产生控制依赖，
+ *   激进死代码消除可以据此判断整个循环是否有用。
+ * - 两个方向的列表都按块编号升序排列; 没有控制依赖的块 (如入口) 只要函数被调用就会执行。
+ */
+
+namespace ME::Analysis
+{
+    class PostDomInfo;
+    class CFG;
+
+    class ControlDependence
+    {
+      public:
+        static inline const size_t TID = getTID<ControlDependence>();
+
+      private:
+        std::vector<std::vector<size_t>> controllers;  // controllers[b]: b 控制依赖的块
+        std::vector<std::vector<size_t>> dependents;   // dependents[a]: 控制依赖于 a 的块
+
+      public:
+        void build(CFG& cfg, PostDomInfo& postDomInfo);
+
+        const std::vector<size_t>& getControllingBlocks(size_t block) const { return controllers[block]; }
+        const std::vector<size_t>& getDependentBlocks(size_t block) const { return dependents[block]; }
+        bool                       isControlDependent(size_t block, size_t on) const;
+    };
+
+    template <>
+    ControlDependence* Manager::get<ControlDependence>(Function& func);
+}  // namespace ME::Analysis
+
+#endif  // __MIDDLEEND_PASS_ANALYSIS_CONTROL_DEPENDENCE_H__
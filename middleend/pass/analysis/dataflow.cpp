@@ -0,0 +1,18 @@
+#include <middleend/pass/analysis/dataflow.h>
+
+namespace ME::Analysis
+{
+    namespace
+    {
+        DataflowHook& hookStorage()
+        {
+            static DataflowHook hook;
+            return hook;
+        }
+    }  // namespace
+
+    // 钩子应在运行 pass 之前设置，求解过程中只读
+    void setDataflowHook(DataflowHook hook) { hookStorage() = std::move(hook); }
+
+    const DataflowHook& getDataflowHook() { return hookStorage(); }
+}  // namespace ME::Analysis
@@ -0,0 +1,179 @@
+#ifndef __MIDDLEEND_PASS_ANALYSIS_DATAFLOW_H__
+#define __MIDDLEEND_PASS_ANALYSIS_DATAFLOW_H__
+
+#include <middleend/pass/analysis/cfg.h>
+#include <dynamic_bitset.h>
+#include <functional>
+#include <vector>
+
+/*
+ * 通用的数据流求解框架
+ *
+ * 一个数据流问题 (Problem) 需要提供:
+ *   using Domain = ...;                                  // 格上的值，需支持拷贝与 ==
+ *   static constexpr Direction direction;                // Forward / Backward
+ *   const char* name() const;                            // 用于统计钩子
+ *   Domain boundary() const;                             // 流入入口 (前向) / 流出出口 (后向) 的值
+ *   Domain top() const;                                  // 其余块的初值，同时是交汇运算的单位元
+ *   void   meet(Domain& acc, const Domain& value, size_t from, size_t to) const;
+ *                                                        // 把边 from->to 上传来的 value 并入 acc
+ *   bool   transfer(size_t block, const Domain& input, Domain& output) const;
+ *                                                        // 由块的流入值计算流出值，返回流出值是否改变
+ * 结果中的 in/out 始终按程序顺序给出 (in 为块首，out 为块尾)，与分析方向无关。
+ *
+ * 求解采用按遍历序排列的工作表: 前向问题按逆后序、后向问题按后序编号，
+ * 每一轮 (sweep) 按编号从小到大处理所有待处理的块，处理过程中被标记的后继若编号更大则在同一轮内处理，
+ * 只有沿回边传播的变化才会留到下一轮。对可归约的控制流图，轮数不超过回边嵌套深度 + 2，
+ * 与经典的逆后序迭代算法所需的最少轮数一致，同时跳过了值没有变化的块。
+ *
+ * BitVectorProblem 为基于 Cele::dynamic_bitset 的 gen/kill 问题提供了默认实现:
+ * 传递函数为 out = gen | (in & ~kill)，交汇为并 (Union) 或交 (Intersection)。
+ *
+ * 统计: 每次求解的轮数、块处理次数与流出值改变次数记录在结果的 stats 中，
+ * 并在设置了 setDataflowHook 时通过钩子上报 (钩子可能在多个工作线程中被并发调用)。
+ */
+
+namespace ME::Analysis
+{
+    enum class Direction
+    {
+        Forward,
+        Backward
+    };
+
+    struct DataflowStats
+    {
+        size_t sweeps      = 0;
+        size_t blockVisits = 0;
+        size_t changes     = 0;
+    };
+
+    using DataflowHook = std::function<void(const char* problem, const Function& func, const DataflowStats& stats)>;
+
+    void                setDataflowHook(DataflowHook hook);
+    const DataflowHook& getDataflowHook();
+
+    template <typename Domain>
+    struct DataflowResult
+    {
+        std::vector<Domain> in;   // 以块编号为下标
+        std::vector<Domain> out;  // 以块编号为下标
+        DataflowStats       stats;
+    };
+
+    template <typename Problem>
+    class DataflowSolver
+    {
+      public:
+        using Domain = typename Problem::Domain;
+
+        static DataflowResult<Domain> solve(CFG& cfg, const Problem& problem)
+        {
+            constexpr bool forward = Problem::direction == Direction::Forward;
+
+            DataflowResult<Domain> result;
+            size_t                 n = cfg.size();
+            result.in.assign(n, problem.top());
+            result.out.assign(n, problem.top());
+
+            const std::vector<size_t>& order = forward ? cfg.getRPO() : cfg.getPostOrder();
+            std::vector<size_t>        position(n, CFG::npos);
+            for (size_t i = 0; i < order.size(); ++i) position[order[i]] = i;
+
+            // 前向: 流入值为 in，流出值为 out; 后向反之
+            std::vector<Domain>& input  = forward ? result.in : result.out;
+            std::vector<Domain>& output = forward ? result.out : result.in;
+
+            Cele::dynamic_bitset pending(order.size());
+            pending.set();
+
+            Domain acc = problem.top();
+            while (pending.any())
+            {
+                ++result.stats.sweeps;
+                for (size_t pos = pending.find_first(); pos != Cele::dynamic_bitset::npos; pos = pending.find_next(pos))
+                {
+                    pending.reset(pos);
+                    size_t block = order[pos];
+                    ++result.stats.blockVisits;
+
+                    // 前向问题中入口的流入值为 boundary，后向问题中没有后继的块的流出值为 boundary
+                    acc                              = problem.top();
+                    bool                       atEdge = forward ? block == cfg.entry : cfg.succs(block).empty();
+                    const std::vector<size_t>& from   = forward ? cfg.preds(block) : cfg.succs(block);
+                    if (atEdge) acc = problem.boundary();
+                    for (size_t other : from)
+                    {
+                        if (position[other] == CFG::npos) continue;
+                        if (forward)
+                            problem.meet(acc, output[other], other, block);
+                        else
+                            problem.meet(acc, output[other], block, other);
+                    }
+                    input[block] = acc;
+
+                    if (!problem.transfer(block, input[block], output[block])) continue;
+                    ++result.stats.changes;
+
+                    const std::vector<size_t>& to = forward ? cfg.succs(block) : cfg.preds(block);
+                    for (size_t next : to)
+                        if (position[next] != CFG::npos) pending.set(position[next]);
+                }
+            }
+
+            auto& hook = getDataflowHook();
+            if (hook && cfg.func) hook(problem.name(), *cfg.func, result.stats);
+            return result;
+        }
+    };
+
+    enum class MeetOp
+    {
+        Union,
+        Intersection
+    };
+
+    template <Direction Dir, MeetOp Meet>
+    struct BitVectorProblem
+    {
+        using Domain                         = Cele::dynamic_bitset;
+        static constexpr Direction direction = Dir;
+
+        size_t              universe = 0;
+        std::vector<Domain> gen;   // 以块编号为下标
+        std::vector<Domain> kill;  // 以块编号为下标
+        Domain              boundaryValue;
+
+        void init(size_t blockCount, size_t universeSize)
+        {
+            universe = universeSize;
+            gen.assign(blockCount, Domain(universeSize));
+            kill.assign(blockCount, Domain(universeSize));
+            boundaryValue = Domain(universeSize);
+        }
+
+        Domain boundary() const { return boundaryValue; }
+
+        Domain top() const
+        {
+            Domain value(universe);
+            if (Meet == MeetOp::Intersection) value.set();
+            return value;
+        }
+
+        void meet(Domain& acc, const Domain& value, size_t, size_t) const
+        {
+            if (Meet == MeetOp::Union)
+                acc |= value;
+            else
+                acc &= value;
+        }
+
+        bool transfer(size_t block, const Domain& input, Domain& output) const
+        {
+            return output.assign_or_and_not(gen[block], input, kill[block]);
+        }
+    };
+}  // namespace ME::Analysis
+
+#endif  // __MIDDLEEND_PASS_ANALYSIS_DATAFLOW_H__
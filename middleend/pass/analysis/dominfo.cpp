@@ -2,28 +2,144 @@
 #include <middleend/pass/analysis/analysis_manager.h>
 #include <middleend/pass/analysis/cfg.h>
 #include <dom_analyzer.h>
+#include <debug.h>
+#include <algorithm>
+#include <map>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+
+/*
+ * 支配树的增量更新
+ *
+ * 一批更新按顺序逐条处理。CFG 已经包含了整批改动，因此处理第 k 条更新时，
+ * 通过 GraphView 把第 k 条之后尚未处理的更新从 CFG 上 "撤销"，得到当时应当看到的图:
+ * 尚未处理的插入边被隐藏，尚未处理的删除边被补回。
+ *
+ * 插入 from->to (两端均可达):
+ *   令 nca 为 from 与 to 在支配树上的最近公共祖先。若 depth(nca) + 1 >= depth(to)，支配关系不变。
+ *   否则从 to 出发，按深度从大到小处理桶中的结点，沿 CFG 后继扩展:
+ *   深度不超过 depth(nca) + 1 的后继不受影响; 深度大于当前层的后继只作为中转继续搜索;
+ *   其余后继放入桶中。所有从桶中取出的结点的 idom 均改为 nca。
+ * 插入 from->to (to 原本不可达):
+ *   从 to 出发收集新变为可达的结点，以 to 为根运行 SemiNCA 并挂到 from 之下;
+ *   再把这些结点通向原可达结点的边作为可达插入逐条处理。
+ * 删除 from->to:
+ *   若存在只连接 from 与 to 的中间块 mid (拆分边的典型情形)，其余结点的支配关系不变，
+ *   至多 to 的 idom 变为 mid，无需搜索。
+ *   若 to 支配 from，或 to 的 idom 不是 from / to 还有不被自己支配的前驱 (proper support)，
+ *   to 仍可达，只需以 nca(from, to) 为根、在其子树上重新运行 SemiNCA;
+ *   否则 to 的整棵子树变为不可达，将其删除，并在受影响的最小子树上重新运行 SemiNCA。
+ *   需要重算的子树根为入口时直接整体重建。
+ */
 
 namespace ME::Analysis
 {
-    DomInfo::DomInfo() { domAnalyzer = new DomAnalyzer(); }
+    class DomInfo::GraphView
+    {
+        using Edge = std::pair<size_t, size_t>;
 
-    DomInfo::~DomInfo() { delete domAnalyzer; }
+        const CFG&                    cfg;
+        std::map<Edge, Update::Kind>  pending;
+        std::multimap<size_t, size_t> pendingDeletedPreds;
 
-    void DomInfo::build(CFG& cfg)
+      public:
+        explicit GraphView(const CFG& cfg) : cfg(cfg) {}
+
+        size_t size() const { return cfg.size(); }
+        size_t entry() const { return cfg.entry; }
+
+        void addPending(const Update& update)
+        {
+            pending[{update.from, update.to}] = update.kind;
+            if (update.kind == Update::Delete) pendingDeletedPreds.insert({update.to, update.from});
+        }
+
+        void removePending(const Update& update)
+        {
+            pending.erase({update.from, update.to});
+            if (update.kind != Update::Delete) return;
+            auto range = pendingDeletedPreds.equal_range(update.to);
+            for (auto it = range.first; it != range.second; ++it)
+            {
+                if (it->second != update.from) continue;
+                pendingDeletedPreds.erase(it);
+                break;
+            }
+        }
+
+        template <typename Fn>
+        void forEachSucc(size_t node, Fn fn) const
+        {
+            for (size_t succ : cfg.succs(node))
+                if (!isPendingInsert(node, succ)) fn(succ);
+            for (auto it = pending.lower_bound({node, 0}); it != pending.end() && it->first.first == node; ++it)
+                if (it->second == Update::Delete) fn(it->first.second);
+        }
+
+        template <typename Fn>
+        void forEachPred(size_t node, Fn fn) const
+        {
+            for (size_t pred : cfg.preds(node))
+                if (!isPendingInsert(pred, node)) fn(pred);
+            auto range = pendingDeletedPreds.equal_range(node);
+            for (auto it = range.first; it != range.second; ++it) fn(it->second);
+        }
+
+      private:
+        bool isPendingInsert(size_t from, size_t to) const
+        {
+            if (pending.empty()) return false;
+            auto it = pending.find({from, to});
+            return it != pending.end() && it->second == Update::Insert;
+        }
+    };
+
+    namespace
     {
-        domAnalyzer->clear();
-        std::vector<int> exitPoints;
-        for (auto& [blockId, block] : cfg.id2block)
+        // 从 root 出发的非递归 DFS，只进入 descend(node) 为真的结点
+        // order 为先序，parent 为 DFS 父亲在 order 中的下标
+        template <typename View, typename Descend>
+        void collectSubgraph(
+            const View& view, int root, Descend descend, std::vector<int>& order, std::vector<int>& parent)
         {
-            for (auto* inst : block->insts)
+            // 出栈时才标记访问，父亲取最后一次压栈者，这样得到的才是合法的 DFS 树
+            std::unordered_set<int>          visited;
+            std::vector<std::pair<int, int>> stack;  // (结点, 父亲下标)
+            std::vector<int>                 succs;
+            stack.push_back({root, 0});
+            while (!stack.empty())
             {
-                if (!inst->isTerminator()) continue;
-                if (inst->opcode != ME::Operator::RET) continue;
+                auto [node, parentIdx] = stack.back();
+                stack.pop_back();
+                if (!visited.insert(node).second) continue;
+                int idx = (int)order.size();
+                order.push_back(node);
+                parent.push_back(parentIdx);
 
-                exitPoints.push_back((int)blockId);
-                break;
+                succs.clear();
+                view.forEachSucc(node, [&](size_t succ) { succs.push_back((int)succ); });
+                for (auto it = succs.rbegin(); it != succs.rend(); ++it)
+                {
+                    if (visited.count(*it) || !descend(*it)) continue;
+                    stack.push_back({*it, idx});
+                }
             }
         }
+    }  // namespace
+
+    DomInfo::DomInfo() : domAnalyzer(new DomAnalyzer()), cfg(nullptr) {}
+
+    DomInfo::~DomInfo() { delete domAnalyzer; }
+
+    void DomInfo::build(CFG& cfg)
+    {
+        this->cfg = &cfg;
+        domAnalyzer->clear();
+        depth.clear();
+        frontierDirty  = false;
+        intervalsDirty = true;
+        if (cfg.size() == 0) return;
 
         std::vector<std::vector<int>> graph_int;
         graph_int.resize(cfg.G_id.size());
@@ -32,8 +148,526 @@ namespace ME::Analysis
             for (size_t successor : cfg.G_id[i]) graph_int[i].push_back((int)successor);
         }
 
-        std::vector<int> entryPoints = {0};
+        std::vector<int> entryPoints = {(int)cfg.entry};
         domAnalyzer->solve(graph_int, entryPoints, false);
+
+        depth.assign(cfg.size(), -1);
+        depth[cfg.entry] = 0;
+        updateDepths((int)cfg.entry);
+    }
+
+    const std::vector<std::vector<int>>& DomInfo::getDomFrontier() const
+    {
+        if (frontierDirty) computeFrontier();
+        return domAnalyzer->dom_frontier;
+    }
+
+    int DomInfo::findNearestCommonDominator(int a, int b) const
+    {
+        auto& idom = domAnalyzer->imm_dom;
+        while (a != b)
+        {
+            if (depth[a] < depth[b])
+                b = idom[b];
+            else
+                a = idom[a];
+        }
+        return a;
+    }
+
+    void DomInfo::applyUpdates(const std::vector<Update>& updates)
+    {
+        ASSERT(cfg && "DomInfo::applyUpdates before build");
+        grow(cfg->size());
+
+        // 合并同一条边上相互抵消的更新; 与 CFG 当前状态矛盾的更新 (例如重复边) 不改变图，直接忽略
+        std::map<std::pair<size_t, size_t>, int> net;
+        for (auto& update : updates) net[{update.from, update.to}] += update.kind == Update::Insert ? 1 : -1;
+
+        std::vector<Update> legalized;
+        for (auto& update : updates)
+        {
+            auto it = net.find({update.from, update.to});
+            if (it == net.end()) continue;
+            int count = it->second;
+            net.erase(it);
+            if (count == 0) continue;
+
+            Update::Kind kind    = count > 0 ? Update::Insert : Update::Delete;
+            auto&        succs   = cfg->succs(update.from);
+            bool         present = std::find(succs.begin(), succs.end(), update.to) != succs.end();
+            if ((kind == Update::Insert) != present) continue;
+            legalized.push_back({kind, update.from, update.to});
+        }
+
+        if (!legalized.empty())
+        {
+            GraphView view(*cfg);
+            for (auto& update : legalized) view.addPending(update);
+
+            for (auto& update : legalized)
+            {
+                view.removePending(update);
+                int from = (int)update.from;
+                int to   = (int)update.to;
+                if (!isReachable(from)) continue;
+
+                if (update.kind == Update::Insert)
+                {
+                    if (isReachable(to))
+                        insertReachable(view, from, to);
+                    else
+                        insertUnreachable(view, from, to);
+                    continue;
+                }
+
+                if (!isReachable(to)) continue;
+                if (findNearestCommonDominator(from, to) == to) continue;
+                if (deleteBypassedEdge(view, from, to)) continue;
+                if (domAnalyzer->imm_dom[to] != from || hasProperSupport(view, to))
+                    deleteReachable(view, from, to);
+                else
+                    deleteUnreachable(view, to);
+            }
+            frontierDirty  = true;
+            intervalsDirty = true;
+        }
+
+        if (verifyUpdates && !verify()) ERROR("DomInfo: incremental update diverged from a full rebuild");
+    }
+
+    bool DomInfo::verify() const
+    {
+        DomAnalyzer reference;
+        if (cfg->size() != 0)
+        {
+            std::vector<std::vector<int>> graph_int(cfg->size());
+            for (size_t i = 0; i < cfg->size(); ++i)
+                for (size_t successor : cfg->succs(i)) graph_int[i].push_back((int)successor);
+            reference.solve(graph_int, {(int)cfg->entry}, false);
+        }
+
+        auto& imm_dom  = domAnalyzer->imm_dom;
+        auto& dom_tree = domAnalyzer->dom_tree;
+        if (imm_dom.size() != reference.imm_dom.size() || dom_tree.size() != reference.dom_tree.size()) return false;
+        if (imm_dom != reference.imm_dom) return false;
+        for (size_t i = 0; i < dom_tree.size(); ++i)
+        {
+            std::vector<int> children = dom_tree[i];
+            std::vector<int> expected = reference.dom_tree[i];
+            std::sort(children.begin(), children.end());
+            std::sort(expected.begin(), expected.end());
+            if (children != expected) return false;
+
+            int expectedDepth = imm_dom[i] < 0 ? -1 : (imm_dom[i] == (int)i ? 0 : depth[imm_dom[i]] + 1);
+            if (depth[i] != expectedDepth) return false;
+        }
+
+        if (!frontierDirty && domAnalyzer->dom_frontier != reference.dom_frontier) return false;
+        return true;
+    }
+
+    void DomInfo::recalculate(const GraphView& view)
+    {
+        std::vector<std::vector<int>> graph_int(view.size());
+        for (size_t i = 0; i < view.size(); ++i)
+            view.forEachSucc(i, [&](size_t successor) { graph_int[i].push_back((int)successor); });
+        domAnalyzer->solve(graph_int, {(int)view.entry()}, false);
+
+        depth.assign(view.size(), -1);
+        depth[view.entry()] = 0;
+        updateDepths((int)view.entry());
+    }
+
+    void DomInfo::insertReachable(const GraphView& view, int from, int to)
+    {
+        int nca = findNearestCommonDominator(from, to);
+        if (depth[nca] + 1 >= depth[to]) return;
+
+        int ncaDepth = depth[nca];
+
+        // 按深度从大到小处理; 深度相同时按编号，保证结果与遍历顺序无关
+        std::priority_queue<std::pair<int, int>> bucket;
+        std::unordered_set<int>                  visited;
+        std::vector<int>                         affected;
+        std::vector<int>                         unaffectedOnLevel;
+
+        bucket.push({depth[to], to});
+        visited.insert(to);
+        while (!bucket.empty())
+        {
+            int node = bucket.top().second;
+            bucket.pop();
+            affected.push_back(node);
+            int level = depth[node];
+
+            while (true)
+            {
+                view.forEachSucc(node, [&](size_t s) {
+                    int succ = (int)s;
+                    if (!isReachable(succ)) return;
+                    if (depth[succ] <= ncaDepth + 1 || !visited.insert(succ).second) return;
+                    if (depth[succ] > level)
+                        unaffectedOnLevel.push_back(succ);
+                    else
+                        bucket.push({depth[succ], succ});
+                });
+                if (unaffectedOnLevel.empty()) break;
+                node = unaffectedOnLevel.back();
+                unaffectedOnLevel.pop_back();
+            }
+        }
+
+        for (int node : affected) setIdom(node, nca);
+        for (int node : affected)
+        {
+            depth[node] = ncaDepth + 1;
+            updateDepths(node);
+        }
+    }
+
+    void DomInfo::insertUnreachable(const GraphView& view, int from, int to)
+    {
+        // 新变为可达的结点只能经由 from->to 进入，因此都被 to 支配
+        std::vector<int> order, parent;
+        collectSubgraph(view, to, [&](int node) { return !isReachable(node); }, order, parent);
+
+        std::unordered_set<int>          discovered(order.begin(), order.end());
+        std::vector<std::pair<int, int>> connecting;
+        for (int node : order)
+        {
+            view.forEachSucc(node, [&](size_t succ) {
+                if (!discovered.count((int)succ) && isReachable(succ)) connecting.push_back({node, (int)succ});
+            });
+        }
+
+        setIdom(to, from);
+        depth[to] = depth[from] + 1;
+        runSemiNCA(view, order, parent);
+
+        for (auto& [edgeFrom, edgeTo] : connecting) insertReachable(view, edgeFrom, edgeTo);
+    }
+
+    bool DomInfo::hasProperSupport(const GraphView& view, int node) const
+    {
+        bool supported = false;
+        view.forEachPred(node, [&](size_t pred) {
+            if (supported || !isReachable(pred)) return;
+            if (findNearestCommonDominator(node, (int)pred) != node) supported = true;
+        });
+        return supported;
+    }
+
+    bool DomInfo::deleteBypassedEdge(const GraphView& view, int from, int to)
+    {
+        // 找到只有 from 一个前驱、只有 to 一个后继的块 mid (splitEdge 插入的块即是如此)
+        int mid = -1;
+        view.forEachPred(to, [&](size_t pred) {
+            int candidate = (int)pred;
+            if (mid >= 0 || candidate == from || domAnalyzer->imm_dom[candidate] != from) return;
+
+            bool single = true;
+            view.forEachPred(candidate, [&](size_t p) { single = single && (int)p == from; });
+            view.forEachSucc(candidate, [&](size_t s) { single = single && (int)s == to; });
+            if (single) mid = candidate;
+        });
+        if (mid < 0) return false;
+
+        // 删除后原先经过 from->to 的路径都可以改走 from->mid->to，因此其他结点的支配关系不变;
+        // 只有当 to 的其余前驱都被 to 自身支配时，mid 成为 to 新的直接支配者
+        bool supported = false;
+        view.forEachPred(to, [&](size_t pred) {
+            if (supported || (int)pred == mid || !isReachable(pred)) return;
+            if (findNearestCommonDominator(to, (int)pred) != to) supported = true;
+        });
+        if (supported) return true;
+
+        setIdom(to, mid);
+        depth[to] = depth[mid] + 1;
+        updateDepths(to);
+        return true;
+    }
+
+    void DomInfo::deleteReachable(const GraphView& view, int from, int to)
+    {
+        int root = findNearestCommonDominator(from, to);
+        if (domAnalyzer->imm_dom[root] == root)
+        {
+            recalculate(view);
+            return;
+        }
+
+        // root 子树中的结点深度均大于 depth(root)，而从子树内可达的其他结点深度不超过 depth(root)
+        int              level = depth[root];
+        std::vector<int> order, parent;
+        collectSubgraph(view, root, [&](int node) { return depth[node] > level; }, order, parent);
+        runSemiNCA(view, order, parent);
+    }
+
+    void DomInfo::deleteUnreachable(const GraphView& view, int to)
+    {
+        // to 的整棵子树变为不可达; 子树之外被它指向的结点的支配者可能随之上移
+        int              level = depth[to];
+        std::vector<int> affected;
+        std::vector<int> order, parent;
+        collectSubgraph(view,
+            to,
+            [&](int node) {
+                if (depth[node] > level) return true;
+                if (isReachable(node) && std::find(affected.begin(), affected.end(), node) == affected.end())
+                    affected.push_back(node);
+                return false;
+            },
+            order,
+            parent);
+
+        int minNode = to;
+        for (int node : affected)
+        {
+            int nca = findNearestCommonDominator(node, to);
+            if (nca != node && depth[nca] < depth[minNode]) minNode = nca;
+        }
+
+        if (domAnalyzer->imm_dom[minNode] == minNode)
+        {
+            recalculate(view);
+            return;
+        }
+
+        // 逆先序删除，保证孩子先于父亲被摘除
+        for (auto it = order.rbegin(); it != order.rend(); ++it)
+        {
+            setIdom(*it, -1);
+            domAnalyzer->dom_tree[*it].clear();
+            depth[*it] = -1;
+        }
+        if (minNode == to) return;
+
+        int minLevel = depth[minNode];
+        order.clear();
+        parent.clear();
+        collectSubgraph(view, minNode, [&](int node) { return depth[node] > minLevel; }, order, parent);
+        runSemiNCA(view, order, parent);
+    }
+
+    void DomInfo::runSemiNCA(const GraphView& view, const std::vector<int>& order, const std::vector<int>& parent)
+    {
+        int n = (int)order.size();
+        if (n <= 1) return;
+
+        std::unordered_map<int, int> index;
+        for (int i = 0; i < n; ++i) index[order[i]] = i;
+
+        std::vector<int> semi(n), label(n), ancestor(parent), idom(parent);
+        for (int i = 0; i < n; ++i) semi[i] = label[i] = i;
+
+        // 带路径压缩的 eval: 下标不小于 lastLinked 的结点已经链接到森林中
+        std::vector<int> stack;
+        auto             eval = [&](int v, int lastLinked) {
+            if (ancestor[v] < lastLinked) return label[v];
+            do {
+                stack.push_back(v);
+                v = ancestor[v];
+            } while (ancestor[v] >= lastLinked);
+
+            int p = v;
+            while (!stack.empty())
+            {
+                v = stack.back();
+                stack.pop_back();
+                ancestor[v] = ancestor[p];
+                if (semi[label[p]] < semi[label[v]]) label[v] = label[p];
+                p = v;
+            }
+            return label[v];
+        };
+
+        for (int i = n - 1; i >= 1; --i)
+        {
+            semi[i] = parent[i];
+            view.forEachPred(order[i], [&](size_t pred) {
+                auto it = index.find((int)pred);
+                if (it == index.end()) return;
+                int u = it->second == 0 ? 0 : eval(it->second, i + 1);
+                if (semi[u] < semi[i]) semi[i] = semi[u];
+            });
+        }
+
+        for (int i = 1; i < n; ++i)
+        {
+            int candidate = idom[i];
+            while (candidate > semi[i]) candidate = idom[candidate];
+            idom[i] = candidate;
+        }
+
+        for (int i = 1; i < n; ++i) setIdom(order[i], order[idom[i]]);
+        updateDepths(order[0]);
+    }
+
+    void DomInfo::setIdom(int node, int idom)
+    {
+        auto& imm_dom  = domAnalyzer->imm_dom;
+        auto& dom_tree = domAnalyzer->dom_tree;
+
+        int old = imm_dom[node];
+        if (old == idom) return;
+        if (old >= 0 && old != node)
+        {
+            auto& siblings = dom_tree[old];
+            siblings.erase(std::find(siblings.begin(), siblings.end(), node));
+        }
+        imm_dom[node] = idom;
+        if (idom >= 0 && idom != node) dom_tree[idom].push_back(node);
+    }
+
+    void DomInfo::updateDepths(int root)
+    {
+        auto&            dom_tree = domAnalyzer->dom_tree;
+        std::vector<int> worklist = {root};
+        while (!worklist.empty())
+        {
+            int node = worklist.back();
+            worklist.pop_back();
+            for (int child : dom_tree[node])
+            {
+                depth[child] = depth[node] + 1;
+                worklist.push_back(child);
+            }
+        }
+    }
+
+    void DomInfo::grow(size_t size)
+    {
+        if (size <= depth.size()) return;
+        domAnalyzer->imm_dom.resize(size, -1);
+        domAnalyzer->dom_tree.resize(size);
+        domAnalyzer->dom_frontier.resize(size);
+        depth.resize(size, -1);
+    }
+
+    void DomInfo::computeFrontier() const
+    {
+        auto& imm_dom      = domAnalyzer->imm_dom;
+        auto& dom_frontier = domAnalyzer->dom_frontier;
+        dom_frontier.assign(imm_dom.size(), {});
+
+        // 对每条边 pred->node，沿 idom 链从 pred 向上直到 idom(node)，途经结点的支配边界都包含 node
+        // 入口的 idom 视为其上方的虚拟源; node 按编号递增处理，因此各支配边界有序
+        for (size_t node = 0; node < imm_dom.size(); ++node)
+        {
+            if (imm_dom[node] < 0) continue;
+            int stop = imm_dom[node] == (int)node ? -1 : imm_dom[node];
+            for (size_t pred : cfg->preds(node))
+            {
+                int runner = (int)pred;
+                if (imm_dom[runner] < 0) continue;
+                while (runner != stop)
+                {
+                    auto& frontier = dom_frontier[runner];
+                    if (frontier.empty() || frontier.back() != (int)node) frontier.push_back((int)node);
+                    if (imm_dom[runner] == runner) break;
+                    runner = imm_dom[runner];
+                }
+            }
+        }
+        frontierDirty = false;
+    }
+
+    void DomInfo::computeIntervals() const
+    {
+        auto& dom_tree = domAnalyzer->dom_tree;
+        dfsIn.assign(depth.size(), -1);
+        dfsOut.assign(depth.size(), -1);
+        intervalsDirty = false;
+        if (!cfg || !isReachable(cfg->entry)) return;
+
+        int                                 counter = 0;
+        std::vector<std::pair<int, size_t>> stack;  // (结点, 下一个待访问的孩子下标)
+        dfsIn[cfg->entry] = counter++;
+        stack.push_back({(int)cfg->entry, 0});
+        while (!stack.empty())
+        {
+            int node = stack.back().first;
+            if (stack.back().second < dom_tree[node].size())
+            {
+                int child = dom_tree[node][stack.back().second++];
+                dfsIn[child] = counter++;
+                stack.push_back({child, 0});
+                continue;
+            }
+            dfsOut[node] = counter++;
+            stack.pop_back();
+        }
+    }
+
+    bool DomInfo::dominates(int a, int b) const
+    {
+        if (a == b || !isReachable(b)) return true;
+        if (!isReachable(a)) return false;
+        if (intervalsDirty) computeIntervals();
+        return dfsIn[a] <= dfsIn[b] && dfsOut[b] <= dfsOut[a];
+    }
+
+    std::vector<int> DomInfo::computeIDF(const std::vector<int>& defBlocks, const std::vector<bool>* liveIn) const
+    {
+        /*
+         * Sreedhar-Gao: 按支配树深度从深到浅依次取出定义块作为 root，遍历 root 的支配子树;
+         * 子树中结点 x 的每条 CFG 边 x->y 若满足 depth(y) <= depth(root)，则 y 属于 IDF。
+         * 新加入 IDF 的块本身也是定义点，放回优先队列 (piggybank)。
+         * 每个结点至多进入优先队列与子树遍历各一次，总复杂度为 O(N + E) (忽略堆的对数因子)。
+         */
+        if (intervalsDirty) computeIntervals();
+
+        using Key = std::pair<std::pair<int, int>, int>;  // ((深度, dfsIn), 结点)
+        std::priority_queue<Key> piggybank;
+        std::vector<char>        inPiggybank(depth.size(), 0);
+        std::vector<char>        visited(depth.size(), 0);
+        std::vector<char>        isDef(depth.size(), 0);
+        std::vector<int>         result;
+
+        for (int block : defBlocks)
+        {
+            if (!isReachable(block) || isDef[block]) continue;
+            isDef[block]   = 1;
+            visited[block] = 1;
+            piggybank.push({{depth[block], dfsIn[block]}, block});
+        }
+
+        std::vector<int> worklist;
+        while (!piggybank.empty())
+        {
+            int root      = piggybank.top().second;
+            int rootLevel = depth[root];
+            piggybank.pop();
+
+            visited[root] = 1;
+            worklist.push_back(root);
+            while (!worklist.empty())
+            {
+                int node = worklist.back();
+                worklist.pop_back();
+
+                for (size_t s : cfg->succs(node))
+                {
+                    int succ = (int)s;
+                    if (!isReachable(succ) || depth[succ] > rootLevel || inPiggybank[succ]) continue;
+                    inPiggybank[succ] = 1;
+                    if (liveIn && !(*liveIn)[succ]) continue;
+
+                    result.push_back(succ);
+                    if (!isDef[succ]) piggybank.push({{depth[succ], dfsIn[succ]}, succ});
+                }
+                for (int child : domAnalyzer->dom_tree[node])
+                {
+                    if (visited[child]) continue;
+                    visited[child] = 1;
+                    worklist.push_back(child);
+                }
+            }
+        }
+
+        std::sort(result.begin(), result.end());
+        return result;
     }
 
     template <>
@@ -41,11 +675,11 @@ namespace ME::Analysis
     {
         if (auto* cached = getCached<DomInfo>(func)) return cached;
 
+        registerDependency<DomInfo, CFG>();
         auto* cfg = get<CFG>(func);
 
         auto* domInfo = new DomInfo();
         domInfo->build(*cfg);
-        cache<DomInfo>(func, domInfo);
-        return domInfo;
+        return cache<DomInfo>(func, domInfo);
     }
 }  // namespace ME::Analysis
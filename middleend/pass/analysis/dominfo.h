@@ -5,6 +5,24 @@
 #include <middleend/pass/analysis/cfg.h>
 #include <dom_analyzer.h>
 
+/*
+ * 支配信息
+ * - 通过 Analysis::AM.get<DomInfo>(function) 获取，依赖 CFG。
+ * - 支配树的动态更新: 只改动少量边的 pass (拆分关键边、插入循环前置块、删除不可达块等)
+ *   在同步更新 CFG (addEdge/removeEdge/splitEdge) 之后，把本次改动的边以 Update 列表交给 applyUpdates，
+ *   即可就地维护 imm_dom / dom_tree，而不必整体重建; 之后在 PreservedAnalyses 中同时保留 CFG 与 DomInfo。
+ *   更新算法参考 Depth-Based Search (Georgiadis et al.) 及 LLVM 的 SemiNCA 增量实现:
+ *   - 插入边只需沿深度自高向低的桶扫描受影响的结点，并将它们的 idom 改为两端点的最近公共支配者;
+ *   - 删除边时若目标仍可达，仅在最近公共支配者的子树上重新运行 SemiNCA; 否则删除不可达的子树。
+ * - 支配边界在首次查询时按当前支配树惰性重算，每个块的支配边界为按块编号升序的数组。
+ * - dominates/properlyDominates 借助支配树上的 DFS 进出序号 [dfsIn, dfsOut] 以 O(1) 回答:
+ *   a 支配 b 当且仅当 b 的区间嵌套在 a 的区间内。序号在更新后的首次查询时重新编号。
+ *   与 LLVM 一致，不可达的块被任意块支配，而不可达的块不支配任何可达块。
+ * - computeIDF 使用 Sreedhar-Gao 的 piggybank 算法在线性时间内求迭代支配边界 (phi 插入位置)，
+ *   可选地只保留 liveIn 中标记的块 (剪枝 SSA)。
+ * - setVerifyUpdates(true) 后每次 applyUpdates 结束都会与完整重建的结果比较，不一致时报错。
+ */
+
 namespace ME::Analysis
 {
     class DomInfo
@@ -12,8 +30,30 @@ namespace ME::Analysis
       public:
         static inline const size_t TID = getTID<DomInfo>();
 
+        struct Update
+        {
+            enum Kind
+            {
+                Insert,
+                Delete
+            };
+            Kind   kind;
+            size_t from;
+            size_t to;
+        };
+
         DomAnalyzer* domAnalyzer;
 
+      private:
+        CFG*                     cfg;
+        std::vector<int>         depth;  // 结点在支配树中的深度，根为 0，不可达为 -1
+        mutable std::vector<int> dfsIn;
+        mutable std::vector<int> dfsOut;
+        mutable bool             frontierDirty  = false;
+        mutable bool             intervalsDirty = true;
+
+        static inline bool verifyUpdates = false;
+
       public:
         DomInfo();
         ~DomInfo();
@@ -21,8 +61,52 @@ namespace ME::Analysis
         void build(CFG& cfg);
 
         const std::vector<std::vector<int>>& getDomTree() const { return domAnalyzer->dom_tree; }
-        const std::vector<std::set<int>>&    getDomFrontier() const { return domAnalyzer->dom_frontier; }
+        const std::vector<std::vector<int>>& getDomFrontier() const;
         const std::vector<int>&              getImmDom() const { return domAnalyzer->imm_dom; }
+
+        bool isReachable(size_t block) const { return block < depth.size() && depth[block] >= 0; }
+        int  getDepth(size_t block) const { return block < depth.size() ? depth[block] : -1; }
+
+        // 两个可达结点在支配树上的最近公共祖先
+        int findNearestCommonDominator(int a, int b) const;
+
+        bool dominates(int a, int b) const;
+        bool properlyDominates(int a, int b) const { return a != b && dominates(a, b); }
+
+        // 在 defBlocks 中定义的变量需要插入 phi 的块，按块编号升序返回
+        // liveIn 非空时只保留 (*liveIn)[block] 为真的块
+        std::vector<int> computeIDF(const std::vector<int>& defBlocks, const std::vector<bool>* liveIn = nullptr) const;
+
+        // CFG 已经反映了 updates 中的全部改动; 按顺序逐条处理，处理第 k 条时所见的图
+        // 为 "当前 CFG 撤销第 k 条之后的所有改动"
+        void applyUpdates(const std::vector<Update>& updates);
+        void insertEdge(size_t from, size_t to) { applyUpdates({{Update::Insert, from, to}}); }
+        void deleteEdge(size_t from, size_t to) { applyUpdates({{Update::Delete, from, to}}); }
+
+        // 与在当前 CFG 上完整重建的结果比较
+        bool        verify() const;
+        static void setVerifyUpdates(bool enable) { verifyUpdates = enable; }
+
+      private:
+        class GraphView;
+
+        void recalculate(const GraphView& view);
+        void insertReachable(const GraphView& view, int from, int to);
+        void insertUnreachable(const GraphView& view, int from, int to);
+        bool deleteBypassedEdge(const GraphView& view, int from, int to);
+        void deleteReachable(const GraphView& view, int from, int to);
+        void deleteUnreachable(const GraphView& view, int to);
+        bool hasProperSupport(const GraphView& view, int node) const;
+
+        // order 为以 order[0] 为根的 DFS 先序，parent 为各结点 DFS 父亲在 order 中的下标
+        // 在这些结点上运行 SemiNCA，并把结果接回支配树 (根的 idom 保持不变)
+        void runSemiNCA(const GraphView& view, const std::vector<int>& order, const std::vector<int>& parent);
+
+        void setIdom(int node, int idom);
+        void updateDepths(int root);
+        void grow(size_t size);
+        void computeFrontier() const;
+        void computeIntervals() const;
     };
 
     template <>
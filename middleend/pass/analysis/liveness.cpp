@@ -0,0 +1,100 @@
+#include <middleend/pass/analysis/liveness.h>
+#include <middleend/pass/analysis/cfg.h>
+#include <middleend/module/ir_function.h>
+#include <middleend/module/ir_block.h>
+#include <middleend/module/ir_operand.h>
+#include <middleend/module/ir_utils.h>
+#include <middleend/visitor/utils/operand_visitor.h>
+
+namespace ME::Analysis
+{
+    namespace
+    {
+        struct LivenessProblem : BitVectorProblem<Direction::Backward, MeetOp::Union>
+        {
+            // phiUses[block] 中的 (前驱, 寄存器) 表示该寄存器在前驱 -> block 的边上被使用
+            std::vector<std::vector<std::pair<size_t, size_t>>> phiUses;
+
+            const char* name() const { return "liveness"; }
+
+            void meet(Domain& acc, const Domain& value, size_t from, size_t to) const
+            {
+                acc |= value;
+                for (auto& [pred, reg] : phiUses[to])
+                    if (pred == from) acc.set(reg);
+            }
+        };
+
+        bool isReg(Operand* op) { return op && op->getType() == OperandType::REG; }
+    }  // namespace
+
+    void Liveness::build(CFG& cfg)
+    {
+        size_t blockCount = cfg.size();
+
+        regCount = 0;
+        auto noteReg = [&](Operand* op) {
+            if (isReg(op)) regCount = std::max(regCount, op->getRegNum() + 1);
+        };
+        for (auto& arg : cfg.func->funcDef->argRegs) noteReg(arg.second);
+        for (size_t id = 0; id < blockCount; ++id)
+        {
+            Block* block = cfg.getBlock(id);
+            if (!block) continue;
+            for (auto* inst : block->insts)
+            {
+                InstOperands ops = collectOperands(*inst);
+                for (auto* use : ops.uses) noteReg(*use);
+                if (ops.def) noteReg(*ops.def);
+            }
+        }
+
+        LivenessProblem problem;
+        problem.init(blockCount, regCount);
+        problem.phiUses.assign(blockCount, {});
+        for (size_t id = 0; id < blockCount; ++id)
+        {
+            Block* block = cfg.getBlock(id);
+            if (!block) continue;
+
+            auto& gen  = problem.gen[id];
+            auto& kill = problem.kill[id];
+            for (auto* inst : block->insts)
+            {
+                if (inst->opcode == Operator::PHI)
+                {
+                    auto* phi = static_cast<PhiInst*>(inst);
+                    for (auto& [label, val] : phi->incomingVals)
+                        if (isReg(val))
+                            problem.phiUses[id].push_back(
+                                {labelOf(label), val->getRegNum()});
+                    if (isReg(phi->res)) kill.set(phi->res->getRegNum());
+                    continue;
+                }
+
+                InstOperands ops = collectOperands(*inst);
+                for (auto* use : ops.uses)
+                    if (isReg(*use) && !kill.test((*use)->getRegNum())) gen.set((*use)->getRegNum());
+                if (ops.def && isReg(*ops.def)) kill.set((*ops.def)->getRegNum());
+            }
+        }
+
+        auto result = DataflowSolver<LivenessProblem>::solve(cfg, problem);
+        liveIn      = std::move(result.in);
+        liveOut     = std::move(result.out);
+        stats       = result.stats;
+    }
+
+    template <>
+    Liveness* Manager::get<Liveness>(Function& func)
+    {
+        if (auto* cached = getCached<Liveness>(func)) return cached;
+
+        registerDependency<Liveness, CFG>();
+        auto* cfg = get<CFG>(func);
+
+        auto* liveness = new Liveness();
+        liveness->build(*cfg);
+        return cache<Liveness>(func, liveness);
+    }
+}  // namespace ME::Analysis
@@ -0,0 +1,43 @@
+#ifndef __MIDDLEEND_PASS_ANALYSIS_LIVENESS_H__
+#define __MIDDLEEND_PASS_ANALYSIS_LIVENESS_H__
+
+#include <middleend/pass/analysis/analysis_manager.h>
+#include <middleend/pass/analysis/dataflow.h>
+#include <dynamic_bitset.h>
+
+/*
+ * 虚拟寄存器的活跃变量分析
+ * - 通过 Analysis::AM.get<Liveness>(function) 获取，依赖 CFG。
+ * - liveIn/liveOut 以块编号为下标，位集中的第 i 位对应 %reg_i。
+ * - phi 的来源值视为在对应前驱的出口处被使用: 它属于该前驱的 liveOut，但不属于 phi 所在块的 liveIn;
+ *   phi 的结果在块首定义。
+ * - 函数参数寄存器没有块内定义，因此在入口块的 liveIn 中。
+ */
+
+namespace ME::Analysis
+{
+    class Liveness
+    {
+      public:
+        static inline const size_t TID = getTID<Liveness>();
+
+        std::vector<Cele::dynamic_bitset> liveIn;
+        std::vector<Cele::dynamic_bitset> liveOut;
+        DataflowStats                     stats;
+
+      private:
+        size_t regCount = 0;
+
+      public:
+        void build(CFG& cfg);
+
+        size_t getRegCount() const { return regCount; }
+        bool   isLiveIn(size_t block, size_t reg) const { return reg < regCount && liveIn[block].test(reg); }
+        bool   isLiveOut(size_t block, size_t reg) const { return reg < regCount && liveOut[block].test(reg); }
+    };
+
+    template <>
+    Liveness* Manager::get<Liveness>(Function& func);
+}  // namespace ME::Analysis
+
+#endif  // __MIDDLEEND_PASS_ANALYSIS_LIVENESS_H__
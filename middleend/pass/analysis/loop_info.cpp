@@ -0,0 +1,183 @@
+#include <middleend/pass/analysis/loop_info.h>
+#include <middleend/pass/analysis/dominfo.h>
+#include <middleend/module/ir_function.h>
+#include <middleend/module/ir_block.h>
+#include <algorithm>
+
+namespace ME::Analysis
+{
+    bool Loop::contains(size_t block) const { return std::binary_search(blocks.begin(), blocks.end(), block); }
+
+    bool Loop::contains(const Loop* other) const
+    {
+        for (; other; other = other->parent)
+            if (other == this) return true;
+        return false;
+    }
+
+    LoopInfo::~LoopInfo()
+    {
+        for (auto* loop : allLoops) delete loop;
+    }
+
+    void LoopInfo::build(CFG& cfg, DomInfo& domInfo)
+    {
+        this->cfg = &cfg;
+        for (auto* loop : allLoops) delete loop;
+        topLevelLoops.clear();
+        allLoops.clear();
+        blockLoop.assign(cfg.size(), nullptr);
+
+        // 支配树后序: 被支配的 (内层) header 先于支配它的 (外层) header
+        const auto&         tree = domInfo.getDomTree();
+        std::vector<size_t> postOrder;
+        std::vector<std::pair<size_t, size_t>> stack;
+        if (domInfo.isReachable(cfg.entry)) stack.push_back({cfg.entry, 0});
+        while (!stack.empty())
+        {
+            auto& [node, next] = stack.back();
+            if (next < tree[node].size())
+            {
+                size_t child = tree[node][next++];
+                stack.push_back({child, 0});
+                continue;
+            }
+            postOrder.push_back(node);
+            stack.pop_back();
+        }
+
+        for (size_t header : postOrder)
+        {
+            std::vector<size_t> backEdges;
+            for (size_t pred : cfg.preds(header))
+                if (domInfo.isReachable(pred) && domInfo.dominates(header, pred)) backEdges.push_back(pred);
+            if (backEdges.empty()) continue;
+
+            auto* loop = new Loop(header);
+            allLoops.push_back(loop);
+            discover(loop, backEdges);
+        }
+
+        populate();
+    }
+
+    void LoopInfo::discover(Loop* loop, const std::vector<size_t>& backEdges)
+    {
+        std::vector<size_t> worklist(backEdges);
+        while (!worklist.empty())
+        {
+            size_t block = worklist.back();
+            worklist.pop_back();
+
+            Loop* sub = blockLoop[block];
+            if (!sub)
+            {
+                blockLoop[block] = loop;
+                if (block == loop->header) continue;
+                for (size_t pred : cfg->preds(block))
+                    if (cfg->getRPOIndex(pred) != CFG::npos) worklist.push_back(pred);
+                continue;
+            }
+
+            // 已属于内层循环: 把其最外层祖先挂到当前循环下，从它的 header 继续向上搜索
+            while (sub->parent) sub = sub->parent;
+            if (sub == loop) continue;
+            sub->parent = loop;
+            for (size_t pred : cfg->preds(sub->header))
+                if (cfg->getRPOIndex(pred) != CFG::npos) worklist.push_back(pred);
+        }
+    }
+
+    void LoopInfo::populate()
+    {
+        auto byRPO = [this](const Loop* a, const Loop* b) {
+            return cfg->getRPOIndex(a->header) < cfg->getRPOIndex(b->header);
+        };
+
+        for (auto* loop : allLoops)
+        {
+            if (loop->parent)
+                loop->parent->subLoops.push_back(loop);
+            else
+                topLevelLoops.push_back(loop);
+        }
+        std::sort(topLevelLoops.begin(), topLevelLoops.end(), byRPO);
+        for (auto* loop : allLoops) std::sort(loop->subLoops.begin(), loop->subLoops.end(), byRPO);
+
+        allLoops.clear();
+        std::vector<Loop*> stack(topLevelLoops.rbegin(), topLevelLoops.rend());
+        while (!stack.empty())
+        {
+            Loop* loop = stack.back();
+            stack.pop_back();
+            loop->depth = loop->parent ? loop->parent->depth + 1 : 1;
+            allLoops.push_back(loop);
+            stack.insert(stack.end(), loop->subLoops.rbegin(), loop->subLoops.rend());
+        }
+
+        for (size_t id = 0; id < blockLoop.size(); ++id)
+            for (Loop* loop = blockLoop[id]; loop; loop = loop->parent) loop->blocks.push_back(id);
+
+        for (auto* loop : allLoops)
+        {
+            for (size_t pred : cfg->preds(loop->header))
+                if (loop->contains(pred)) loop->latches.push_back(pred);
+            std::sort(loop->latches.begin(), loop->latches.end());
+
+            for (size_t block : loop->blocks)
+            {
+                bool exiting = false;
+                for (size_t succ : cfg->succs(block))
+                {
+                    if (loop->contains(succ)) continue;
+                    exiting = true;
+                    loop->exitBlocks.push_back(succ);
+                }
+                if (exiting) loop->exitingBlocks.push_back(block);
+            }
+            std::sort(loop->exitBlocks.begin(), loop->exitBlocks.end());
+            loop->exitBlocks.erase(
+                std::unique(loop->exitBlocks.begin(), loop->exitBlocks.end()), loop->exitBlocks.end());
+        }
+    }
+
+    size_t LoopInfo::getLoopDepth(size_t block) const
+    {
+        Loop* loop = getLoopFor(block);
+        return loop ? loop->depth : 0;
+    }
+
+    bool LoopInfo::isLoopHeader(size_t block) const
+    {
+        Loop* loop = getLoopFor(block);
+        return loop && loop->header == block;
+    }
+
+    size_t LoopInfo::getPreheader(const Loop& loop) const
+    {
+        size_t preheader = CFG::npos;
+        for (size_t pred : cfg->preds(loop.header))
+        {
+            if (loop.contains(pred)) continue;
+            if (preheader != CFG::npos) return CFG::npos;
+            preheader = pred;
+        }
+        if (preheader == CFG::npos || cfg->succs(preheader).size() != 1) return CFG::npos;
+        return preheader;
+    }
+
+    template <>
+    LoopInfo* Manager::get<LoopInfo>(Function& func)
+    {
+        if (auto* cached = getCached<LoopInfo>(func)) return cached;
+
+        registerDependency<LoopInfo, CFG>();
+        registerDependency<LoopInfo, DomInfo>();
+        auto* cfg     = get<CFG>(func);
+        auto* domInfo = get<DomInfo>(func);
+
+        auto* loopInfo = new LoopInfo();
+        loopInfo->build(*cfg, *domInfo);
+        return cache<LoopInfo>(func, loopInfo);
+    }
+}  // namespace ME::Analysis
@@ -0,0 +1,86 @@
+#ifndef __MIDDLEEND_PASS_ANALYSIS_LOOP_INFO_H__
+#define __MIDDLEEND_PASS_ANALYSIS_LOOP_INFO_H__
+
+#include <middleend/pass/analysis/analysis_manager.h>
+#include <middleend/pass/analysis/cfg.h>
+#include <vector>
+
+/*
+ * 自然循环分析
+ * - 通过 Analysis::AM.get<LoopInfo>(function) 获取，依赖 CFG 与 DomInfo。
+ * - 回边为 latch -> header 且 header 支配 latch 的边; 同一 header 的所有回边组成一个自然循环。
+ *   按支配树后序处理 header，内层循环先于外层构建，沿前驱反向搜索时遇到已属于某个内层循环的块，
+ *   直接跳到该内层循环最外层祖先的 header 继续，每个块只被访问常数次。
+ *   不可归约的环 (入口不唯一) 不构成自然循环，不会被识别。
+ * - Loop 中的块、latch、exiting/exit 块均按块编号升序保存; blocks 包含所有子循环的块。
+ *   depth 从 1 开始，不在任何循环中的块深度为 0。
+ * - 子循环与顶层循环按 header 在逆后序中的位置排序，getLoops() 按先序 (外层在前) 给出全部循环。
+ * - getPreheader: 循环外唯一的前驱且其唯一后继是 header，没有时返回 CFG::npos;
+ *   需要前置块的 pass 可以用 CFG::splitEdge 自行插入。
+ * - 循环的迭代次数由 ScalarEvolution 给出 (getBackedgeTakenCount / getConstantTripCount)。
+ */
+
+namespace ME::Analysis
+{
+    class DomInfo;
+
+    class Loop
+    {
+      public:
+        size_t              header;
+        Loop*               parent = nullptr;
+        std::vector<Loop*>  subLoops;
+        std::vector<size_t> blocks;
+        std::vector<size_t> latches;
+        std::vector<size_t> exitingBlocks;  // 有后继在循环外的循环内块
+        std::vector<size_t> exitBlocks;     // 循环外、有前驱在循环内的块
+        size_t              depth = 1;
+
+      public:
+        explicit Loop(size_t h) : header(h) {}
+
+        bool contains(size_t block) const;
+        bool contains(const Loop* other) const;
+        bool isInnermost() const { return subLoops.empty(); }
+        bool isOutermost() const { return parent == nullptr; }
+    };
+
+    class LoopInfo
+    {
+      public:
+        static inline const size_t TID = getTID<LoopInfo>();
+
+      private:
+        CFG*               cfg = nullptr;
+        std::vector<Loop*> topLevelLoops;
+        std::vector<Loop*> allLoops;   // 先序
+        std::vector<Loop*> blockLoop;  // 以块编号为下标，块所属的最内层循环
+
+      public:
+        LoopInfo() = default;
+        ~LoopInfo();
+        LoopInfo(const LoopInfo&)            = delete;
+        LoopInfo& operator=(const LoopInfo&) = delete;
+
+        void build(CFG& cfg, DomInfo& domInfo);
+
+        const std::vector<Loop*>& getTopLevelLoops() const { return topLevelLoops; }
+        const std::vector<Loop*>& getLoops() const { return allLoops; }
+        bool                      empty() const { return allLoops.empty(); }
+
+        Loop*  getLoopFor(size_t block) const { return block < blockLoop.size() ? blockLoop[block] : nullptr; }
+        size_t getLoopDepth(size_t block) const;
+        bool   isLoopHeader(size_t block) const;
+
+        size_t getPreheader(const Loop& loop) const;
+
+      private:
+        void discover(Loop* loop, const std::vector<size_t>& backEdges);
+        void populate();
+    };
+
+    template <>
+    LoopInfo* Manager::get<LoopInfo>(Function& func);
+}  // namespace ME::Analysis
+
+#endif  // __MIDDLEEND_PASS_ANALYSIS_LOOP_INFO_H__
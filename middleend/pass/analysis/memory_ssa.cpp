@@ -0,0 +1,310 @@
+#include <middleend/pass/analysis/memory_ssa.h>
+#include <middleend/pass/analysis/alias_analysis.h>
+#include <middleend/pass/analysis/cfg.h>
+#include <middleend/pass/analysis/dominfo.h>
+#include <middleend/module/ir_function.h>
+#include <middleend/module/ir_block.h>
+#include <middleend/module/ir_instruction.h>
+#include <middleend/module/ir_operand.h>
+#include <algorithm>
+#include <numeric>
+
+namespace ME::Analysis
+{
+    std::string MemoryAccess::toString() const
+    {
+        auto name = [](const MemoryAccess* acc) {
+            return acc->isLiveOnEntry() ? std::string("liveOnEntry") : std::to_string(acc->id);
+        };
+        switch (kind)
+        {
+            case Kind::LiveOnEntry: return "liveOnEntry";
+            case Kind::Def: return std::to_string(id) + " = MemoryDef(" + name(defining) + ")";
+            case Kind::Use: return "MemoryUse(" + name(defining) + ")";
+            default:
+            {
+                std::string text = std::to_string(id) + " = MemoryPhi(";
+                for (size_t i = 0; i < incoming.size(); ++i)
+                    text += (i ? ", {%Block" : "{%Block") + std::to_string(incoming[i].first) + ", " +
+                            name(incoming[i].second) + "}";
+                return text + ")";
+            }
+        }
+    }
+
+    void MemorySSA::build(CFG& cfg, DomInfo& domInfo, AliasAnalysis& aa)
+    {
+        this->cfg     = &cfg;
+        this->domInfo = &domInfo;
+        this->aa      = &aa;
+        pool.clear();
+        blockAccesses.assign(cfg.size(), {});
+        instAccesses.clear();
+        ptrClass.clear();
+        clobberCache.clear();
+        inProgress.clear();
+        liveOnEntry = create(MemoryAccess::Kind::LiveOnEntry, cfg.entry, npos, nullptr);
+
+        std::vector<std::vector<Operand*>> classBases = partition();
+
+        std::vector<std::vector<int>> defBlocks(classCount);
+        auto addAccess = [&](MemoryAccess::Kind kind, size_t block, size_t cls, Instruction* inst) {
+            MemoryAccess* acc = create(kind, block, cls, inst);
+            blockAccesses[block].push_back(acc);
+            instAccesses[inst].push_back(acc);
+            if (kind == MemoryAccess::Kind::Def && (defBlocks[cls].empty() || defBlocks[cls].back() != (int)block))
+                defBlocks[cls].push_back(block);
+        };
+
+        for (size_t id : cfg.getRPO())
+            for (auto* inst : cfg.getBlock(id)->insts)
+            {
+                if (inst->opcode == Operator::LOAD)
+                    addAccess(MemoryAccess::Kind::Use, id, ptrClass[static_cast<LoadInst*>(inst)->ptr], inst);
+                else if (inst->opcode == Operator::STORE)
+                    addAccess(MemoryAccess::Kind::Def, id, ptrClass[static_cast<StoreInst*>(inst)->ptr], inst);
+                else if (inst->opcode == Operator::CALL)
+                {
+                    auto* call = static_cast<CallInst*>(inst);
+                    for (size_t cls = 0; cls < classCount; ++cls)
+                    {
+                        ModRefInfo info = ModRefInfo::NoModRef;
+                        for (auto* base : classBases[cls]) info = info | aa.getModRef(*call, base);
+                        if (isModSet(info))
+                            addAccess(MemoryAccess::Kind::Def, id, cls, inst);
+                        else if (isRefSet(info))
+                            addAccess(MemoryAccess::Kind::Use, id, cls, inst);
+                    }
+                }
+            }
+
+        // phi 放在各块访问的最前面
+        std::vector<std::vector<MemoryAccess*>> phis(cfg.size());
+        for (size_t cls = 0; cls < classCount; ++cls)
+            for (int block : domInfo.computeIDF(defBlocks[cls]))
+                phis[block].push_back(create(MemoryAccess::Kind::Phi, block, cls, nullptr));
+        for (size_t id = 0; id < cfg.size(); ++id)
+            if (!phis[id].empty()) blockAccesses[id].insert(blockAccesses[id].begin(), phis[id].begin(), phis[id].end());
+
+        rename();
+    }
+
+    MemoryAccess* MemorySSA::create(MemoryAccess::Kind kind, size_t block, size_t cls, Instruction* inst)
+    {
+        auto acc   = std::make_unique<MemoryAccess>();
+        acc->kind  = kind;
+        acc->id    = pool.size();
+        acc->block = block;
+        acc->cls   = cls;
+        acc->inst  = inst;
+        pool.push_back(std::move(acc));
+        return pool.back().get();
+    }
+
+    std::vector<std::vector<Operand*>> MemorySSA::partition()
+    {
+        // 基对象: alloca / 全局变量 / 形参; 来源未知的指针以自身作为基对象
+        std::vector<Operand*>                bases;
+        std::unordered_map<Operand*, size_t> baseIndex;
+        std::unordered_map<Operand*, size_t> ptrBase;
+        for (size_t id : cfg->getRPO())
+            for (auto* inst : cfg->getBlock(id)->insts)
+            {
+                Operand* ptr = nullptr;
+                if (inst->opcode == Operator::LOAD) ptr = static_cast<LoadInst*>(inst)->ptr;
+                if (inst->opcode == Operator::STORE) ptr = static_cast<StoreInst*>(inst)->ptr;
+                if (!ptr || ptrBase.count(ptr)) continue;
+
+                const MemoryLocation& loc  = aa->getLocation(ptr);
+                Operand*              base = loc.kind == MemoryLocation::Kind::Unknown ? ptr : loc.base;
+                auto [it, inserted]        = baseIndex.emplace(base, bases.size());
+                if (inserted) bases.push_back(base);
+                ptrBase[ptr] = it->second;
+            }
+
+        std::vector<size_t> parent(bases.size());
+        std::iota(parent.begin(), parent.end(), 0);
+        auto find = [&](size_t x) {
+            while (parent[x] != x) x = parent[x] = parent[parent[x]];
+            return x;
+        };
+        for (size_t i = 0; i < bases.size(); ++i)
+            for (size_t j = i + 1; j < bases.size(); ++j)
+                if (find(i) != find(j) && aa->mayShareObject(bases[i], bases[j])) parent[find(j)] = find(i);
+
+        // 类按首次出现的顺序编号
+        std::vector<size_t>                classOf(bases.size(), npos);
+        std::vector<std::vector<Operand*>> classBases;
+        for (size_t i = 0; i < bases.size(); ++i)
+        {
+            size_t root = find(i);
+            if (classOf[root] == npos)
+            {
+                classOf[root] = classBases.size();
+                classBases.emplace_back();
+            }
+            classBases[classOf[root]].push_back(bases[i]);
+        }
+        classCount = classBases.size();
+        for (auto& [ptr, index] : ptrBase) ptrClass[ptr] = classOf[find(index)];
+        return classBases;
+    }
+
+    void MemorySSA::rename()
+    {
+        struct Frame
+        {
+            size_t                                        block;
+            size_t                                        child = 0;
+            std::vector<std::pair<size_t, MemoryAccess*>> saved;
+        };
+
+        std::vector<MemoryAccess*> current(classCount, liveOnEntry);
+        const auto&                tree = domInfo->getDomTree();
+        std::vector<Frame>         stack;
+
+        auto enter = [&](size_t block) {
+            Frame frame;
+            frame.block = block;
+            for (auto* acc : blockAccesses[block])
+            {
+                if (acc->isUse())
+                {
+                    acc->defining = current[acc->cls];
+                    continue;
+                }
+                if (acc->isDef()) acc->defining = current[acc->cls];
+                frame.saved.push_back({acc->cls, current[acc->cls]});
+                current[acc->cls] = acc;
+            }
+            for (size_t succ : cfg->succs(block))
+                for (auto* acc : blockAccesses[succ])
+                {
+                    if (!acc->isPhi()) break;
+                    acc->incoming.push_back({block, current[acc->cls]});
+                }
+            stack.push_back(std::move(frame));
+        };
+
+        if (domInfo->isReachable(cfg->entry)) enter(cfg->entry);
+        while (!stack.empty())
+        {
+            Frame& top = stack.back();
+            if (top.child < tree[top.block].size())
+            {
+                enter(tree[top.block][top.child++]);
+                continue;
+            }
+            for (auto it = top.saved.rbegin(); it != top.saved.rend(); ++it) current[it->first] = it->second;
+            stack.pop_back();
+        }
+
+        for (auto& acc : pool)
+        {
+            if (acc->defining) acc->defining->users.push_back(acc.get());
+            if (!acc->isPhi()) continue;
+            std::sort(acc->incoming.begin(), acc->incoming.end(), [](auto& a, auto& b) { return a.first < b.first; });
+            for (auto& [pred, value] : acc->incoming) value->users.push_back(acc.get());
+        }
+    }
+
+    size_t MemorySSA::getClassOf(Operand* ptr) const
+    {
+        auto it = ptrClass.find(ptr);
+        return it == ptrClass.end() ? npos : it->second;
+    }
+
+    const std::vector<MemoryAccess*>& MemorySSA::getBlockAccesses(size_t block) const
+    {
+        static const std::vector<MemoryAccess*> none;
+        return block < blockAccesses.size() ? blockAccesses[block] : none;
+    }
+
+    MemoryAccess* MemorySSA::getMemoryAccess(Instruction* inst) const
+    {
+        auto it = instAccesses.find(inst);
+        return it == instAccesses.end() ? nullptr : it->second.front();
+    }
+
+    const std::vector<MemoryAccess*>& MemorySSA::getMemoryAccesses(Instruction* inst) const
+    {
+        static const std::vector<MemoryAccess*> none;
+        auto                                    it = instAccesses.find(inst);
+        return it == instAccesses.end() ? none : it->second;
+    }
+
+    MemoryAccess* MemorySSA::getClobberingAccess(Instruction* inst)
+    {
+        MemoryAccess* acc = getMemoryAccess(inst);
+        if (!acc) return nullptr;
+        if (inst->opcode == Operator::LOAD)
+            return getClobberingAccess(acc->defining, static_cast<LoadInst*>(inst)->ptr);
+        if (inst->opcode == Operator::STORE)
+            return getClobberingAccess(acc->defining, static_cast<StoreInst*>(inst)->ptr);
+        return acc->defining;
+    }
+
+    MemoryAccess* MemorySSA::getClobberingAccess(MemoryAccess* start, Operand* ptr)
+    {
+        for (MemoryAccess* acc = start;;)
+        {
+            if (acc->isLiveOnEntry()) return acc;
+            if (acc->isPhi()) return walkPhi(acc, ptr);
+            if (acc->isDef())
+            {
+                if (acc->inst->opcode == Operator::STORE)
+                {
+                    if (!aa->isNoAlias(static_cast<StoreInst*>(acc->inst)->ptr, ptr)) return acc;
+                }
+                else if (isModSet(aa->getModRef(*acc->inst, ptr)))
+                    return acc;
+            }
+            acc = acc->defining;
+        }
+    }
+
+    MemoryAccess* MemorySSA::walkPhi(MemoryAccess* phi, Operand* ptr)
+    {
+        auto key = std::make_pair(phi, ptr);
+        auto it  = clobberCache.find(key);
+        if (it != clobberCache.end()) return it->second;
+        // 绕回正在查找的 phi: 这条路径上除该 phi 之外没有 clobber
+        if (!inProgress.insert(key).second) return phi;
+
+        MemoryAccess* result = nullptr;
+        for (auto& [pred, value] : phi->incoming)
+        {
+            MemoryAccess* found = getClobberingAccess(value, ptr);
+            if (found == phi) continue;
+            if (!result)
+                result = found;
+            else if (result != found)
+            {
+                result = phi;
+                break;
+            }
+        }
+        inProgress.erase(key);
+
+        // 途经仍在查找中的 phi 时只会得到 phi 本身这样保守的结果，缓存是安全的
+        if (!result) result = phi;
+        return clobberCache[key] = result;
+    }
+
+    template <>
+    MemorySSA* Manager::get<MemorySSA>(Function& func)
+    {
+        if (auto* cached = getCached<MemorySSA>(func)) return cached;
+
+        registerDependency<MemorySSA, CFG>();
+        registerDependency<MemorySSA, DomInfo>();
+        registerDependency<MemorySSA, AliasAnalysis>();
+        auto* cfg     = get<CFG>(func);
+        auto* domInfo = get<DomInfo>(func);
+        auto* aa      = get<AliasAnalysis>(func);
+
+        auto* memorySSA = new MemorySSA();
+        memorySSA->build(*cfg, *domInfo, *aa);
+        return cache<MemorySSA>(func, memorySSA);
+    }
+}  // namespace ME::Analysis
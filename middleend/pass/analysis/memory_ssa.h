@@ -0,0 +1,120 @@
+#ifndef __MIDDLEEND_PASS_ANALYSIS_MEMORY_SSA_H__
+#define __MIDDLEEND_PASS_ANALYSIS_MEMORY_SSA_H__
+
+#include <middleend/pass/analysis/analysis_manager.h>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * Memory SSA
+ * - 通过 Analysis::AM.get<MemorySSA>(function) 获取，依赖 CFG、DomInfo 与 AliasAnalysis。
+ * - 访存按别名类划分: 各 load/store 指针的基对象 (alloca、全局变量、形参，来源未知的指针单独成员) 之间
+ *   若 AliasAnalysis::mayShareObject 成立则并入同一类。不同类之间的访存互不相关，各类分别构建 SSA。
+ * - load 为 MemoryUse，store 为 MemoryDef; call 在每个它可能写 (getModRef 含 Mod) 的类中为 MemoryDef，
+ *   只读的类中为 MemoryUse，因此一条 call 可能对应多个访问。函数入口处所有类共享一个 LiveOnEntry。
+ * - MemoryPhi 由 DomInfo::computeIDF 按各类的 MemoryDef 所在块放置，随后沿支配树重命名。
+ *   getBlockAccesses(block) 按程序顺序给出块内访问，phi 在最前。
+ * - getClobberingAccess 沿 defining 链向上，跳过与给定指针 NoAlias 的 store 和不写该位置的 call，
+ *   在 phi 处对各入边分别查找: 结果一致 (忽略绕回该 phi 自身的环) 时越过 phi，否则返回 phi。
+ *   查询结果按 (起点, 指针) 缓存，结果总是支配查询位置的 MemoryDef / MemoryPhi / LiveOnEntry。
+ * - 分析对象只应由处理该函数的线程使用; 修改了访存指令的 pass 不应保留 MemorySSA。
+ */
+
+namespace ME
+{
+    class Operand;
+    class Function;
+    class Instruction;
+}  // namespace ME
+
+namespace ME::Analysis
+{
+    class CFG;
+    class DomInfo;
+    class AliasAnalysis;
+
+    class MemoryAccess
+    {
+      public:
+        enum class Kind
+        {
+            LiveOnEntry,
+            Def,
+            Use,
+            Phi
+        };
+
+        Kind          kind;
+        size_t        id;
+        size_t        block    = 0;
+        size_t        cls      = 0;  // 别名类，LiveOnEntry 不属于任何类
+        Instruction*  inst     = nullptr;
+        MemoryAccess* defining = nullptr;                        // Def / Use
+        std::vector<std::pair<size_t, MemoryAccess*>> incoming;  // Phi: (前驱块, 值)，按块编号升序
+        std::vector<MemoryAccess*>                    users;
+
+      public:
+        bool isLiveOnEntry() const { return kind == Kind::LiveOnEntry; }
+        bool isDef() const { return kind == Kind::Def; }
+        bool isUse() const { return kind == Kind::Use; }
+        bool isPhi() const { return kind == Kind::Phi; }
+
+        std::string toString() const;
+    };
+
+    class MemorySSA
+    {
+      public:
+        static inline const size_t TID = getTID<MemorySSA>();
+
+      private:
+        CFG*                                                         cfg         = nullptr;
+        DomInfo*                                                     domInfo     = nullptr;
+        AliasAnalysis*                                               aa          = nullptr;
+        MemoryAccess*                                                liveOnEntry = nullptr;
+        size_t                                                       classCount  = 0;
+        std::vector<std::unique_ptr<MemoryAccess>>                   pool;
+        std::vector<std::vector<MemoryAccess*>>                      blockAccesses;
+        std::unordered_map<Instruction*, std::vector<MemoryAccess*>> instAccesses;
+        std::unordered_map<Operand*, size_t>                         ptrClass;
+
+        std::map<std::pair<MemoryAccess*, Operand*>, MemoryAccess*>  clobberCache;
+        std::set<std::pair<MemoryAccess*, Operand*>>                 inProgress;
+
+      public:
+        void build(CFG& cfg, DomInfo& domInfo, AliasAnalysis& aa);
+
+        MemoryAccess* getLiveOnEntry() const { return liveOnEntry; }
+        size_t        getClassCount() const { return classCount; }
+        // load/store 指针所属的别名类，不是 load/store 的指针时返回 npos
+        size_t getClassOf(Operand* ptr) const;
+
+        const std::vector<MemoryAccess*>& getBlockAccesses(size_t block) const;
+        // load/store 的唯一访问; call 返回它在各类中的访问
+        MemoryAccess*                     getMemoryAccess(Instruction* inst) const;
+        const std::vector<MemoryAccess*>& getMemoryAccesses(Instruction* inst) const;
+
+        // load 读到的值 / store 覆盖的值由哪个访问决定
+        MemoryAccess* getClobberingAccess(Instruction* inst);
+        // 从 start (含) 开始向上查找对 ptr 的 clobber
+        MemoryAccess* getClobberingAccess(MemoryAccess* start, Operand* ptr);
+
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
+      private:
+        MemoryAccess* create(MemoryAccess::Kind kind, size_t block, size_t cls, Instruction* inst);
+        void          rename();
+        MemoryAccess* walkPhi(MemoryAccess* phi, Operand* ptr);
+        // 划分别名类，返回各类包含的基对象
+        std::vector<std::vector<Operand*>> partition();
+    };
+
+    template <>
+    MemorySSA* Manager::get<MemorySSA>(Function& func);
+}  // namespace ME::Analysis
+
+#endif  // __MIDDLEEND_PASS_ANALYSIS_MEMORY_SSA_H__
@@ -0,0 +1,112 @@
+#include <middleend/pass/analysis/postdominfo.h>
+#include <algorithm>
+
+namespace ME::Analysis
+{
+    PostDomInfo::PostDomInfo() : domAnalyzer(new DomAnalyzer()) {}
+
+    PostDomInfo::~PostDomInfo() { delete domAnalyzer; }
+
+    void PostDomInfo::build(CFG& cfg)
+    {
+        this->cfg = &cfg;
+        domAnalyzer->clear();
+        roots.clear();
+        dfsIn.assign(cfg.size(), -1);
+        dfsOut.assign(cfg.size(), -1);
+        if (cfg.size() == 0) return;
+
+        // 只保留两端都从入口可达的边
+        const std::vector<size_t>&    postOrder = cfg.getPostOrder();
+        std::vector<std::vector<int>> graph(cfg.size());
+        for (size_t block : postOrder)
+            for (size_t succ : cfg.succs(block))
+                if (cfg.getRPOIndex(succ) != CFG::npos) graph[block].push_back((int)succ);
+
+        // 先从真实出口出发反向搜索，再按后序为剩余 (无法退出的) 块补充根
+        std::vector<bool>   reached(cfg.size(), false);
+        std::vector<size_t> worklist;
+        auto                addRoot = [&](size_t root) {
+            roots.push_back(root);
+            reached[root] = true;
+            worklist.push_back(root);
+            while (!worklist.empty())
+            {
+                size_t block = worklist.back();
+                worklist.pop_back();
+                for (size_t pred : cfg.preds(block))
+                {
+                    if (reached[pred] || cfg.getRPOIndex(pred) == CFG::npos) continue;
+                    reached[pred] = true;
+                    worklist.push_back(pred);
+                }
+            }
+        };
+        for (size_t block : postOrder)
+            if (graph[block].empty()) addRoot(block);
+        for (size_t block : postOrder)
+            if (!reached[block]) addRoot(block);
+        std::sort(roots.begin(), roots.end());
+
+        std::vector<int> exitPoints(roots.begin(), roots.end());
+        domAnalyzer->solve(graph, exitPoints, true);
+
+        // 后支配树上的 DFS 进出序号; 只被虚拟出口后支配的块 (imm_dom 为自身) 视为虚拟出口的孩子
+        const auto&                         tree    = domAnalyzer->dom_tree;
+        const auto&                         ipdom   = domAnalyzer->imm_dom;
+        int                                 counter = 0;
+        std::vector<std::pair<int, size_t>> stack;
+        for (size_t root = 0; root < ipdom.size(); ++root)
+        {
+            if ((size_t)ipdom[root] != root) continue;
+            dfsIn[root] = counter++;
+            stack.push_back({(int)root, 0});
+            while (!stack.empty())
+            {
+                int node = stack.back().first;
+                if (stack.back().second < tree[node].size())
+                {
+                    int child    = tree[node][stack.back().second++];
+                    dfsIn[child] = counter++;
+                    stack.push_back({child, 0});
+                    continue;
+                }
+                dfsOut[node] = counter++;
+                stack.pop_back();
+            }
+        }
+    }
+
+    bool PostDomInfo::isRoot(size_t block) const { return std::binary_search(roots.begin(), roots.end(), block); }
+
+    bool PostDomInfo::postDominates(size_t a, size_t b) const
+    {
+        if (!isReachable(a) || !isReachable(b)) return false;
+        return dfsIn[a] <= dfsIn[b] && dfsOut[b] <= dfsOut[a];
+    }
+
+    size_t PostDomInfo::findNearestCommonPostDominator(size_t a, size_t b) const
+    {
+        if (!isReachable(a) || !isReachable(b)) return CFG::npos;
+        auto& ipdom = domAnalyzer->imm_dom;
+        while (!postDominates(a, b))
+        {
+            if ((size_t)ipdom[a] == a) return CFG::npos;
+            a = ipdom[a];
+        }
+        return a;
+    }
+
+    template <>
+    PostDomInfo* Manager::get<PostDomInfo>(Function& func)
+    {
+        if (auto* cached = getCached<PostDomInfo>(func)) return cached;
+
+        registerDependency<PostDomInfo, CFG>();
+        auto* cfg = get<CFG>(func);
+
+        auto* postDomInfo = new PostDomInfo();
+        postDomInfo->build(*cfg);
+        return cache<PostDomInfo>(func, postDomInfo);
+    }
+}  // namespace ME::Analysis
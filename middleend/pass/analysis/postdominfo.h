@@ -0,0 +1,65 @@
+#ifndef __MIDDLEEND_PASS_ANALYSIS_POSTDOMINFO_H__
+#define __MIDDLEEND_PASS_ANALYSIS_POSTDOMINFO_H__
+
+#include <middleend/pass/analysis/analysis_manager.h>
+#include <middleend/pass/analysis/cfg.h>
+#include <dom_analyzer.h>
+
+/*
+ * 后支配信息
+ * - 通过 Analysis::AM.get<PostDomInfo>(function) 获取，依赖 CFG。只考虑从入口可达的块。
+ * - 后支配树的根是一个虚拟出口，连向虚拟出口的块 (roots) 为:
+ *   1) 所有没有后继的块 (ret 所在的块，允许有多个);
+ *   2) 无法到达任何出口的块 (死循环): 按正向后序扫描，遇到仍未被反向搜索覆盖的块时把它作为新的根，
+ *      因此每个无法退出的区域只引入一个根，且根位于区域内较 "靠后" 的位置 (通常是回边的来源)。
+ *   等价于给这些根添加一条通向虚拟出口的边后在反图上求支配树。
+ * - getImmPostDom() 中只被虚拟出口后支配的块 (包括所有根，以及分支分别通向不同根的块) 的直接后支配者为其自身，
+ *   从入口不可达的块为 -1;
+ *   getPostDomFrontier() 为各块的后支配边界 (按块编号升序)，即控制依赖的来源。
+ * - postDominates 借助后支配树上的 DFS 进出序号以 O(1) 回答; 不可达的块不参与任何后支配关系。
+ */
+
+namespace ME::Analysis
+{
+    class PostDomInfo
+    {
+      public:
+        static inline const size_t TID = getTID<PostDomInfo>();
+
+        DomAnalyzer* domAnalyzer;
+
+      private:
+        CFG*                cfg = nullptr;
+        std::vector<size_t> roots;
+        std::vector<int>    dfsIn;
+        std::vector<int>    dfsOut;
+
+      public:
+        PostDomInfo();
+        ~PostDomInfo();
+        PostDomInfo(const PostDomInfo&)            = delete;
+        PostDomInfo& operator=(const PostDomInfo&) = delete;
+
+        void build(CFG& cfg);
+
+        const std::vector<std::vector<int>>& getPostDomTree() const { return domAnalyzer->dom_tree; }
+        const std::vector<std::vector<int>>& getPostDomFrontier() const { return domAnalyzer->dom_frontier; }
+        const std::vector<int>&              getImmPostDom() const { return domAnalyzer->imm_dom; }
+
+        // 连向虚拟出口的块，按块编号升序
+        const std::vector<size_t>& getRoots() const { return roots; }
+        bool                       isRoot(size_t block) const;
+        bool isReachable(size_t block) const { return block < dfsIn.size() && dfsIn[block] >= 0; }
+
+        bool postDominates(size_t a, size_t b) const;
+        bool properlyPostDominates(size_t a, size_t b) const { return a != b && postDominates(a, b); }
+
+        // 两个块在后支配树上的最近公共祖先，只有虚拟出口同时后支配两者时返回 CFG::npos
+        size_t findNearestCommonPostDominator(size_t a, size_t b) const;
+    };
+
+    template <>
+    PostDomInfo* Manager::get<PostDomInfo>(Function& func);
+}  // namespace ME::Analysis
+
+#endif  // __MIDDLEEND_PASS_ANALYSIS_POSTDOMINFO_H__
@@ -0,0 +1,429 @@
+#include <middleend/pass/analysis/range_analysis.h>
+#include <middleend/pass/analysis/cfg.h>
+#include <middleend/pass/analysis/dominfo.h>
+#include <middleend/module/ir_function.h>
+#include <middleend/module/ir_block.h>
+#include <middleend/module/ir_instruction.h>
+#include <middleend/module/ir_operand.h>
+#include <middleend/module/ir_utils.h>
+#include <middleend/visitor/utils/operand_visitor.h>
+#include <algorithm>
+#include <climits>
+#include <initializer_list>
+
+namespace ME::Analysis
+{
+    namespace
+    {
+        // phi 连续增长超过该次数后对其做 widening
+        constexpr size_t wideningThreshold = 3;
+        constexpr size_t narrowingSweeps   = 2;
+
+        const ConstantRange fullI32 = {INT_MIN, INT_MAX};
+
+        // 超出 i32 表示范围时结果可能回绕，只能取满区间
+        ConstantRange make(long long lo, long long hi)
+        {
+            if (lo < INT_MIN || hi > INT_MAX) return fullI32;
+            return {lo, hi};
+        }
+
+        ConstantRange corners(long long a0, long long a1, long long b0, long long b1, long long (*op)(long long, long long))
+        {
+            long long lo = LLONG_MAX, hi = LLONG_MIN;
+            for (long long a : {a0, a1})
+                for (long long b : {b0, b1})
+                {
+                    long long v = op(a, b);
+                    lo          = std::min(lo, v);
+                    hi          = std::max(hi, v);
+                }
+            return make(lo, hi);
+        }
+
+        DataType resultType(Instruction* inst)
+        {
+            switch (inst->opcode)
+            {
+                case Operator::ICMP:
+                case Operator::FCMP: return DataType::I1;
+                case Operator::PHI: return static_cast<PhiInst*>(inst)->dt;
+                case Operator::ZEXT: return static_cast<ZextInst*>(inst)->to;
+                case Operator::LOAD: return static_cast<LoadInst*>(inst)->dt;
+                case Operator::CALL: return static_cast<CallInst*>(inst)->retType;
+                case Operator::FPTOSI: return DataType::I32;
+                case Operator::ADD:
+                case Operator::SUB:
+                case Operator::MUL:
+                case Operator::DIV:
+                case Operator::MOD:
+                case Operator::SHL:
+                case Operator::ASHR:
+                case Operator::LSHR:
+                case Operator::BITAND:
+                case Operator::BITXOR: return static_cast<ArithmeticInst*>(inst)->dt;
+                default: return DataType::UNK;
+            }
+        }
+
+        bool isTracked(DataType type) { return type == DataType::I32 || type == DataType::I1; }
+
+        ConstantRange sdivRange(const ConstantRange& a, const ConstantRange& b)
+        {
+            auto div = [](long long x, long long y) { return x / y; };
+            ConstantRange result = ConstantRange::empty();
+            if (b.lo < 0) result = result.unite(corners(a.lo, a.hi, b.lo, std::min(b.hi, -1LL), div));
+            if (b.hi > 0) result = result.unite(corners(a.lo, a.hi, std::max(b.lo, 1LL), b.hi, div));
+            return result;
+        }
+
+        ConstantRange sremRange(const ConstantRange& a, const ConstantRange& b)
+        {
+            // 结果的符号与被除数相同，绝对值小于除数的绝对值
+            long long maxAbs = std::max(std::llabs(b.lo), std::llabs(b.hi));
+            long long minAbs = b.contains(0) ? 1 : std::min(std::llabs(b.lo), std::llabs(b.hi));
+            if (maxAbs == 0) return ConstantRange::empty();
+            if (a.lo > -minAbs && a.hi < minAbs) return a;
+            long long lo = a.lo >= 0 ? 0 : std::max(a.lo, -(maxAbs - 1));
+            long long hi = a.hi <= 0 ? 0 : std::min(a.hi, maxAbs - 1);
+            return {lo, hi};
+        }
+
+        ConstantRange bitRange(Operator op, const ConstantRange& a, const ConstantRange& b, DataType type)
+        {
+            if (type == DataType::I1) return {0, 1};
+            if (op == Operator::BITAND)
+            {
+                if (a.lo >= 0 && b.lo >= 0) return {0, std::min(a.hi, b.hi)};
+                if (a.lo >= 0) return {0, a.hi};
+                if (b.lo >= 0) return {0, b.hi};
+                return fullI32;
+            }
+            if (a.lo < 0 || b.lo < 0) return fullI32;
+            long long mask = 1;
+            while (mask <= std::max(a.hi, b.hi)) mask <<= 1;
+            return {0, mask - 1};
+        }
+
+        long long foldBinary(Operator op, long long a, long long b, bool& ok)
+        {
+            ok = true;
+            switch (op)
+            {
+                case Operator::ADD: return a + b;
+                case Operator::SUB: return a - b;
+                case Operator::MUL: return a * b;
+                case Operator::DIV:
+                case Operator::MOD:
+                    if (b == 0 || (a == INT_MIN && b == -1)) break;
+                    return op == Operator::DIV ? a / b : a % b;
+                case Operator::SHL:
+                    if (b < 0 || b > 31) break;
+                    return static_cast<int>(static_cast<unsigned>(a) << b);
+                case Operator::ASHR:
+                    if (b < 0 || b > 31) break;
+                    return a >> b;
+                case Operator::LSHR:
+                    if (b < 0 || b > 31) break;
+                    return static_cast<int>(static_cast<unsigned>(a) >> b);
+                case Operator::BITAND: return a & b;
+                case Operator::BITXOR: return a ^ b;
+                default: break;
+            }
+            ok = false;
+            return 0;
+        }
+
+        // 由两侧区间判定 a pred b: 1 恒真，0 恒假，-1 无法判定
+        int decideCompare(ICmpOp pred, const ConstantRange& a, const ConstantRange& b)
+        {
+            // 两侧都非负时无符号比较与有符号比较一致
+            bool nonNeg = a.lo >= 0 && b.lo >= 0;
+            switch (pred)
+            {
+                case ICmpOp::EQ:
+                    if (a.isSingle() && b.isSingle() && a.lo == b.lo) return 1;
+                    if (a.intersect(b).isEmpty()) return 0;
+                    return -1;
+                case ICmpOp::NE:
+                    if (a.isSingle() && b.isSingle() && a.lo == b.lo) return 0;
+                    if (a.intersect(b).isEmpty()) return 1;
+                    return -1;
+                case ICmpOp::ULT:
+                    if (!nonNeg) return -1;
+                    [[fallthrough]];
+                case ICmpOp::SLT: return a.hi < b.lo ? 1 : (a.lo >= b.hi ? 0 : -1);
+                case ICmpOp::ULE:
+                    if (!nonNeg) return -1;
+                    [[fallthrough]];
+                case ICmpOp::SLE: return a.hi <= b.lo ? 1 : (a.lo > b.hi ? 0 : -1);
+                case ICmpOp::UGT:
+                    if (!nonNeg) return -1;
+                    [[fallthrough]];
+                case ICmpOp::SGT: return a.lo > b.hi ? 1 : (a.hi <= b.lo ? 0 : -1);
+                case ICmpOp::UGE:
+                    if (!nonNeg) return -1;
+                    [[fallthrough]];
+                case ICmpOp::SGE: return a.lo >= b.hi ? 1 : (a.hi < b.lo ? 0 : -1);
+                default: return -1;
+            }
+        }
+
+        // 满足 x pred other 的 x 的取值范围
+        ConstantRange constrain(ICmpOp pred, const ConstantRange& other)
+        {
+            if (other.isEmpty()) return ConstantRange::empty();
+            switch (pred)
+            {
+                case ICmpOp::EQ: return other;
+                case ICmpOp::SLT: return {INT_MIN, other.hi - 1};
+                case ICmpOp::SLE: return {INT_MIN, other.hi};
+                case ICmpOp::SGT: return {other.lo + 1, INT_MAX};
+                case ICmpOp::SGE: return {other.lo, INT_MAX};
+                // other 非负时 x <u other 意味着 0 <= x < other
+                case ICmpOp::ULT: return other.lo >= 0 ? ConstantRange{0, other.hi - 1} : fullI32;
+                case ICmpOp::ULE: return other.lo >= 0 ? ConstantRange{0, other.hi} : fullI32;
+                default: return fullI32;
+            }
+        }
+    }  // namespace
+
+    ConstantRange ConstantRange::full(DataType type)
+    {
+        if (type == DataType::I1) return {0, 1};
+        return fullI32;
+    }
+
+    ConstantRange ConstantRange::unite(const ConstantRange& other) const
+    {
+        if (isEmpty()) return other;
+        if (other.isEmpty()) return *this;
+        return {std::min(lo, other.lo), std::max(hi, other.hi)};
+    }
+
+    ConstantRange ConstantRange::intersect(const ConstantRange& other) const
+    {
+        if (isEmpty() || other.isEmpty()) return empty();
+        ConstantRange result = {std::max(lo, other.lo), std::min(hi, other.hi)};
+        return result.isEmpty() ? empty() : result;
+    }
+
+    void RangeAnalysis::build(CFG& cfg, DomInfo& domInfo)
+    {
+        this->cfg     = &cfg;
+        this->domInfo = &domInfo;
+        defs.clear();
+        defBlock.clear();
+        ranges.clear();
+
+        // 可达块中的跟踪值从空区间开始
+        std::vector<std::pair<Instruction*, size_t>> order;
+        for (size_t id : cfg.getRPO())
+            for (auto* inst : cfg.getBlock(id)->insts)
+            {
+                Operand* def = getDefOperand(*inst);
+                if (!def) continue;
+                defs[def]     = inst;
+                defBlock[def] = id;
+                if (!isTracked(resultType(inst))) continue;
+                ranges[def] = ConstantRange::empty();
+                order.push_back({inst, id});
+            }
+
+        std::unordered_map<Operand*, size_t> updates;
+        for (bool changed = true; changed;)
+        {
+            changed = false;
+            for (auto [inst, block] : order)
+            {
+                Operand*      def    = getDefOperand(*inst);
+                ConstantRange old    = ranges[def];
+                ConstantRange merged = old.unite(evaluate(inst, block));
+                if (merged == old) continue;
+
+                if (inst->opcode == Operator::PHI && !old.isEmpty() && ++updates[def] > wideningThreshold)
+                {
+                    ConstantRange bound = ConstantRange::full(resultType(inst));
+                    if (merged.lo < old.lo) merged.lo = bound.lo;
+                    if (merged.hi > old.hi) merged.hi = bound.hi;
+                }
+                ranges[def] = merged;
+                changed     = true;
+            }
+        }
+
+        // 从不动点出发的下降迭代仍是安全的近似
+        for (size_t sweep = 0; sweep < narrowingSweeps; ++sweep)
+            for (auto [inst, block] : order)
+            {
+                Operand* def = getDefOperand(*inst);
+                ranges[def]  = ranges[def].intersect(evaluate(inst, block));
+            }
+    }
+
+    ConstantRange RangeAnalysis::getRange(Operand* value) const
+    {
+        if (value->getType() == OperandType::IMMEI32)
+            return ConstantRange::single(static_cast<ImmeI32Operand*>(value)->value);
+        auto it = ranges.find(value);
+        if (it != ranges.end()) return it->second;
+        auto def = defs.find(value);
+        return ConstantRange::full(def == defs.end() ? DataType::I32 : resultType(def->second));
+    }
+
+    ConstantRange RangeAnalysis::getRangeAt(Operand* value, size_t block) const
+    {
+        ConstantRange range = getRange(value);
+        if (!domInfo->isReachable(block)) return range;
+
+        // 沿支配树向上，块只有唯一前驱时进入它的边上的条件成立; 到达定义所在块后上方的条件与 value 无关。
+        // 常数同样要检查: 途经的边不可行时结果为空区间
+        auto   def  = defBlock.find(value);
+        size_t stop = def == defBlock.end() ? cfg->entry : def->second;
+        const auto& idom = domInfo->getImmDom();
+        for (size_t x = block; x != stop && x != cfg->entry; x = idom[x])
+        {
+            if (cfg->preds(x).size() == 1) refineOnEdge(range, value, cfg->preds(x)[0], x);
+            if (range.isEmpty()) break;
+        }
+        return range;
+    }
+
+    ConstantRange RangeAnalysis::getEdgeRange(Operand* value, size_t from, size_t to) const
+    {
+        ConstantRange range = getRangeAt(value, from);
+        refineOnEdge(range, value, from, to);
+        return range;
+    }
+
+    void RangeAnalysis::refineOnEdge(ConstantRange& range, Operand* value, size_t from, size_t to) const
+    {
+        Instruction* term = CFG::getTerminator(cfg->getBlock(from));
+        if (!term || term->opcode != Operator::BR_COND) return;
+        auto*  br      = static_cast<BrCondInst*>(term);
+        size_t trueId  = labelOf(br->trueTar);
+        size_t falseId = labelOf(br->falseTar);
+        if (trueId == falseId) return;
+        bool onTrue = to == trueId;
+
+        if (br->cond == value)
+        {
+            range = range.intersect(ConstantRange::single(onTrue ? 1 : 0));
+            return;
+        }
+
+        auto it = defs.find(br->cond);
+        if (it == defs.end() || it->second->opcode != Operator::ICMP) return;
+        auto* cmp = static_cast<IcmpInst*>(it->second);
+        if (cmp->dt != DataType::I32 || cmp->lhs == cmp->rhs) return;
+
+        ICmpOp pred = onTrue ? cmp->cond : invertPredicate(cmp->cond);
+        if (cmp->lhs == value)
+            range = range.intersect(constrain(pred, getRange(cmp->rhs)));
+        else if (cmp->rhs == value)
+            range = range.intersect(constrain(swapPredicate(pred), getRange(cmp->lhs)));
+        else
+        {
+            // 与 value 无关的条件若必然与这条边矛盾，这条边不可行
+            int known = decideCompare(cmp->cond, getRange(cmp->lhs), getRange(cmp->rhs));
+            if (known != -1 && (known == 1) != onTrue) range = ConstantRange::empty();
+        }
+    }
+
+    ConstantRange RangeAnalysis::evaluate(Instruction* inst, size_t block) const
+    {
+        DataType type = resultType(inst);
+        switch (inst->opcode)
+        {
+            case Operator::PHI:
+            {
+                ConstantRange result = ConstantRange::empty();
+                for (auto& [label, val] : static_cast<PhiInst*>(inst)->incomingVals)
+                {
+                    size_t pred = labelOf(label);
+                    if (!domInfo->isReachable(pred)) continue;
+                    result = result.unite(getEdgeRange(val, pred, block));
+                }
+                return result;
+            }
+            case Operator::ICMP:
+            {
+                auto*         cmp = static_cast<IcmpInst*>(inst);
+                ConstantRange a   = getRangeAt(cmp->lhs, block);
+                ConstantRange b   = getRangeAt(cmp->rhs, block);
+                if (a.isEmpty() || b.isEmpty()) return ConstantRange::empty();
+                if (cmp->dt != DataType::I32) return {0, 1};
+                int known = decideCompare(cmp->cond, a, b);
+                return known == -1 ? ConstantRange{0, 1} : ConstantRange::single(known);
+            }
+            case Operator::ZEXT:
+            {
+                auto* zext = static_cast<ZextInst*>(inst);
+                if (zext->from != DataType::I1) return ConstantRange::full(type);
+                return getRangeAt(zext->src, block);
+            }
+            case Operator::ADD:
+            case Operator::SUB:
+            case Operator::MUL:
+            case Operator::DIV:
+            case Operator::MOD:
+            case Operator::SHL:
+            case Operator::ASHR:
+            case Operator::LSHR:
+            case Operator::BITAND:
+            case Operator::BITXOR: break;
+            default: return ConstantRange::full(type);
+        }
+
+        auto*         arith = static_cast<ArithmeticInst*>(inst);
+        ConstantRange a     = getRangeAt(arith->lhs, block);
+        ConstantRange b     = getRangeAt(arith->rhs, block);
+        if (a.isEmpty() || b.isEmpty()) return ConstantRange::empty();
+
+        if (a.isSingle() && b.isSingle())
+        {
+            bool      ok;
+            long long v = foldBinary(inst->opcode, a.lo, b.lo, ok);
+            if (!ok) return ConstantRange::full(type);
+            if (type == DataType::I1) return ConstantRange::single(v & 1);
+            return make(v, v);
+        }
+        if (type == DataType::I1) return bitRange(inst->opcode, a, b, type);
+
+        switch (inst->opcode)
+        {
+            case Operator::ADD: return make(a.lo + b.lo, a.hi + b.hi);
+            case Operator::SUB: return make(a.lo - b.hi, a.hi - b.lo);
+            case Operator::MUL: return corners(a.lo, a.hi, b.lo, b.hi, [](long long x, long long y) { return x * y; });
+            case Operator::DIV: return sdivRange(a, b);
+            case Operator::MOD: return sremRange(a, b);
+            case Operator::SHL:
+                if (b.lo < 0 || b.hi > 30) return fullI32;
+                return corners(a.lo, a.hi, b.lo, b.hi, [](long long x, long long y) { return x * (1LL << y); });
+            case Operator::ASHR:
+                if (b.lo < 0 || b.hi > 31) return fullI32;
+                return corners(a.lo, a.hi, b.lo, b.hi, [](long long x, long long y) { return x >> y; });
+            case Operator::LSHR:
+                if (b.lo < 0 || b.hi > 31) return fullI32;
+                if (a.lo >= 0) return corners(a.lo, a.hi, b.lo, b.hi, [](long long x, long long y) { return x >> y; });
+                if (b.lo == 0) return fullI32;
+                return {0, static_cast<long long>(UINT_MAX >> b.lo)};
+            default: return bitRange(inst->opcode, a, b, type);
+        }
+    }
+
+    template <>
+    RangeAnalysis* Manager::get<RangeAnalysis>(Function& func)
+    {
+        if (auto* cached = getCached<RangeAnalysis>(func)) return cached;
+
+        registerDependency<RangeAnalysis, CFG>();
+        registerDependency<RangeAnalysis, DomInfo>();
+        auto* cfg     = get<CFG>(func);
+        auto* domInfo = get<DomInfo>(func);
+
+        auto* rangeAnalysis = new RangeAnalysis();
+        rangeAnalysis->build(*cfg, *domInfo);
+        return cache<RangeAnalysis>(func, rangeAnalysis);
+    }
+}  // namespace ME::Analysis
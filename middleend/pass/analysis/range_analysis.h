@@ -0,0 +1,91 @@
+#ifndef __MIDDLEEND_PASS_ANALYSIS_RANGE_ANALYSIS_H__
+#define __MIDDLEEND_PASS_ANALYSIS_RANGE_ANALYSIS_H__
+
+#include <middleend/pass/analysis/analysis_manager.h>
+#include <interfaces/middleend/ir_defs.h>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * 整数值域分析
+ * - 通过 Analysis::AM.get<RangeAnalysis>(function) 获取，依赖 CFG 与 DomInfo。
+ * - 为每个 i32 / i1 的 SSA 值计算一个有符号闭区间 [lo, hi] (i1 取 0/1)。稀疏地在 SSA 值上迭代:
+ *   add/sub/mul/shl/ashr/lshr/sdiv/srem/and/xor 按区间运算，结果可能回绕时取满区间;
+ *   icmp 在两侧区间可以判定时为常数; phi 为各条可行入边上值域的并; load/call 等为满区间。
+ * - 分支条件: 块 B 只有唯一前驱 P 且 P 以 icmp 结果做条件跳转时，沿 P->B 这条边的比较结果已知，
+ *   getRangeAt(v, B) 沿支配树向上收集这类边，用比较另一侧的值域收窄 v。phi 的入边同样按边上的条件收窄，
+ *   条件必然不成立的入边不计入 phi。
+ * - 先自底 (空区间) 向上迭代，phi 更新若干次后仍在增长的一端直接扩大到类型边界 (widening);
+ *   到达不动点后再按逆后序做两轮收窄 (narrowing)，找回被 widening 放宽、被分支条件限制住的上下界。
+ * - 不可达块中定义的值与未跟踪的操作数 (形参、全局变量等) 视为满区间; 只在不可达路径上取值的值为空区间。
+ */
+
+namespace ME
+{
+    class Operand;
+    class Function;
+    class Instruction;
+}  // namespace ME
+
+namespace ME::Analysis
+{
+    class CFG;
+    class DomInfo;
+
+    struct ConstantRange
+    {
+        long long lo = 1;
+        long long hi = 0;  // lo > hi 表示空区间
+
+        static ConstantRange full(DataType type);
+        static ConstantRange single(long long value) { return {value, value}; }
+        static ConstantRange empty() { return {}; }
+
+        bool      isEmpty() const { return lo > hi; }
+        bool      isSingle() const { return lo == hi; }
+        bool      contains(long long value) const { return lo <= value && value <= hi; }
+        bool      isNonNegative() const { return !isEmpty() && lo >= 0; }
+        long long getSingle() const { return lo; }
+
+        ConstantRange unite(const ConstantRange& other) const;
+        ConstantRange intersect(const ConstantRange& other) const;
+
+        bool operator==(const ConstantRange& other) const
+        {
+            return (isEmpty() && other.isEmpty()) || (lo == other.lo && hi == other.hi);
+        }
+        bool operator!=(const ConstantRange& other) const { return !(*this == other); }
+    };
+
+    class RangeAnalysis
+    {
+      public:
+        static inline const size_t TID = getTID<RangeAnalysis>();
+
+      private:
+        CFG*                                        cfg     = nullptr;
+        DomInfo*                                    domInfo = nullptr;
+        std::unordered_map<Operand*, Instruction*>  defs;
+        std::unordered_map<Operand*, size_t>        defBlock;
+        std::unordered_map<Operand*, ConstantRange> ranges;
+
+      public:
+        void build(CFG& cfg, DomInfo& domInfo);
+
+        // 与位置无关的值域
+        ConstantRange getRange(Operand* value) const;
+        // 在块 block 中使用 value 时的值域 (考虑支配 block 的分支条件)
+        ConstantRange getRangeAt(Operand* value, size_t block) const;
+        // 沿边 from->to 传递时的值域
+        ConstantRange getEdgeRange(Operand* value, size_t from, size_t to) const;
+
+      private:
+        void          refineOnEdge(ConstantRange& range, Operand* value, size_t from, size_t to) const;
+        ConstantRange evaluate(Instruction* inst, size_t block) const;
+    };
+
+    template <>
+    RangeAnalysis* Manager::get<RangeAnalysis>(Function& func);
+}  // namespace ME::Analysis
+
+#endif  // __MIDDLEEND_PASS_ANALYSIS_RANGE_ANALYSIS_H__
@@ -0,0 +1,86 @@
+#include <middleend/pass/analysis/reaching_defs.h>
+#include <middleend/pass/analysis/cfg.h>
+#include <middleend/module/ir_function.h>
+#include <middleend/module/ir_block.h>
+#include <middleend/module/ir_instruction.h>
+
+namespace ME::Analysis
+{
+    namespace
+    {
+        struct ReachingDefsProblem : BitVectorProblem<Direction::Forward, MeetOp::Union>
+        {
+            const char* name() const { return "reaching-defs"; }
+        };
+    }  // namespace
+
+    void ReachingDefinitions::build(CFG& cfg)
+    {
+        size_t blockCount = cfg.size();
+
+        defs.clear();
+        defsByPointer.clear();
+        defBlock.clear();
+        for (size_t id = 0; id < blockCount; ++id)
+        {
+            Block* block = cfg.getBlock(id);
+            if (!block) continue;
+            for (auto* inst : block->insts)
+            {
+                if (inst->opcode != Operator::STORE) continue;
+                auto* store = static_cast<StoreInst*>(inst);
+                defsByPointer[store->ptr].push_back(defs.size());
+                defBlock.push_back(id);
+                defs.push_back(store);
+            }
+        }
+
+        ReachingDefsProblem problem;
+        problem.init(blockCount, defs.size());
+        for (auto& [ptr, group] : defsByPointer)
+        {
+            // 块内写入同一地址的最后一个 store 生成定值，块内的每个 store 都杀死同组的全部定值
+            for (size_t i = 0; i < group.size(); ++i)
+            {
+                size_t def   = group[i];
+                size_t block = defBlock[def];
+                if (i + 1 == group.size() || defBlock[group[i + 1]] != block) problem.gen[block].set(def);
+                if (i == 0 || defBlock[group[i - 1]] != block)
+                    for (size_t other : group) problem.kill[block].set(other);
+            }
+        }
+
+        auto result = DataflowSolver<ReachingDefsProblem>::solve(cfg, problem);
+        reachIn     = std::move(result.in);
+        reachOut    = std::move(result.out);
+        stats       = result.stats;
+    }
+
+    const std::vector<size_t>& ReachingDefinitions::getDefsOf(Operand* ptr) const
+    {
+        static const std::vector<size_t> none;
+        auto                             it = defsByPointer.find(ptr);
+        return it == defsByPointer.end() ? none : it->second;
+    }
+
+    std::vector<StoreInst*> ReachingDefinitions::getReachingStores(size_t block, Operand* ptr) const
+    {
+        std::vector<StoreInst*> result;
+        for (size_t def : getDefsOf(ptr))
+            if (reachIn[block].test(def)) result.push_back(defs[def]);
+        return result;
+    }
+
+    template <>
+    ReachingDefinitions* Manager::get<ReachingDefinitions>(Function& func)
+    {
+        if (auto* cached = getCached<ReachingDefinitions>(func)) return cached;
+
+        registerDependency<ReachingDefinitions, CFG>();
+        auto* cfg = get<CFG>(func);
+
+        auto* reaching = new ReachingDefinitions();
+        reaching->build(*cfg);
+        return cache<ReachingDefinitions>(func, reaching);
+    }
+}  // namespace ME::Analysis
@@ -0,0 +1,54 @@
+#ifndef __MIDDLEEND_PASS_ANALYSIS_REACHING_DEFS_H__
+#define __MIDDLEEND_PASS_ANALYSIS_REACHING_DEFS_H__
+
+#include <middleend/pass/analysis/analysis_manager.h>
+#include <middleend/pass/analysis/dataflow.h>
+#include <dynamic_bitset.h>
+#include <map>
+
+/*
+ * 到达定值分析
+ * - 通过 Analysis::AM.get<ReachingDefinitions>(function) 获取，依赖 CFG。
+ * - SSA 形式下每个虚拟寄存器只有唯一的定值，因此这里跟踪的 "定值" 是对内存的写入，即 store 指令。
+ *   defs 按块编号、块内顺序为 store 编号，reachIn/reachOut 的第 i 位对应 defs[i]。
+ * - store 只杀死写入同一地址操作数的其他 store; 不同的地址操作数可能指向同一内存，
+ *   因此结果是 "可能到达" 的上近似。call 不杀死任何定值。
+ */
+
+namespace ME
+{
+    class Operand;
+    class StoreInst;
+}  // namespace ME
+
+namespace ME::Analysis
+{
+    class ReachingDefinitions
+    {
+      public:
+        static inline const size_t TID = getTID<ReachingDefinitions>();
+
+        std::vector<StoreInst*>           defs;
+        std::vector<Cele::dynamic_bitset> reachIn;   // 以块编号为下标
+        std::vector<Cele::dynamic_bitset> reachOut;  // 以块编号为下标
+        DataflowStats                     stats;
+
+      private:
+        std::map<Operand*, std::vector<size_t>> defsByPointer;
+        std::vector<size_t>                     defBlock;
+
+      public:
+        void build(CFG& cfg);
+
+        // 写入 ptr 的所有 store 的编号 (升序)
+        const std::vector<size_t>& getDefsOf(Operand* ptr) const;
+        size_t                     getDefBlock(size_t def) const { return defBlock[def]; }
+        // 到达 block 入口、写入 ptr 的 store
+        std::vector<StoreInst*> getReachingStores(size_t block, Operand* ptr) const;
+    };
+
+    template <>
+    ReachingDefinitions* Manager::get<ReachingDefinitions>(Function& func);
+}  // namespace ME::Analysis
+
+#endif  // __MIDDLEEND_PASS_ANALYSIS_REACHING_DEFS_H__
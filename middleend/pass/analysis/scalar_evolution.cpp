@@ -0,0 +1,528 @@
+#include <middleend/pass/analysis/scalar_evolution.h>
+#include <middleend/pass/analysis/cfg.h>
+#include <middleend/pass/analysis/loop_info.h>
+#include <middleend/module/ir_function.h>
+#include <middleend/module/ir_block.h>
+#include <middleend/module/ir_instruction.h>
+#include <middleend/module/ir_operand.h>
+#include <middleend/module/ir_utils.h>
+#include <middleend/visitor/utils/operand_visitor.h>
+#include <algorithm>
+#include <climits>
+#include <tuple>
+
+namespace ME::Analysis
+{
+    namespace
+    {
+        bool byId(const SCEV* a, const SCEV* b) { return a->id < b->id; }
+    }  // namespace
+
+    std::string SCEV::toString() const
+    {
+        switch (kind)
+        {
+            case Kind::Constant: return std::to_string(constant);
+            case Kind::Unknown: return value->toString();
+            case Kind::Add:
+            case Kind::Mul:
+            {
+                std::string text = "(";
+                for (size_t i = 0; i < ops.size(); ++i)
+                    text += (i ? (kind == Kind::Add ? " + " : " * ") : "") + ops[i]->toString();
+                return text + ")";
+            }
+            case Kind::SMax: return "smax(" + ops[0]->toString() + ", " + ops[1]->toString() + ")";
+            case Kind::AddRec:
+                return "{" + ops[0]->toString() + ",+," + ops[1]->toString() + "}<%Block" +
+                       std::to_string(loop->header) + ">";
+            default: return "***COULDNOTCOMPUTE***";
+        }
+    }
+
+    bool ScalarEvolution::Key::operator<(const Key& other) const
+    {
+        return std::tie(kind, constant, value, ops, loop) <
+               std::tie(other.kind, other.constant, other.value, other.ops, other.loop);
+    }
+
+    void ScalarEvolution::build(Function& func, CFG& cfg, LoopInfo& loopInfo)
+    {
+        this->cfg      = &cfg;
+        this->loopInfo = &loopInfo;
+        pool.clear();
+        uniqued.clear();
+        values.clear();
+        defs.clear();
+        defBlock.clear();
+        backedgeTaken.clear();
+        phiDepth = 0;
+        tentative.clear();
+
+        for (auto& [id, block] : func.blocks)
+            for (auto* inst : block->insts)
+                if (Operand* def = getDefOperand(*inst))
+                {
+                    defs[def]     = inst;
+                    defBlock[def] = id;
+                }
+    }
+
+    const SCEV* ScalarEvolution::unique(Key key)
+    {
+        auto it = uniqued.find(key);
+        if (it != uniqued.end()) return it->second;
+
+        auto expr      = std::make_unique<SCEV>();
+        expr->kind     = key.kind;
+        expr->id       = pool.size();
+        expr->constant = key.constant;
+        expr->value    = key.value;
+        expr->ops      = key.ops;
+        expr->loop     = key.loop;
+        pool.push_back(std::move(expr));
+        return uniqued[std::move(key)] = pool.back().get();
+    }
+
+    const SCEV* ScalarEvolution::getConstant(long long value)
+    {
+        return unique({SCEV::Kind::Constant, value, nullptr, {}, nullptr});
+    }
+
+    const SCEV* ScalarEvolution::getUnknown(Operand* value)
+    {
+        return unique({SCEV::Kind::Unknown, 0, value, {}, nullptr});
+    }
+
+    const SCEV* ScalarEvolution::getCouldNotCompute()
+    {
+        return unique({SCEV::Kind::CouldNotCompute, 0, nullptr, {}, nullptr});
+    }
+
+    const SCEV* ScalarEvolution::getAddExpr(std::vector<const SCEV*> ops)
+    {
+        std::vector<const SCEV*> flat;
+        for (size_t i = 0; i < ops.size(); ++i)
+        {
+            if (ops[i]->isCouldNotCompute()) return ops[i];
+            if (ops[i]->kind == SCEV::Kind::Add)
+                flat.insert(flat.end(), ops[i]->ops.begin(), ops[i]->ops.end());
+            else
+                flat.push_back(ops[i]);
+        }
+
+        // 常数求和，同类项合并系数 (c * x 的基为 x)，同一循环上的递推逐项相加
+        long long                                      constant = 0;
+        std::vector<std::pair<const SCEV*, long long>> terms;
+        std::vector<const SCEV*>                       recs;
+        for (auto* op : flat)
+        {
+            if (op->isConstant())
+            {
+                constant += op->constant;
+                continue;
+            }
+            if (op->isAddRec())
+            {
+                auto same = std::find_if(recs.begin(), recs.end(), [&](const SCEV* r) { return r->loop == op->loop; });
+                if (same == recs.end())
+                    recs.push_back(op);
+                else
+                    *same = getAddRecExpr(getAddExpr((*same)->getStart(), op->getStart()),
+                        getAddExpr((*same)->getStep(), op->getStep()),
+                        op->loop);
+                continue;
+            }
+
+            const SCEV* base  = op;
+            long long   coeff = 1;
+            if (op->kind == SCEV::Kind::Mul && op->ops[0]->isConstant())
+            {
+                base  = op->ops[1];
+                coeff = op->ops[0]->constant;
+            }
+            auto it = std::find_if(terms.begin(), terms.end(), [&](auto& term) { return term.first == base; });
+            if (it == terms.end())
+                terms.push_back({base, coeff});
+            else
+                it->second += coeff;
+        }
+
+        // 合并后的递推可能退化为普通表达式，需要重新化简
+        for (size_t i = 0; i < recs.size(); ++i)
+            if (!recs[i]->isAddRec())
+            {
+                std::vector<const SCEV*> again = {getConstant(constant), recs[i]};
+                for (auto& [base, coeff] : terms) again.push_back(getMulExpr(getConstant(coeff), base));
+                for (size_t j = 0; j < recs.size(); ++j)
+                    if (j != i) again.push_back(recs[j]);
+                return getAddExpr(std::move(again));
+            }
+
+        std::vector<const SCEV*> result;
+        if (!recs.empty())
+        {
+            // 在最内层递推所属循环中不变的部分并入它的 start
+            const SCEV* inner = recs[0];
+            for (auto* rec : recs)
+                if (rec->loop->depth > inner->loop->depth) inner = rec;
+
+            std::vector<const SCEV*> invariant = {inner->getStart()};
+            if (constant != 0) invariant.push_back(getConstant(constant));
+            constant = 0;
+            for (auto& [base, coeff] : terms)
+            {
+                if (coeff == 0 || !isLoopInvariant(base, inner->loop)) continue;
+                invariant.push_back(getMulExpr(getConstant(coeff), base));
+                coeff = 0;
+            }
+            for (auto*& rec : recs)
+            {
+                if (rec == inner || !isLoopInvariant(rec, inner->loop)) continue;
+                invariant.push_back(rec);
+                rec = nullptr;
+            }
+            if (invariant.size() > 1)
+            {
+                std::vector<const SCEV*> rest;
+                for (auto& [base, coeff] : terms)
+                    if (coeff != 0) rest.push_back(getMulExpr(getConstant(coeff), base));
+                for (auto* rec : recs)
+                    if (rec && rec != inner) rest.push_back(rec);
+                rest.push_back(getAddRecExpr(getAddExpr(std::move(invariant)), inner->getStep(), inner->loop));
+                return getAddExpr(std::move(rest));
+            }
+            for (auto* rec : recs)
+                if (rec) result.push_back(rec);
+        }
+
+        for (auto& [base, coeff] : terms)
+            if (coeff != 0) result.push_back(getMulExpr(getConstant(coeff), base));
+        std::sort(result.begin(), result.end(), byId);
+        if (constant != 0) result.insert(result.begin(), getConstant(constant));
+
+        if (result.empty()) return getConstant(0);
+        if (result.size() == 1) return result[0];
+        return unique({SCEV::Kind::Add, 0, nullptr, std::move(result), nullptr});
+    }
+
+    const SCEV* ScalarEvolution::getMulExpr(const SCEV* a, const SCEV* b)
+    {
+        if (a->isCouldNotCompute()) return a;
+        if (b->isCouldNotCompute()) return b;
+        if (b->isConstant() && !a->isConstant()) std::swap(a, b);
+
+        if (a->isConstant())
+        {
+            if (b->isConstant()) return getConstant(a->constant * b->constant);
+            if (a->constant == 0) return a;
+            if (a->constant == 1) return b;
+            switch (b->kind)
+            {
+                case SCEV::Kind::Add:
+                {
+                    std::vector<const SCEV*> ops;
+                    for (auto* op : b->ops) ops.push_back(getMulExpr(a, op));
+                    return getAddExpr(std::move(ops));
+                }
+                case SCEV::Kind::AddRec:
+                    return getAddRecExpr(getMulExpr(a, b->getStart()), getMulExpr(a, b->getStep()), b->loop);
+                case SCEV::Kind::Mul:
+                    if (b->ops[0]->isConstant())
+                        return getMulExpr(getConstant(a->constant * b->ops[0]->constant), b->ops[1]);
+                    break;
+                default: break;
+            }
+            return unique({SCEV::Kind::Mul, 0, nullptr, {a, b}, nullptr});
+        }
+
+        // 常数系数提到最外层，保持 c * x 的形式以便加法合并同类项
+        if (a->kind == SCEV::Kind::Mul && a->ops[0]->isConstant())
+            return getMulExpr(a->ops[0], getMulExpr(a->ops[1], b));
+        if (b->kind == SCEV::Kind::Mul && b->ops[0]->isConstant())
+            return getMulExpr(b->ops[0], getMulExpr(a, b->ops[1]));
+
+        if (a->isAddRec() && isLoopInvariant(b, a->loop))
+            return getAddRecExpr(getMulExpr(a->getStart(), b), getMulExpr(a->getStep(), b), a->loop);
+        if (b->isAddRec() && isLoopInvariant(a, b->loop))
+            return getAddRecExpr(getMulExpr(a, b->getStart()), getMulExpr(a, b->getStep()), b->loop);
+
+        for (auto [sum, other] : {std::pair{a, b}, std::pair{b, a}})
+        {
+            if (sum->kind != SCEV::Kind::Add) continue;
+            std::vector<const SCEV*> ops;
+            for (auto* op : sum->ops) ops.push_back(getMulExpr(op, other));
+            return getAddExpr(std::move(ops));
+        }
+
+        if (byId(b, a)) std::swap(a, b);
+        return unique({SCEV::Kind::Mul, 0, nullptr, {a, b}, nullptr});
+    }
+
+    const SCEV* ScalarEvolution::getSMaxExpr(const SCEV* a, const SCEV* b)
+    {
+        if (a->isCouldNotCompute()) return a;
+        if (b->isCouldNotCompute()) return b;
+        if (a == b) return a;
+        if (a->isConstant() && b->isConstant()) return a->constant >= b->constant ? a : b;
+        if (b->isConstant() || (!a->isConstant() && byId(b, a))) std::swap(a, b);
+        return unique({SCEV::Kind::SMax, 0, nullptr, {a, b}, nullptr});
+    }
+
+    const SCEV* ScalarEvolution::getAddRecExpr(const SCEV* start, const SCEV* step, const Loop* loop)
+    {
+        if (start->isCouldNotCompute()) return start;
+        if (step->isCouldNotCompute()) return step;
+        if (step->isConstant() && step->constant == 0) return start;
+        return unique({SCEV::Kind::AddRec, 0, nullptr, {start, step}, loop});
+    }
+
+    bool ScalarEvolution::isLoopInvariant(const SCEV* expr, const Loop* loop) const
+    {
+        switch (expr->kind)
+        {
+            case SCEV::Kind::Constant: return true;
+            case SCEV::Kind::Unknown:
+            {
+                auto it = defBlock.find(expr->value);
+                return it == defBlock.end() || !loop->contains(it->second);
+            }
+            case SCEV::Kind::AddRec:
+                // 外层循环的递推在内层循环中不变; 本循环及其子循环的递推随迭代变化
+                return !loop->contains(expr->loop);
+            case SCEV::Kind::CouldNotCompute: return false;
+            default:
+                for (auto* op : expr->ops)
+                    if (!isLoopInvariant(op, loop)) return false;
+                return true;
+        }
+    }
+
+    const SCEV* ScalarEvolution::evaluateAtIteration(const SCEV* addRec, const SCEV* iteration)
+    {
+        if (!addRec->isAddRec()) return addRec;
+        return getAddExpr(addRec->getStart(), getMulExpr(iteration, addRec->getStep()));
+    }
+
+    const SCEV* ScalarEvolution::getSCEV(Operand* value)
+    {
+        auto it = values.find(value);
+        if (it != values.end()) return it->second;
+
+        const SCEV* expr = createSCEV(value);
+        values[value]    = expr;
+        if (phiDepth) tentative.push_back(value);
+        return expr;
+    }
+
+    const SCEV* ScalarEvolution::createSCEV(Operand* value)
+    {
+        if (value->getType() == OperandType::IMMEI32) return getConstant(static_cast<ImmeI32Operand*>(value)->value);
+        if (value->getType() != OperandType::REG) return getUnknown(value);
+
+        auto it = defs.find(value);
+        if (it == defs.end()) return getUnknown(value);
+        Instruction* inst = it->second;
+
+        switch (inst->opcode)
+        {
+            case Operator::ADD:
+            case Operator::SUB:
+            case Operator::MUL:
+            case Operator::SHL:
+            {
+                auto* arith = static_cast<ArithmeticInst*>(inst);
+                if (arith->dt != DataType::I32) break;
+                const SCEV* lhs = getSCEV(arith->lhs);
+                const SCEV* rhs = getSCEV(arith->rhs);
+                if (inst->opcode == Operator::ADD) return getAddExpr(lhs, rhs);
+                if (inst->opcode == Operator::SUB) return getMinusExpr(lhs, rhs);
+                if (inst->opcode == Operator::MUL) return getMulExpr(lhs, rhs);
+                if (rhs->isConstant() && rhs->constant >= 0 && rhs->constant < 31)
+                    return getMulExpr(lhs, getConstant(1LL << rhs->constant));
+                break;
+            }
+            case Operator::PHI:
+                if (static_cast<PhiInst*>(inst)->dt == DataType::I32) return createPhiSCEV(value, inst);
+                break;
+            default: break;
+        }
+        return getUnknown(value);
+    }
+
+    const SCEV* ScalarEvolution::createPhiSCEV(Operand* value, Instruction* inst)
+    {
+        size_t block = defBlock[value];
+        Loop*  loop  = loopInfo->getLoopFor(block);
+        if (!loop || loop->header != block) return getUnknown(value);
+
+        // 循环外的 incoming 给出初值，所有 latch 必须带回同一个值
+        Operand* startVal = nullptr;
+        Operand* backVal  = nullptr;
+        for (auto& [label, val] : static_cast<PhiInst*>(inst)->incomingVals)
+        {
+            Operand*& slot = loop->contains(labelOf(label)) ? backVal : startVal;
+            if (slot && slot != val) return getUnknown(value);
+            slot = val;
+        }
+        if (!startVal || !backVal) return getUnknown(value);
+
+        const SCEV* placeholder = getUnknown(value);
+        values[value]           = placeholder;
+        size_t mark             = tentative.size();
+        ++phiDepth;
+        const SCEV* back = getSCEV(backVal);
+        --phiDepth;
+
+        // 回边值须为 phi + step 且 step 在循环中不变
+        const SCEV* step = nullptr;
+        if (back->kind == SCEV::Kind::Add)
+        {
+            auto pos = std::find(back->ops.begin(), back->ops.end(), placeholder);
+            if (pos != back->ops.end())
+            {
+                std::vector<const SCEV*> rest(back->ops.begin(), pos);
+                rest.insert(rest.end(), pos + 1, back->ops.end());
+                step = getAddExpr(std::move(rest));
+                if (!isLoopInvariant(step, loop)) step = nullptr;
+            }
+        }
+
+        values.erase(value);
+        if (!step)
+        {
+            // 以占位计算出的结果就是最终结果，但外层 phi 仍在分析时须保留记录
+            if (!phiDepth) tentative.clear();
+            return placeholder;
+        }
+
+        for (size_t i = mark; i < tentative.size(); ++i) values.erase(tentative[i]);
+        tentative.resize(mark);
+        return getAddRecExpr(getSCEV(startVal), step, loop);
+    }
+
+    const SCEV* ScalarEvolution::getPointerOffset(Operand* ptr, Operand*& base)
+    {
+        const SCEV* offset = getConstant(0);
+        while (ptr->getType() == OperandType::REG)
+        {
+            auto it = defs.find(ptr);
+            if (it == defs.end() || it->second->opcode != Operator::GETELEMENTPTR) break;
+            auto* gep = static_cast<GEPInst*>(it->second);
+            offset    = getAddExpr(offset, getGEPOffset(*gep));
+            ptr       = gep->basePtr;
+        }
+        base = ptr;
+        return offset;
+    }
+
+    const SCEV* ScalarEvolution::getGEPOffset(GEPInst& gep)
+    {
+        std::vector<const SCEV*> terms;
+        for (size_t j = 0; j < gep.idxs.size(); ++j)
+        {
+            Operand* idx = gep.idxs[j];
+            if (idx->getType() != OperandType::IMMEI32 && idx->getType() != OperandType::REG)
+                return getCouldNotCompute();
+            terms.push_back(getMulExpr(getConstant(getGEPStride(gep, j)), getSCEV(idx)));
+        }
+        return getAddExpr(std::move(terms));
+    }
+
+    const SCEV* ScalarEvolution::getBackedgeTakenCount(const Loop* loop)
+    {
+        auto it = backedgeTaken.find(loop);
+        if (it != backedgeTaken.end()) return it->second;
+        return backedgeTaken[loop] = computeBackedgeTakenCount(loop);
+    }
+
+    size_t ScalarEvolution::getConstantTripCount(const Loop* loop)
+    {
+        const SCEV* count = getBackedgeTakenCount(loop);
+        return count->isConstant() ? static_cast<size_t>(count->constant + 1) : 0;
+    }
+
+    const SCEV* ScalarEvolution::computeBackedgeTakenCount(const Loop* loop)
+    {
+        const SCEV* unknown = getCouldNotCompute();
+        if (loop->exitingBlocks.size() != 1) return unknown;
+        size_t exiting = loop->exitingBlocks[0];
+        if (exiting != loop->header && !(loop->latches.size() == 1 && exiting == loop->latches[0])) return unknown;
+
+        Instruction* term = CFG::getTerminator(cfg->getBlock(exiting));
+        if (!term || term->opcode != Operator::BR_COND) return unknown;
+        auto* br = static_cast<BrCondInst*>(term);
+        auto  it = defs.find(br->cond);
+        if (it == defs.end() || it->second->opcode != Operator::ICMP) return unknown;
+        auto* cmp = static_cast<IcmpInst*>(it->second);
+        if (cmp->dt != DataType::I32) return unknown;
+
+        // 规范为 "value pred bound 成立时留在循环内"，value 为本循环上的递推，bound 在循环中不变
+        ICmpOp      pred  = cmp->cond;
+        const SCEV* value = getSCEV(cmp->lhs);
+        const SCEV* bound = getSCEV(cmp->rhs);
+        if (!(value->isAddRec() && value->loop == loop))
+        {
+            std::swap(value, bound);
+            pred = swapPredicate(pred);
+        }
+        if (!(value->isAddRec() && value->loop == loop) || !isLoopInvariant(bound, loop)) return unknown;
+        if (!loop->contains(labelOf(br->trueTar))) pred = invertPredicate(pred);
+        if (!value->getStep()->isConstant()) return unknown;
+
+        // 第 k 次判断时比较的值为 start + k * step，回边执行次数为第一个使判断不成立的 k
+        const SCEV* start = value->getStart();
+        long long   step  = value->getStep()->constant;
+        const SCEV* distance;
+        switch (pred)
+        {
+            case ICmpOp::SLE: bound = getAddExpr(bound, getConstant(1)); [[fallthrough]];
+            case ICmpOp::SLT:
+                if (step < 0) return unknown;
+                distance = getMinusExpr(bound, start);
+                break;
+            case ICmpOp::SGE: bound = getAddExpr(bound, getConstant(-1)); [[fallthrough]];
+            case ICmpOp::SGT:
+                if (step > 0) return unknown;
+                distance = getMinusExpr(start, bound);
+                step     = -step;
+                break;
+            case ICmpOp::NE:
+            {
+                // 假设循环终止: 值恰好经过 bound
+                distance = step > 0 ? getMinusExpr(bound, start) : getMinusExpr(start, bound);
+                step     = step > 0 ? step : -step;
+                if (!distance->isConstant()) return step == 1 ? distance : unknown;
+                if (distance->constant < 0 || distance->constant % step != 0) return unknown;
+                return getConstant(distance->constant / step);
+            }
+            default: return unknown;
+        }
+
+        if (!distance->isConstant()) return step == 1 ? getSMaxExpr(getConstant(0), distance) : unknown;
+        long long k = distance->constant <= 0 ? 0 : (distance->constant + step - 1) / step;
+
+        // 两端均为常数时检查归纳变量在整个执行过程中不溢出
+        if (start->isConstant())
+        {
+            long long last = start->constant + (k + 1) * value->getStep()->constant;
+            if (last < INT_MIN || last > INT_MAX) return unknown;
+        }
+        return getConstant(k);
+    }
+
+    template <>
+    ScalarEvolution* Manager::get<ScalarEvolution>(Function& func)
+    {
+        if (auto* cached = getCached<ScalarEvolution>(func)) return cached;
+
+        registerDependency<ScalarEvolution, CFG>();
+        registerDependency<ScalarEvolution, LoopInfo>();
+        auto* cfg      = get<CFG>(func);
+        auto* loopInfo = get<LoopInfo>(func);
+
+        auto* scalarEvolution = new ScalarEvolution();
+        scalarEvolution->build(func, *cfg, *loopInfo);
+        return cache<ScalarEvolution>(func, scalarEvolution);
+    }
+}  // namespace ME::Analysis
@@ -0,0 +1,139 @@
+#ifndef __MIDDLEEND_PASS_ANALYSIS_SCALAR_EVOLUTION_H__
+#define __MIDDLEEND_PASS_ANALYSIS_SCALAR_EVOLUTION_H__
+
+#include <middleend/pass/analysis/analysis_manager.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * 标量演化 (Scalar Evolution)
+ * - 通过 Analysis::AM.get<ScalarEvolution>(function) 获取，依赖 CFG 与 LoopInfo。
+ * - 把 i32 整数值表示为 SCEV 表达式: 常数、未知值 (Unknown，即无法继续分解的操作数)、加法、乘法、smax，
+ *   以及仿射递推 {start,+,step}<L>: 在循环 L 的第 k 次迭代 (k 从 0 开始) 中取值 start + k * step。
+ *   start 与 step 在 L 中不变，start 本身可以是外层循环的递推 (嵌套循环中的 i * n + j 即
+ *   {{0,+,n}<L1>,+,1}<L2>)。
+ * - 表达式经过规范化并按结构唯一化，因此可以直接用指针比较相等:
+ *   加法展平并合并同类项，常数与在 L 中不变的项并入 L 上递推的 start; 常数乘法分配到加法与递推上。
+ *   SysY 中有符号溢出是未定义行为，化简时假设不发生溢出。
+ * - 循环 header 中的 phi 若满足 "i = phi [start, 循环外], [i + step, 所有 latch]" 且 step 在循环中不变，
+ *   即识别为 {start,+,step}<L>。分析 phi 时先以 Unknown(phi) 占位，识别成功后丢弃以占位计算出的中间结果。
+ * - getPointerOffset 沿 getelementptr 链求指针相对于根对象的偏移 (以标量元素为单位)。
+ * - getBackedgeTakenCount: 唯一的 exiting 块为 header (while/for 生成的形式) 或唯一的 latch，
+ *   且退出条件为 "递推 与 循环不变量 比较"。步长为 ±1 或两端均为常数时给出精确的回边执行次数 (可为符号表达式，
+ *   带 smax(0, ...) 处理一次都不执行的情况)，否则为 CouldNotCompute。
+ *   getConstantTripCount 返回 header 的执行次数 (回边执行次数 + 1)，无法确定时返回 0。
+ */
+
+namespace ME
+{
+    class Operand;
+    class Function;
+    class Instruction;
+    class GEPInst;
+}  // namespace ME
+
+namespace ME::Analysis
+{
+    class CFG;
+    class Loop;
+    class LoopInfo;
+
+    class SCEV
+    {
+      public:
+        enum class Kind
+        {
+            Constant,
+            Unknown,
+            Add,
+            Mul,
+            SMax,
+            AddRec,
+            CouldNotCompute
+        };
+
+        Kind                     kind;
+        size_t                   id;  // 创建顺序，用于确定性地排列操作数
+        long long                constant = 0;
+        Operand*                 value    = nullptr;
+        std::vector<const SCEV*> ops;  // AddRec: {start, step}
+        const Loop*              loop = nullptr;
+
+      public:
+        bool        isConstant() const { return kind == Kind::Constant; }
+        bool        isAddRec() const { return kind == Kind::AddRec; }
+        bool        isCouldNotCompute() const { return kind == Kind::CouldNotCompute; }
+        const SCEV* getStart() const { return ops[0]; }
+        const SCEV* getStep() const { return ops[1]; }
+        std::string toString() const;
+    };
+
+    class ScalarEvolution
+    {
+      public:
+        static inline const size_t TID = getTID<ScalarEvolution>();
+
+      private:
+        struct Key
+        {
+            SCEV::Kind               kind;
+            long long                constant;
+            Operand*                 value;
+            std::vector<const SCEV*> ops;
+            const Loop*              loop;
+
+            bool operator<(const Key& other) const;
+        };
+
+        CFG*                                        cfg      = nullptr;
+        LoopInfo*                                   loopInfo = nullptr;
+        std::vector<std::unique_ptr<SCEV>>          pool;
+        std::map<Key, const SCEV*>                  uniqued;
+        std::unordered_map<Operand*, const SCEV*>   values;
+        std::unordered_map<Operand*, Instruction*>  defs;
+        std::unordered_map<Operand*, size_t>        defBlock;
+        std::unordered_map<const Loop*, const SCEV*> backedgeTaken;
+
+        // 分析 header phi 期间加入 values 的操作数，识别成功后需要丢弃
+        size_t                 phiDepth = 0;
+        std::vector<Operand*> tentative;
+
+      public:
+        void build(Function& func, CFG& cfg, LoopInfo& loopInfo);
+
+        const SCEV* getSCEV(Operand* value);
+        const SCEV* getPointerOffset(Operand* ptr, Operand*& base);
+        const SCEV* getGEPOffset(GEPInst& gep);
+
+        const SCEV* getConstant(long long value);
+        const SCEV* getUnknown(Operand* value);
+        const SCEV* getCouldNotCompute();
+        const SCEV* getAddExpr(std::vector<const SCEV*> ops);
+        const SCEV* getAddExpr(const SCEV* a, const SCEV* b) { return getAddExpr(std::vector<const SCEV*>{a, b}); }
+        const SCEV* getMinusExpr(const SCEV* a, const SCEV* b) { return getAddExpr(a, getNegativeExpr(b)); }
+        const SCEV* getNegativeExpr(const SCEV* a) { return getMulExpr(getConstant(-1), a); }
+        const SCEV* getMulExpr(const SCEV* a, const SCEV* b);
+        const SCEV* getSMaxExpr(const SCEV* a, const SCEV* b);
+        const SCEV* getAddRecExpr(const SCEV* start, const SCEV* step, const Loop* loop);
+
+        bool        isLoopInvariant(const SCEV* expr, const Loop* loop) const;
+        const SCEV* evaluateAtIteration(const SCEV* addRec, const SCEV* iteration);
+
+        const SCEV* getBackedgeTakenCount(const Loop* loop);
+        size_t      getConstantTripCount(const Loop* loop);
+
+      private:
+        const SCEV* unique(Key key);
+        const SCEV* createSCEV(Operand* value);
+        const SCEV* createPhiSCEV(Operand* value, Instruction* phi);
+        const SCEV* computeBackedgeTakenCount(const Loop* loop);
+    };
+
+    template <>
+    ScalarEvolution* Manager::get<ScalarEvolution>(Function& func);
+}  // namespace ME::Analysis
+
+#endif  // __MIDDLEEND_PASS_ANALYSIS_SCALAR_EVOLUTION_H__
@@ -0,0 +1,242 @@
+#include <middleend/pass/gvn.h>
+#include <middleend/pass/analysis/analysis_manager.h>
+#include <middleend/pass/analysis/call_graph.h>
+#include <middleend/pass/analysis/cfg.h>
+#include <middleend/pass/analysis/control_dependence.h>
+#include <middleend/pass/analysis/dominfo.h>
+#include <middleend/pass/analysis/loop_info.h>
+#include <middleend/pass/analysis/postdominfo.h>
+#include <middleend/module/ir_operand.h>
+#include <middleend/module/ir_utils.h>
+#include <middleend/visitor/utils/operand_visitor.h>
+#include <algorithm>
+#include <unordered_set>
+
+namespace ME
+{
+    namespace
+    {
+        uintptr_t word(Operand* op) { return reinterpret_cast<uintptr_t>(op); }
+
+        bool isCommutative(Operator op)
+        {
+            switch (op)
+            {
+                case Operator::ADD:
+                case Operator::MUL:
+                case Operator::BITAND:
+                case Operator::BITXOR:
+                case Operator::FADD:
+                case Operator::FMUL: return true;
+                default: return false;
+            }
+        }
+
+        // 互为交换的一对谓词统一为枚举值较小的一个; 对称谓词下按地址排列两侧
+        template <typename Cond>
+        void canonicalizeCompare(Cond& cond, Operand*& lhs, Operand*& rhs)
+        {
+            Cond other = swapPredicate(cond);
+            if (other < cond || (other == cond && word(lhs) > word(rhs)))
+            {
+                std::swap(lhs, rhs);
+                cond = swapPredicate(cond);
+            }
+        }
+    }  // namespace
+
+    size_t GVNPass::ExprKeyHash::operator()(const ExprKey& key) const
+    {
+        size_t hash = key.size();
+        for (uintptr_t w : key) hash ^= std::hash<uintptr_t>()(w) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+        return hash;
+    }
+
+    PreservedAnalyses GVNPass::runOnFunction(Function& function)
+    {
+        auto* cfg       = Analysis::AM.get<Analysis::CFG>(function);
+        auto* domInfo   = Analysis::AM.get<Analysis::DomInfo>(function);
+        auto* memorySSA = Analysis::AM.get<Analysis::MemorySSA>(function);
+
+        table.clear();
+        leaders.clear();
+        std::unordered_set<Instruction*> dead;
+
+        struct Frame
+        {
+            size_t               block;
+            size_t               child = 0;
+            std::vector<ExprKey> inserted;
+        };
+
+        const auto&        tree = domInfo->getDomTree();
+        std::vector<Frame> stack;
+
+        auto enter = [&](size_t block) {
+            Frame frame;
+            frame.block = block;
+            for (auto* inst : cfg->getBlock(block)->insts)
+            {
+                for (Operand** use : collectOperands(*inst).uses) *use = leaderOf(*use);
+
+                Operand* def = getDefOperand(*inst);
+                if (!def) continue;
+                if (inst->opcode == Operator::LOAD)
+                    if (Operand* value = forwardStore(static_cast<LoadInst*>(inst), *memorySSA))
+                    {
+                        leaders[def] = value;
+                        dead.insert(inst);
+                        continue;
+                    }
+
+                ExprKey key = makeKey(inst, *memorySSA);
+                if (key.empty()) continue;
+                auto [it, inserted] = table.emplace(key, def);
+                if (inserted)
+                {
+                    frame.inserted.push_back(std::move(key));
+                    continue;
+                }
+                leaders[def] = it->second;
+                dead.insert(inst);
+            }
+            stack.push_back(std::move(frame));
+        };
+
+        enter(cfg->entry);
+        while (!stack.empty())
+        {
+            Frame& top = stack.back();
+            if (top.child < tree[top.block].size())
+            {
+                enter(tree[top.block][top.child++]);
+                continue;
+            }
+            for (auto& key : top.inserted) table.erase(key);
+            stack.pop_back();
+        }
+
+        if (dead.empty()) return PreservedAnalyses::all();
+
+        // 回边上的 phi 来源在其定义块被处理之前就已经读过，统一再替换一遍
+        for (size_t id : cfg->getRPO())
+        {
+            auto& insts = cfg->getBlock(id)->insts;
+            for (auto* inst : insts)
+                for (Operand** use : collectOperands(*inst).uses) *use = leaderOf(*use);
+            insts.erase(std::remove_if(insts.begin(), insts.end(), [&](Instruction* inst) { return dead.count(inst); }),
+                insts.end());
+        }
+        for (auto* inst : dead) delete inst;
+        table.clear();
+        leaders.clear();
+
+        // 只删除了无副作用的计算，控制流与调用关系没有改变
+        PreservedAnalyses pa = PreservedAnalyses::none();
+        pa.preserve<Analysis::CFG>()
+            .preserve<Analysis::DomInfo>()
+            .preserve<Analysis::PostDomInfo>()
+            .preserve<Analysis::ControlDependence>()
+            .preserve<Analysis::LoopInfo>()
+            .preserve<Analysis::CallGraph>();
+        return pa;
+    }
+
+    Operand* GVNPass::leaderOf(Operand* op)
+    {
+        // leader 自身不会再被替换，替换链的长度至多为 1
+        auto it = leaders.find(op);
+        return it == leaders.end() ? op : it->second;
+    }
+
+    Operand* GVNPass::forwardStore(LoadInst* load, Analysis::MemorySSA& memorySSA)
+    {
+        Analysis::MemoryAccess* clobber = memorySSA.getClobberingAccess(load);
+        if (!clobber || !clobber->isDef() || clobber->inst->opcode != Operator::STORE) return nullptr;
+        auto* store = static_cast<StoreInst*>(clobber->inst);
+        if (store->ptr != load->ptr || store->dt != load->dt) return nullptr;
+        return store->val;
+    }
+
+    GVNPass::ExprKey GVNPass::makeKey(Instruction* inst, Analysis::MemorySSA& memorySSA)
+    {
+        ExprKey key{static_cast<uintptr_t>(inst->opcode)};
+        switch (inst->opcode)
+        {
+            case Operator::ADD:
+            case Operator::SUB:
+            case Operator::MUL:
+            case Operator::DIV:
+            case Operator::MOD:
+            case Operator::BITXOR:
+            case Operator::BITAND:
+            case Operator::SHL:
+            case Operator::ASHR:
+            case Operator::LSHR:
+            case Operator::FADD:
+            case Operator::FSUB:
+            case Operator::FMUL:
+            case Operator::FDIV:
+            {
+                auto*    arith = static_cast<ArithmeticInst*>(inst);
+                Operand* lhs   = arith->lhs;
+                Operand* rhs   = arith->rhs;
+                if (isCommutative(inst->opcode) && word(lhs) > word(rhs)) std::swap(lhs, rhs);
+                key.insert(key.end(), {static_cast<uintptr_t>(arith->dt), word(lhs), word(rhs)});
+                return key;
+            }
+            case Operator::ICMP:
+            {
+                auto*    icmp = static_cast<IcmpInst*>(inst);
+                ICmpOp   cond = icmp->cond;
+                Operand* lhs  = icmp->lhs;
+                Operand* rhs  = icmp->rhs;
+                canonicalizeCompare(cond, lhs, rhs);
+                key.insert(key.end(),
+                    {static_cast<uintptr_t>(icmp->dt), static_cast<uintptr_t>(cond), word(lhs), word(rhs)});
+                return key;
+            }
+            case Operator::FCMP:
+            {
+                auto*    fcmp = static_cast<FcmpInst*>(inst);
+                FCmpOp   cond = fcmp->cond;
+                Operand* lhs  = fcmp->lhs;
+                Operand* rhs  = fcmp->rhs;
+                canonicalizeCompare(cond, lhs, rhs);
+                key.insert(key.end(),
+                    {static_cast<uintptr_t>(fcmp->dt), static_cast<uintptr_t>(cond), word(lhs), word(rhs)});
+                return key;
+            }
+            case Operator::GETELEMENTPTR:
+            {
+                auto* gep = static_cast<GEPInst*>(inst);
+                key.insert(key.end(),
+                    {static_cast<uintptr_t>(gep->dt),
+                        static_cast<uintptr_t>(gep->idxType),
+                        gep->dims.size(),
+                        word(gep->basePtr)});
+                for (int dim : gep->dims) key.push_back(static_cast<uintptr_t>(dim));
+                for (Operand* idx : gep->idxs) key.push_back(word(idx));
+                return key;
+            }
+            case Operator::ZEXT:
+            {
+                auto* zext = static_cast<ZextInst*>(inst);
+                key.insert(
+                    key.end(), {static_cast<uintptr_t>(zext->from), static_cast<uintptr_t>(zext->to), word(zext->src)});
+                return key;
+            }
+            case Operator::SITOFP: key.push_back(word(static_cast<SI2FPInst*>(inst)->src)); return key;
+            case Operator::FPTOSI: key.push_back(word(static_cast<FP2SIInst*>(inst)->src)); return key;
+            case Operator::LOAD:
+            {
+                auto*                   load    = static_cast<LoadInst*>(inst);
+                Analysis::MemoryAccess* clobber = memorySSA.getClobberingAccess(load);
+                if (!clobber) return {};
+                key.insert(key.end(), {static_cast<uintptr_t>(load->dt), word(load->ptr), clobber->id});
+                return key;
+            }
+            default: return {};
+        }
+    }
+}  // namespace ME
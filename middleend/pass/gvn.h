@@ -0,0 +1,56 @@
+#ifndef __MIDDLEEND_PASS_GVN_H__
+#define __MIDDLEEND_PASS_GVN_H__
+
+#include <interfaces/middleend/pass.h>
+#include <middleend/module/ir_function.h>
+#include <middleend/module/ir_block.h>
+#include <middleend/module/ir_instruction.h>
+#include <middleend/pass/analysis/memory_ssa.h>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * 全局值编号 (gvn)
+ * - 沿支配树 DFS，维护一张按作用域撤销的散列表: 表达式 -> 首次计算它的值 (leader)。
+ *   进入块时插入的表达式在离开块时删除，因此只有支配当前块的计算才可能被复用。
+ * - 表达式由 (opcode, DataType, 附加属性, 操作数的 leader) 构成，操作数已被替换为各自的 leader，
+ *   所以 leader 本身充当值编号。附加属性: icmp/fcmp 的谓词，getelementptr 的 dims 与下标类型。
+ * - 规范化: add/mul/and/xor/fadd/fmul 与 eq/ne 等对称比较的两个操作数按固定顺序排列;
+ *   sgt/slt 等互为交换的谓词统一为其中一个并相应交换两侧，使 a > b 与 b < a 编号相同。
+ * - 参与编号的指令: 算术、icmp、fcmp、getelementptr、zext、sitofp、fptosi 与 load。
+ *   load 的表达式额外包含 MemorySSA 给出的 clobbering access: 地址相同且 clobber 相同的两个 load 读到同一个值。
+ *   clobber 是向同一地址写入同类型值的 store 时，load 直接取该 store 写入的值。
+ * - 冗余指令的所有使用替换为 leader 后删除; 不改变控制流与调用。
+ */
+
+namespace ME
+{
+    class GVNPass : public FunctionPass
+    {
+      public:
+        GVNPass()  = default;
+        ~GVNPass() = default;
+
+        PreservedAnalyses runOnFunction(Function& function) override;
+
+      private:
+        using ExprKey = std::vector<uintptr_t>;
+
+        struct ExprKeyHash
+        {
+            size_t operator()(const ExprKey& key) const;
+        };
+
+        std::unordered_map<ExprKey, Operand*, ExprKeyHash> table;
+        std::unordered_map<Operand*, Operand*>             leaders;
+
+      private:
+        // 无法编号的指令返回空表达式
+        ExprKey  makeKey(Instruction* inst, Analysis::MemorySSA& memorySSA);
+        Operand* forwardStore(LoadInst* load, Analysis::MemorySSA& memorySSA);
+        Operand* leaderOf(Operand* op);
+    };
+}  // namespace ME
+
+#endif  // __MIDDLEEND_PASS_GVN_H__
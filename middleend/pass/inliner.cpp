@@ -0,0 +1,267 @@
+#include <middleend/pass/inliner.h>
+#include <middleend/pass/analysis/analysis_manager.h>
+#include <middleend/pass/analysis/cfg.h>
+#include <middleend/pass/analysis/loop_info.h>
+#include <middleend/module/ir_operand.h>
+#include <middleend/module/ir_utils.h>
+#include <middleend/visitor/utils/clone_visitor.h>
+#include <middleend/visitor/utils/operand_visitor.h>
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+namespace ME
+{
+    PreservedAnalyses InlinerPass::runOnModule(Module& module)
+    {
+        callGraph = Analysis::AM.get<Analysis::CallGraph>(module);
+        countCallSites(module);
+        sizes.clear();
+
+        bool changed = false;
+        for (Function* function : callGraph->bottomUp()) changed |= inlineCallsIn(*function);
+        changed |= removeDeadFunctions(module);
+
+        callGraph = nullptr;
+        sizes.clear();
+        return changed ? PreservedAnalyses::none() : PreservedAnalyses::all();
+    }
+
+    PreservedAnalyses InlinerPass::runOnFunction(Function& function)
+    {
+        callGraph = Analysis::AM.get<Analysis::CallGraph>(*function.parent);
+        countCallSites(*function.parent);
+        sizes.clear();
+
+        bool changed = inlineCallsIn(function);
+
+        callGraph = nullptr;
+        sizes.clear();
+        return changed ? PreservedAnalyses::none() : PreservedAnalyses::all();
+    }
+
+    bool InlinerPass::inlineCallsIn(Function& caller)
+    {
+        struct Site
+        {
+            CallInst* call;
+            size_t    depth;
+        };
+
+        auto* loopInfo = Analysis::AM.get<Analysis::LoopInfo>(caller);
+
+        std::vector<Site>                     sites;
+        std::unordered_map<CallInst*, Block*> siteBlock;
+        for (auto& [id, block] : caller.blocks)
+            for (auto* inst : block->insts)
+            {
+                if (inst->opcode != Operator::CALL) continue;
+                auto* call = static_cast<CallInst*>(inst);
+                if (!callGraph->resolve(*call)) continue;
+                sites.push_back({call, loopInfo->getLoopDepth(id)});
+                siteBlock[call] = block;
+            }
+
+        const std::string&                     callerName = caller.funcDef->funcName;
+        int                                    callerSize = getSize(caller);
+        bool                                   changed    = false;
+        std::unordered_map<Operand*, Operand*> replaced;
+        for (auto& site : sites)
+        {
+            Function*          callee = callGraph->resolve(*site.call);
+            const std::string& name   = callee->funcDef->funcName;
+            if (callee == &caller || callGraph->isRecursive(callee) || name == "main")
+            {
+                if (remarks)
+                    std::cerr << "remark: '" << name << "' not inlined into '" << callerName
+                              << "': " << (name == "main" ? "entry function" : "recursive") << std::endl;
+                continue;
+            }
+
+            int  cost   = getCost(site.call, *callee);
+            int  limit  = threshold + LoopDepthBonus * static_cast<int>(std::min<size_t>(site.depth, 3));
+            bool single = callSiteCount[name] == 1 && getSize(*callee) <= MaxCalleeSize;
+            bool accept = (cost <= limit || single) && callerSize <= MaxCallerSize;
+            if (remarks)
+            {
+                std::cerr << "remark: ";
+                if (accept)
+                    std::cerr << "inlined '" << name << "' into '" << callerName << "'";
+                else
+                    std::cerr << "'" << name << "' not inlined into '" << callerName << "'";
+                std::cerr << " (cost=" << cost << ", threshold=" << limit;
+                if (single) std::cerr << ", single call site";
+                if (callerSize > MaxCallerSize) std::cerr << ", caller too large";
+                std::cerr << ")" << std::endl;
+            }
+            if (!accept) continue;
+
+            callerSize += getSize(*callee);
+            --callSiteCount[name];
+            inlineCall(caller, siteBlock[site.call], site.call, *callee, siteBlock, replaced);
+            siteBlock.erase(site.call);
+            changed = true;
+        }
+        if (!changed) return false;
+
+        // 返回值替换可能成链: 内层调用的结果作为实参传入后又被外层调用返回
+        auto resolve = [&](Operand* op) {
+            for (auto it = replaced.find(op); it != replaced.end(); it = replaced.find(op)) op = it->second;
+            return op;
+        };
+        if (!replaced.empty())
+            for (auto& [id, block] : caller.blocks)
+                for (auto* inst : block->insts)
+                    for (Operand** use : collectOperands(*inst).uses) *use = resolve(*use);
+
+        sizes.erase(&caller);
+        Analysis::AM.invalidateFunctionAnalyses(caller, PreservedAnalyses::none());
+        Analysis::CFG::removeUnreachableBlocks(caller);
+        return true;
+    }
+
+    void InlinerPass::inlineCall(Function& caller, Block* block, CallInst* call, Function& callee,
+        std::unordered_map<CallInst*, Block*>& siteBlock, std::unordered_map<Operand*, Operand*>& replaced)
+    {
+        // call 之后的指令移入后继块，原块的后继中 phi 的来源随之改为后继块
+        Block*   cont      = caller.createBlock();
+        Operand* contLabel = getLabelOperand(cont->blockId);
+        auto     pos       = std::find(block->insts.begin(), block->insts.end(), call);
+        cont->insts.assign(std::next(pos), block->insts.end());
+        block->insts.erase(pos, block->insts.end());
+        for (auto* inst : cont->insts)
+            if (inst->opcode == Operator::CALL && siteBlock.count(static_cast<CallInst*>(inst)))
+                siteBlock[static_cast<CallInst*>(inst)] = cont;
+
+        std::vector<Operand*> targets;
+        if (!cont->insts.empty())
+        {
+            Instruction* term = cont->insts.back();
+            if (term->opcode == Operator::BR_UNCOND)
+                targets.push_back(static_cast<BrUncondInst*>(term)->target);
+            else if (term->opcode == Operator::BR_COND)
+            {
+                targets.push_back(static_cast<BrCondInst*>(term)->trueTar);
+                targets.push_back(static_cast<BrCondInst*>(term)->falseTar);
+            }
+        }
+        Operand* blockLabel = getLabelOperand(block->blockId);
+        for (Operand* target : targets)
+            for (auto* inst : caller.getBlock(labelOf(target))->insts)
+            {
+                if (inst->opcode != Operator::PHI) break;
+                auto& incoming = static_cast<PhiInst*>(inst)->incomingVals;
+                auto  it       = incoming.find(blockLabel);
+                if (it == incoming.end()) continue;
+                Operand* val = it->second;
+                incoming.erase(it);
+                incoming[contLabel] = val;
+            }
+
+        // 形参映射为实参，被调用者的块与结果寄存器分配新编号
+        CloneMap map;
+        auto&    params = callee.funcDef->argRegs;
+        for (size_t i = 0; i < params.size() && i < call->args.size(); ++i)
+            map.values[params[i].second] = call->args[i].second;
+        for (auto& [id, calleeBlock] : callee.blocks)
+        {
+            map.labels[id] = caller.createBlock()->blockId;
+            for (auto* inst : calleeBlock->insts)
+                if (Operand* def = getDefOperand(*inst)) map.values[def] = getRegOperand(caller.getNewRegId());
+        }
+
+        Block*                                     entry = caller.blocks.begin()->second;
+        std::vector<std::pair<Operand*, Operand*>> returns;
+        for (auto& [id, calleeBlock] : callee.blocks)
+        {
+            Block* copy = caller.getBlock(map.labels[id]);
+            for (auto* inst : calleeBlock->insts)
+            {
+                if (inst->opcode == Operator::RET)
+                {
+                    auto* ret = static_cast<RetInst*>(inst);
+                    if (ret->res) returns.emplace_back(map.mapValue(ret->res), getLabelOperand(copy->blockId));
+                    copy->insertBack(new BrUncondInst(contLabel));
+                    continue;
+                }
+                Instruction* clone = cloneInstruction(*inst, map);
+                if (inst->opcode == Operator::ALLOCA)
+                {
+                    entry->insertFront(clone);
+                    continue;
+                }
+                if (inst->opcode == Operator::CALL) ++callSiteCount[static_cast<CallInst*>(inst)->funcName];
+                copy->insertBack(clone);
+            }
+        }
+        block->insertBack(new BrUncondInst(getLabelOperand(map.labels[callee.blocks.begin()->first])));
+
+        // 没有 ret 时后继块不可达，最后删除不可达块时连同对结果的使用一起删除
+        if (call->res && returns.size() == 1) replaced[call->res] = returns.front().first;
+        if (call->res && returns.size() > 1)
+        {
+            auto* phi = new PhiInst(call->retType, call->res);
+            for (auto& [val, label] : returns) phi->addIncoming(val, label);
+            cont->insertFront(phi);
+        }
+        delete call;
+    }
+
+    int InlinerPass::getCost(CallInst* call, Function& callee)
+    {
+        // 内联后 call 本身与实参传递的开销消失
+        int cost = getSize(callee) - 1 - static_cast<int>(call->args.size());
+        for (auto& [type, arg] : call->args)
+            if (arg->getType() == OperandType::IMMEI32 || arg->getType() == OperandType::IMMEF32) cost -= ConstArgBonus;
+        return cost;
+    }
+
+    int InlinerPass::getSize(Function& function)
+    {
+        auto it = sizes.find(&function);
+        if (it != sizes.end()) return it->second;
+
+        int size = 0;
+        for (auto& [id, block] : function.blocks)
+            for (auto* inst : block->insts)
+                if (inst->opcode != Operator::ALLOCA) ++size;
+        sizes[&function] = size;
+        return size;
+    }
+
+    void InlinerPass::countCallSites(Module& module)
+    {
+        callSiteCount.clear();
+        for (auto* function : module.functions)
+            for (auto& [id, block] : function->blocks)
+                for (auto* inst : block->insts)
+                    if (inst->opcode == Operator::CALL) ++callSiteCount[static_cast<CallInst*>(inst)->funcName];
+    }
+
+    bool InlinerPass::removeDeadFunctions(Module& module)
+    {
+        // 删除一个函数可能使它调用的函数也不再被调用，重复到不动点
+        bool removed = false;
+        for (bool changed = true; changed;)
+        {
+            changed = false;
+            countCallSites(module);
+            for (auto it = module.functions.begin(); it != module.functions.end();)
+            {
+                Function* function = *it;
+                if (function->funcDef->funcName == "main" || callSiteCount[function->funcDef->funcName])
+                {
+                    ++it;
+                    continue;
+                }
+                if (remarks) std::cerr << "remark: removed unused function '" << function->funcDef->funcName << "'"
+                                       << std::endl;
+                Analysis::AM.invalidate(*function);
+                delete function;
+                it      = module.functions.erase(it);
+                changed = removed = true;
+            }
+        }
+        return removed;
+    }
+}  // namespace ME
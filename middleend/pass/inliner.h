@@ -0,0 +1,71 @@
+#ifndef __MIDDLEEND_PASS_INLINER_H__
+#define __MIDDLEEND_PASS_INLINER_H__
+
+#include <interfaces/middleend/pass.h>
+#include <middleend/module/ir_module.h>
+#include <middleend/module/ir_function.h>
+#include <middleend/module/ir_block.h>
+#include <middleend/module/ir_instruction.h>
+#include <middleend/pass/analysis/call_graph.h>
+#include <string>
+#include <unordered_map>
+
+/*
+ * 函数内联 (inline)
+ * - 按调用图自底向上处理各函数，被调用者中可以内联的调用此时已经展开。
+ *   递归函数 (所在分量含环)、外部函数与 main 不被内联; 从被调用者复制进来的调用不再考虑。
+ * - 代价模型: 代价为被调用者的指令数 (alloca 不计)，减去调用本身的开销 (call 与实参传递)，
+ *   每个常数实参再减去 ConstArgBonus (内联后可继续做常量传播);
+ *   阈值为 threshold 加上调用点所在循环深度 (至多 3 层) 乘以 LoopDepthBonus; 代价不超过阈值时内联。
+ *   被调用者在整个模块中只有这一个调用点时内联后原函数可以删除，代码不会膨胀，只要求其代价不超过 MaxCalleeSize。
+ *   调用者的指令数超过 MaxCallerSize 后不再向其中内联。
+ * - 展开: 调用所在块在 call 处一分为二，call 之后的指令移入新的后继块 (其后继中 phi 的来源随之改为新块)。
+ *   被调用者的每个块复制为调用者中的新块，每个结果寄存器分配新编号; 形参 (包括数组的指针形参) 直接映射为实参。
+ *   ret 改为跳转到后继块，返回值只有一个时直接替换 call 的结果，否则在后继块开头用 phi 合并。
+ *   被调用者的 alloca 移到调用者的入口块，避免在循环中反复分配栈空间。
+ * - 全部处理完后删除不再被调用的函数 (main 除外); 被修改的函数重建 CFG 以删除不可达块。
+ * - setThreshold 对应命令行参数 -inline-threshold=<n>; setRemarks(true) (-Rpass=inline) 时
+ *   在标准错误上报告每个调用点是否被内联及其代价与阈值。
+ */
+
+namespace ME
+{
+    class InlinerPass : public ModulePass
+    {
+      public:
+        static constexpr int DefaultThreshold = 60;
+        static constexpr int ConstArgBonus    = 10;
+        static constexpr int LoopDepthBonus   = 30;
+        static constexpr int MaxCalleeSize    = 2000;
+        static constexpr int MaxCallerSize    = 10000;
+
+        InlinerPass()  = default;
+        ~InlinerPass() = default;
+
+        PreservedAnalyses runOnModule(Module& module) override;
+        PreservedAnalyses runOnFunction(Function& function) override;
+
+        static void setThreshold(int value) { threshold = value; }
+        static void setRemarks(bool enable) { remarks = enable; }
+
+      private:
+        static inline int  threshold = DefaultThreshold;
+        static inline bool remarks   = false;
+
+        Analysis::CallGraph*                    callGraph = nullptr;
+        std::unordered_map<std::string, size_t> callSiteCount;  // 函数名 -> 模块中的调用点数
+        std::unordered_map<Function*, int>      sizes;
+
+      private:
+        bool inlineCallsIn(Function& caller);
+        void inlineCall(Function& caller, Block* block, CallInst* call, Function& callee,
+            std::unordered_map<CallInst*, Block*>& siteBlock, std::unordered_map<Operand*, Operand*>& replaced);
+
+        int  getCost(CallInst* call, Function& callee);
+        int  getSize(Function& function);
+        void countCallSites(Module& module);
+        bool removeDeadFunctions(Module& module);
+    };
+}  // namespace ME
+
+#endif  // __MIDDLEEND_PASS_INLINER_H__
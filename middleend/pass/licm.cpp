@@ -0,0 +1,447 @@
+#include <middleend/pass/licm.h>
+#include <middleend/pass/analysis/analysis_manager.h>
+#include <middleend/pass/analysis/call_graph.h>
+#include <middleend/pass/analysis/control_dependence.h>
+#include <middleend/pass/analysis/postdominfo.h>
+#include <middleend/module/ir_module.h>
+#include <middleend/module/ir_operand.h>
+#include <middleend/visitor/utils/operand_visitor.h>
+#include <algorithm>
+#include <functional>
+#include <unordered_set>
+
+namespace ME
+{
+    PreservedAnalyses LICMPass::runOnFunction(Function& function)
+    {
+        this->function = &function;
+        cfg            = Analysis::AM.get<Analysis::CFG>(function);
+        auto* loopInfo = Analysis::AM.get<Analysis::LoopInfo>(function);
+        if (loopInfo->empty()) return PreservedAnalyses::all();
+        domInfo = Analysis::AM.get<Analysis::DomInfo>(function);
+
+        std::vector<size_t> split = ensurePreheaders(*loopInfo);
+        if (!split.empty())
+        {
+            // splitEdge 与 applyUpdates 已就地更新 CFG 和支配树; 新块可能属于外层循环，循环信息需要重新计算
+            PreservedAnalyses pa = PreservedAnalyses::none();
+            pa.preserve<Analysis::CFG>().preserve<Analysis::DomInfo>().preserve<Analysis::CallGraph>();
+            Analysis::AM.invalidateFunctionAnalyses(function, pa);
+            loopInfo = Analysis::AM.get<Analysis::LoopInfo>(function);
+        }
+        aa = Analysis::AM.get<Analysis::AliasAnalysis>(function);
+
+        globals.clear();
+        if (function.parent)
+            for (auto* decl : function.parent->globalVars) globals[decl->name] = decl;
+        for (size_t id : cfg->getRPO())
+            for (auto* inst : cfg->getBlock(id)->insts)
+            {
+                if (Operand* def = getDefOperand(*inst)) defBlock[def] = id;
+                if (inst->opcode == Operator::ALLOCA)
+                    allocas[static_cast<AllocaInst*>(inst)->res] = static_cast<AllocaInst*>(inst);
+            }
+
+        // getLoops() 为先序，逆序遍历时内层循环先于外层
+        bool changed = false;
+        auto loops   = loopInfo->getLoops();
+        for (auto it = loops.rbegin(); it != loops.rend(); ++it)
+        {
+            size_t preheader = loopInfo->getPreheader(**it);
+            if (preheader == Analysis::CFG::npos) continue;
+            changed |= hoist(**it, preheader);
+            changed |= promote(**it, preheader);
+        }
+
+        defBlock.clear();
+        allocas.clear();
+        globals.clear();
+
+        if (!split.empty())
+        {
+            // 没有放入任何指令的前置块再删除，否则 simplifycfg 会删掉它，下一次运行又重新插入
+            size_t removed = removeEmptyPreheaders(split);
+            PreservedAnalyses pa = PreservedAnalyses::none();
+            pa.preserve<Analysis::CFG>().preserve<Analysis::DomInfo>().preserve<Analysis::CallGraph>();
+            if (!changed && removed == split.size())
+            {
+                // 函数已恢复原状，但拆分后重新计算的循环信息仍引用被删除的块
+                Analysis::AM.invalidateFunctionAnalyses(function, pa);
+                return PreservedAnalyses::all();
+            }
+            if (removed == 0) pa.preserve<Analysis::LoopInfo>();
+            return pa;
+        }
+        if (!changed) return PreservedAnalyses::all();
+
+        // 只在块之间移动了指令并新增了 phi / load / store，控制流与调用关系没有改变
+        PreservedAnalyses pa = PreservedAnalyses::none();
+        pa.preserve<Analysis::CFG>()
+            .preserve<Analysis::DomInfo>()
+            .preserve<Analysis::PostDomInfo>()
+            .preserve<Analysis::ControlDependence>()
+            .preserve<Analysis::LoopInfo>()
+            .preserve<Analysis::CallGraph>();
+        return pa;
+    }
+
+    std::vector<size_t> LICMPass::ensurePreheaders(Analysis::LoopInfo& loopInfo)
+    {
+        std::vector<size_t>                    created;
+        std::vector<Analysis::DomInfo::Update> updates;
+        for (auto* loop : loopInfo.getLoops())
+        {
+            if (loopInfo.getPreheader(*loop) != Analysis::CFG::npos) continue;
+
+            size_t outside = Analysis::CFG::npos;
+            size_t count   = 0;
+            for (size_t pred : cfg->preds(loop->header))
+                if (!loop->contains(pred))
+                {
+                    outside = pred;
+                    ++count;
+                }
+            if (count != 1) continue;
+            size_t mid = cfg->splitEdge(outside, loop->header);
+            created.push_back(mid);
+            updates.push_back({Analysis::DomInfo::Update::Insert, outside, mid});
+            updates.push_back({Analysis::DomInfo::Update::Insert, mid, loop->header});
+            updates.push_back({Analysis::DomInfo::Update::Delete, outside, loop->header});
+        }
+        if (!updates.empty()) domInfo->applyUpdates(updates);
+        return created;
+    }
+
+    size_t LICMPass::removeEmptyPreheaders(const std::vector<size_t>& created)
+    {
+        std::vector<Analysis::DomInfo::Update> updates;
+        for (size_t mid : created)
+        {
+            if (cfg->getBlock(mid)->insts.size() != 1) continue;
+            size_t outside = cfg->preds(mid)[0];
+            size_t header  = cfg->succs(mid)[0];
+            cfg->removeForwardingBlock(mid);
+            updates.push_back({Analysis::DomInfo::Update::Insert, outside, header});
+            updates.push_back({Analysis::DomInfo::Update::Delete, outside, mid});
+            updates.push_back({Analysis::DomInfo::Update::Delete, mid, header});
+        }
+        if (!updates.empty()) domInfo->applyUpdates(updates);
+        return updates.size() / 3;
+    }
+
+    bool LICMPass::isInvariant(Analysis::Loop& loop, Operand* op) const
+    {
+        auto it = defBlock.find(op);
+        return it == defBlock.end() || !loop.contains(it->second);
+    }
+
+    bool LICMPass::isDereferenceable(Operand* ptr) const
+    {
+        const Analysis::MemoryLocation& loc = aa->getLocation(ptr);
+        if (!loc.isIdentifiedObject() || !loc.offsetKnown || !loc.terms.empty() || loc.offset < 0) return false;
+
+        long long size = 1;
+        if (loc.kind == Analysis::MemoryLocation::Kind::Alloca)
+        {
+            auto it = allocas.find(loc.base);
+            if (it == allocas.end()) return false;
+            for (int dim : it->second->dims) size *= dim;
+        }
+        else
+        {
+            auto it = globals.find(static_cast<GlobalOperand*>(loc.base)->name);
+            if (it == globals.end()) return false;
+            for (int dim : it->second->initList.arrayDims) size *= dim;
+        }
+        return loc.offset < size;
+    }
+
+    bool LICMPass::mayWrite(Analysis::Loop& loop, Operand* ptr) const
+    {
+        for (size_t id : loop.blocks)
+            for (auto* inst : cfg->getBlock(id)->insts)
+            {
+                if (inst->opcode == Operator::STORE && !aa->isNoAlias(static_cast<StoreInst*>(inst)->ptr, ptr))
+                    return true;
+                if (inst->opcode == Operator::CALL &&
+                    Analysis::isModSet(aa->getModRef(*static_cast<CallInst*>(inst), ptr)))
+                    return true;
+            }
+        return false;
+    }
+
+    bool LICMPass::isHoistable(Analysis::Loop& loop, Instruction* inst, size_t block) const
+    {
+        switch (inst->opcode)
+        {
+            case Operator::DIV:
+            case Operator::MOD:
+            {
+                // 除数可能为 0 (或 INT_MIN / -1) 时，外提会在原本不执行除法的路径上引入异常
+                Operand* rhs = static_cast<ArithmeticInst*>(inst)->rhs;
+                if (rhs->getType() != OperandType::IMMEI32) return false;
+                int divisor = static_cast<ImmeI32Operand*>(rhs)->value;
+                if (divisor == 0 || divisor == -1) return false;
+                break;
+            }
+            case Operator::ADD:
+            case Operator::SUB:
+            case Operator::MUL:
+            case Operator::BITXOR:
+            case Operator::BITAND:
+            case Operator::SHL:
+            case Operator::ASHR:
+            case Operator::LSHR:
+            case Operator::FADD:
+            case Operator::FSUB:
+            case Operator::FMUL:
+            case Operator::FDIV:
+            case Operator::ICMP:
+            case Operator::FCMP:
+            case Operator::GETELEMENTPTR:
+            case Operator::ZEXT:
+            case Operator::SITOFP:
+            case Operator::FPTOSI: break;
+            case Operator::LOAD:
+            {
+                Operand* ptr = static_cast<LoadInst*>(inst)->ptr;
+                if (!isInvariant(loop, ptr) || mayWrite(loop, ptr)) return false;
+                if (isDereferenceable(ptr)) return true;
+                if (loop.exitingBlocks.empty()) return false;
+                for (size_t exiting : loop.exitingBlocks)
+                    if (!domInfo->dominates(block, exiting)) return false;
+                return true;
+            }
+            default: return false;
+        }
+
+        for (Operand** use : collectOperands(*inst).uses)
+            if (!isInvariant(loop, *use)) return false;
+        return true;
+    }
+
+    void LICMPass::insertBeforeTerminator(Instruction* inst, size_t block)
+    {
+        auto& insts = cfg->getBlock(block)->insts;
+        auto  pos   = insts.end();
+        if (!insts.empty() && insts.back()->isTerminator()) --pos;
+        insts.insert(pos, inst);
+    }
+
+    bool LICMPass::hoist(Analysis::Loop& loop, size_t preheader)
+    {
+        std::vector<size_t> order = loop.blocks;
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return cfg->getRPOIndex(a) < cfg->getRPOIndex(b);
+        });
+
+        // 逆后序下操作数的定义先于使用 (phi 除外，而 phi 不会被外提)，一遍即可外提整条不变链
+        bool changed = false;
+        for (size_t id : order)
+        {
+            auto&                     insts = cfg->getBlock(id)->insts;
+            std::vector<Instruction*> moved;
+            for (auto* inst : insts)
+                if (isHoistable(loop, inst, id))
+                {
+                    moved.push_back(inst);
+                    if (Operand* def = getDefOperand(*inst)) defBlock[def] = preheader;
+                }
+            if (moved.empty()) continue;
+
+            std::unordered_set<Instruction*> movedSet(moved.begin(), moved.end());
+            insts.erase(
+                std::remove_if(insts.begin(), insts.end(), [&](Instruction* inst) { return movedSet.count(inst); }),
+                insts.end());
+            for (auto* inst : moved) insertBeforeTerminator(inst, preheader);
+            changed = true;
+        }
+        return changed;
+    }
+
+    bool LICMPass::promote(Analysis::Loop& loop, size_t preheader)
+    {
+        for (size_t exit : loop.exitBlocks)
+            for (size_t pred : cfg->preds(exit))
+                if (!loop.contains(pred)) return false;
+
+        // 候选地址: 循环内被 store 的不变地址，按出现顺序
+        std::vector<Operand*>        candidates;
+        std::unordered_set<Operand*> seen;
+        for (size_t id : loop.blocks)
+            for (auto* inst : cfg->getBlock(id)->insts)
+                if (inst->opcode == Operator::STORE)
+                {
+                    Operand* ptr = static_cast<StoreInst*>(inst)->ptr;
+                    if (seen.insert(ptr).second && isInvariant(loop, ptr) && isDereferenceable(ptr))
+                        candidates.push_back(ptr);
+                }
+
+        bool changed = false;
+        for (Operand* ptr : candidates)
+        {
+            DataType type       = DataType::UNK;
+            bool     promotable = true;
+            for (size_t id : loop.blocks)
+            {
+                for (auto* inst : cfg->getBlock(id)->insts)
+                {
+                    Operand* other = nullptr;
+                    DataType dt    = DataType::UNK;
+                    if (inst->opcode == Operator::LOAD)
+                    {
+                        other = static_cast<LoadInst*>(inst)->ptr;
+                        dt    = static_cast<LoadInst*>(inst)->dt;
+                    }
+                    else if (inst->opcode == Operator::STORE)
+                    {
+                        other = static_cast<StoreInst*>(inst)->ptr;
+                        dt    = static_cast<StoreInst*>(inst)->dt;
+                    }
+                    else if (inst->opcode == Operator::CALL)
+                        promotable = aa->getModRef(*static_cast<CallInst*>(inst), ptr) == Analysis::ModRefInfo::NoModRef;
+
+                    if (other == ptr)
+                    {
+                        if (type != DataType::UNK && type != dt) promotable = false;
+                        type = dt;
+                    }
+                    else if (other && !aa->isNoAlias(other, ptr))
+                        promotable = false;
+                    if (!promotable) break;
+                }
+                if (!promotable) break;
+            }
+            if (!promotable) continue;
+
+            // 前置块中读取初值，循环内按需构造 SSA
+            auto* init = new LoadInst(type, ptr, getRegOperand(function->getNewRegId()));
+            insertBeforeTerminator(init, preheader);
+            defBlock[init->res] = preheader;
+
+            std::unordered_map<size_t, Operand*>     startValue, endValue;
+            std::unordered_map<Operand*, Operand*>   replacement;
+            std::vector<std::pair<PhiInst*, size_t>> phis;
+            std::unordered_set<Instruction*>         dead;
+
+            auto newPhi = [&](size_t block) {
+                auto* phi = new PhiInst(type, getRegOperand(function->getNewRegId()));
+                cfg->getBlock(block)->insertFront(phi);
+                phis.push_back({phi, block});
+                return phi;
+            };
+
+            std::function<Operand*(size_t)> valueAtStart, valueAtEnd;
+            valueAtStart = [&](size_t block) -> Operand* {
+                auto it = startValue.find(block);
+                if (it != startValue.end()) return it->second;
+
+                const auto& preds = cfg->preds(block);
+                if (block != loop.header && preds.size() == 1) return startValue[block] = valueAtEnd(preds[0]);
+
+                // 先登记 phi 再查询前驱，环上的查询会回到这个 phi
+                PhiInst* phi      = newPhi(block);
+                startValue[block] = phi->res;
+                for (size_t pred : preds)
+                    phi->addIncoming(pred == preheader ? init->res : valueAtEnd(pred), getLabelOperand(pred));
+                return phi->res;
+            };
+            valueAtEnd = [&](size_t block) -> Operand* {
+                auto it = endValue.find(block);
+                if (it != endValue.end()) return it->second;
+
+                Operand* value = nullptr;
+                for (auto* inst : cfg->getBlock(block)->insts)
+                    if (inst->opcode == Operator::STORE && static_cast<StoreInst*>(inst)->ptr == ptr)
+                        value = static_cast<StoreInst*>(inst)->val;
+                if (!value) value = valueAtStart(block);
+                return endValue[block] = value;
+            };
+
+            for (size_t id : loop.blocks)
+            {
+                Operand* current = nullptr;
+                for (auto* inst : cfg->getBlock(id)->insts)
+                {
+                    if (inst->opcode == Operator::LOAD && static_cast<LoadInst*>(inst)->ptr == ptr)
+                    {
+                        if (!current) current = valueAtStart(id);
+                        replacement[static_cast<LoadInst*>(inst)->res] = current;
+                        dead.insert(inst);
+                    }
+                    else if (inst->opcode == Operator::STORE && static_cast<StoreInst*>(inst)->ptr == ptr)
+                    {
+                        current = static_cast<StoreInst*>(inst)->val;
+                        dead.insert(inst);
+                    }
+                }
+            }
+
+            // 各出口块开头 (phi 之后) 写回离开循环时的值
+            for (size_t exit : loop.exitBlocks)
+            {
+                const auto& preds = cfg->preds(exit);
+                Operand*    value = nullptr;
+                if (preds.size() == 1)
+                    value = valueAtEnd(preds[0]);
+                else
+                {
+                    PhiInst* phi = newPhi(exit);
+                    for (size_t pred : preds) phi->addIncoming(valueAtEnd(pred), getLabelOperand(pred));
+                    value = phi->res;
+                }
+                auto& insts = cfg->getBlock(exit)->insts;
+                auto  pos   = std::find_if(
+                    insts.begin(), insts.end(), [](Instruction* inst) { return inst->opcode != Operator::PHI; });
+                insts.insert(pos, new StoreInst(type, value, ptr));
+            }
+
+            // 删除所有来源相同的 phi (忽略指向自身的来源)，直到不再变化
+            auto resolve = [&](Operand* op) {
+                for (auto it = replacement.find(op); it != replacement.end(); it = replacement.find(op)) op = it->second;
+                return op;
+            };
+            for (bool again = true; again;)
+            {
+                again = false;
+                for (auto& [phi, block] : phis)
+                {
+                    if (dead.count(phi)) continue;
+                    Operand* same    = nullptr;
+                    bool     trivial = true;
+                    for (auto& [label, val] : phi->incomingVals)
+                    {
+                        Operand* v = resolve(val);
+                        if (v == phi->res || v == same) continue;
+                        if (same)
+                        {
+                            trivial = false;
+                            break;
+                        }
+                        same = v;
+                    }
+                    if (!trivial || !same) continue;
+                    replacement[phi->res] = same;
+                    dead.insert(phi);
+                    again = true;
+                }
+            }
+
+            for (size_t id : cfg->getRPO())
+            {
+                auto& insts = cfg->getBlock(id)->insts;
+                for (auto* inst : insts)
+                    if (!dead.count(inst))
+                        for (Operand** use : collectOperands(*inst).uses) *use = resolve(*use);
+                insts.erase(
+                    std::remove_if(insts.begin(), insts.end(), [&](Instruction* inst) { return dead.count(inst); }),
+                    insts.end());
+            }
+            for (auto& [phi, block] : phis)
+                if (!dead.count(phi)) defBlock[phi->res] = block;
+            for (auto* inst : dead) delete inst;
+            changed = true;
+        }
+        return changed;
+    }
+}  // namespace ME
@@ -0,0 +1,68 @@
+#ifndef __MIDDLEEND_PASS_LICM_H__
+#define __MIDDLEEND_PASS_LICM_H__
+
+#include <interfaces/middleend/pass.h>
+#include <middleend/module/ir_function.h>
+#include <middleend/module/ir_block.h>
+#include <middleend/module/ir_instruction.h>
+#include <middleend/pass/analysis/alias_analysis.h>
+#include <middleend/pass/analysis/cfg.h>
+#include <middleend/pass/analysis/dominfo.h>
+#include <middleend/pass/analysis/loop_info.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * 循环不变量外提 (licm)
+ * - 依赖 LoopInfo。header 只有一个循环外前驱却没有前置块时，用 CFG::splitEdge 在该边上插入前置块;
+ *   循环外前驱不唯一的循环不处理。插入的边一并交给 DomInfo::applyUpdates，就地更新的 CFG 与支配树仍然有效，
+ *   循环信息与其余分析重新获取。处理完所有循环后，没有外提或写入任何指令的新前置块用
+ *   CFG::removeForwardingBlock 删除 (同样就地更新支配树); 函数因此恢复原状时报告未修改，
+ *   避免与删除空块的 simplifycfg 在 fixpoint 中反复插入、删除同一个块。
+ * - 按内层到外层的顺序处理各循环，块按逆后序遍历，操作数都定义在循环外 (或已被外提) 的指令移到前置块末尾:
+ *   - 算术、比较、getelementptr 与类型转换; sdiv / srem 只在除数为非 0、非 -1 的常数时外提 (其余情形可能陷入异常)。
+ *   - load: 循环内没有可能与它别名的 store，也没有可能写该位置的 call; 并且地址指向 alloca / 全局变量中
+ *     常数偏移的合法元素，或 load 所在块支配循环的所有 exiting 块 (进入循环后必然执行)，外提不会引入非法访存。
+ * - store 下沉 (标量提升): 循环内对不变地址 p 的所有访问都直接使用 p，其余访存与调用都不可能访问 p，
+ *   p 指向 alloca / 全局变量中的合法元素，且每个出口块的前驱都在循环内时，
+ *   前置块中 load 一次初值，循环内的 load / store 改写为 SSA 值 (按需在块首放置 phi)，各出口块开头写回最终值。
+ */
+
+namespace ME
+{
+    class LICMPass : public FunctionPass
+    {
+      public:
+        LICMPass()  = default;
+        ~LICMPass() = default;
+
+        PreservedAnalyses runOnFunction(Function& function) override;
+
+      private:
+        Function*                                        function = nullptr;
+        Analysis::CFG*                                   cfg      = nullptr;
+        Analysis::DomInfo*                               domInfo  = nullptr;
+        Analysis::AliasAnalysis*                         aa       = nullptr;
+        std::unordered_map<Operand*, size_t>             defBlock;
+        std::unordered_map<Operand*, AllocaInst*>        allocas;
+        std::unordered_map<std::string, GlbVarDeclInst*> globals;
+
+      private:
+        // 返回新插入的前置块
+        std::vector<size_t> ensurePreheaders(Analysis::LoopInfo& loopInfo);
+        // 删除其中仍然为空的前置块，返回删除的个数
+        size_t              removeEmptyPreheaders(const std::vector<size_t>& created);
+
+        bool hoist(Analysis::Loop& loop, size_t preheader);
+        bool promote(Analysis::Loop& loop, size_t preheader);
+
+        bool isInvariant(Analysis::Loop& loop, Operand* op) const;
+        bool isHoistable(Analysis::Loop& loop, Instruction* inst, size_t block) const;
+        bool isDereferenceable(Operand* ptr) const;
+        bool mayWrite(Analysis::Loop& loop, Operand* ptr) const;
+        void insertBeforeTerminator(Instruction* inst, size_t block);
+    };
+}  // namespace ME
+
+#endif  // __MIDDLEEND_PASS_LICM_H__
@@ -0,0 +1,367 @@
+#include <middleend/pass/loop_unroll.h>
+#include <middleend/pass/analysis/analysis_manager.h>
+#include <middleend/module/ir_operand.h>
+#include <middleend/module/ir_utils.h>
+#include <middleend/visitor/utils/operand_visitor.h>
+#include <climits>
+
+namespace ME
+{
+    namespace
+    {
+        std::vector<PhiInst*> headerPhis(Block* header)
+        {
+            std::vector<PhiInst*> phis;
+            for (auto* inst : header->insts)
+            {
+                if (inst->opcode != Operator::PHI) break;
+                phis.push_back(static_cast<PhiInst*>(inst));
+            }
+            return phis;
+        }
+
+        Operand* incomingFrom(PhiInst* phi, size_t block)
+        {
+            for (auto& [label, val] : phi->incomingVals)
+                if (labelOf(label) == block) return val;
+            return nullptr;
+        }
+    }  // namespace
+
+    PreservedAnalyses LoopUnrollPass::runOnFunction(Function& function)
+    {
+        this->function = &function;
+        {
+            std::lock_guard<std::mutex> lock(statesMutex);
+            state = &states[&function];
+        }
+
+        // 每次变换后分析全部失效，重新获取后选择下一个未尝试过、也不是本 pass 产生的最内层循环
+        std::unordered_set<size_t> tried;
+        bool                       changed = false;
+        while (true)
+        {
+            cfg             = Analysis::AM.get<Analysis::CFG>(function);
+            auto* loopInfo  = Analysis::AM.get<Analysis::LoopInfo>(function);
+            Analysis::Loop* candidate = nullptr;
+            for (auto* loop : loopInfo->getLoops())
+                if (loop->isInnermost() && !tried.count(loop->header) && !state->created.count(loop->header))
+                {
+                    candidate = loop;
+                    break;
+                }
+            if (!candidate) break;
+
+            tried.insert(candidate->header);
+            if (!tryUnroll(*candidate)) continue;
+            changed = true;
+            Analysis::AM.invalidateFunctionAnalyses(function, PreservedAnalyses::none());
+        }
+
+        state = nullptr;
+        if (!changed) return PreservedAnalyses::all();
+        Analysis::CFG::removeUnreachableBlocks(function);
+        return PreservedAnalyses::none();
+    }
+
+    bool LoopUnrollPass::tryUnroll(Analysis::Loop& loop)
+    {
+        if (loop.latches.size() != 1 || loop.exitingBlocks.size() != 1 || loop.exitBlocks.size() != 1) return false;
+
+        size_t preheader = Analysis::CFG::npos;
+        for (size_t pred : cfg->preds(loop.header))
+        {
+            if (loop.contains(pred)) continue;
+            if (preheader != Analysis::CFG::npos) return false;
+            preheader = pred;
+        }
+        if (preheader == Analysis::CFG::npos) return false;
+
+        size_t size      = loopSize(loop);
+        bool   arrayInit = isArrayInit(loop);
+        size_t scale     = arrayInit ? 2 : 1;
+
+        size_t tripCount = Analysis::AM.get<Analysis::ScalarEvolution>(*function)->getConstantTripCount(&loop);
+        if (tripCount && tripCount <= MaxFullTripCount * scale * scale && tripCount * size <= FullUnrollSize * scale &&
+            tripCount * size <= state->budget)
+        {
+            unrollFully(loop, preheader, tripCount);
+            state->budget -= tripCount * size;
+            return true;
+        }
+
+        if (factor < 2 || loop.exitingBlocks[0] != loop.header) return false;
+        size_t count = factor * scale;
+        while (count >= 2 && count * size > PartialUnrollSize * scale) count /= 2;
+        if (count < 2 || count * size > state->budget) return false;
+        // header 执行 tripCount 次时循环体执行 tripCount - 1 次，不足一轮展开的部分全部留给原循环
+        if (tripCount && tripCount - 1 < count) return false;
+
+        Induction induction;
+        if (!matchInduction(loop, induction)) return false;
+        long long distance = induction.delta + static_cast<long long>(count - 1) * induction.step;
+        if (distance < INT_MIN || distance > INT_MAX) return false;
+        if (induction.bound->getType() == OperandType::IMMEI32)
+        {
+            long long limit = static_cast<ImmeI32Operand*>(induction.bound)->value - distance;
+            if (limit < INT_MIN || limit > INT_MAX) return false;
+        }
+
+        state->created.insert(unrollPartially(loop, preheader, induction, count));
+        state->created.insert(loop.header);
+        state->budget -= count * size;
+        return true;
+    }
+
+    void LoopUnrollPass::unrollFully(Analysis::Loop& loop, size_t preheader, size_t tripCount)
+    {
+        size_t latch   = loop.latches[0];
+        size_t exiting = loop.exitingBlocks[0];
+        size_t exit    = loop.exitBlocks[0];
+        auto   phis    = headerPhis(cfg->getBlock(loop.header));
+
+        CloneMap prev;
+        for (size_t k = 0; k < tripCount; ++k)
+        {
+            std::unordered_map<Operand*, Operand*> phiValues;
+            for (auto* phi : phis)
+                phiValues[phi->res] = k == 0 ? incomingFrom(phi, preheader) : prev.mapValue(incomingFrom(phi, latch));
+
+            CloneMap map = cloneIteration(loop, phiValues, k + 1 == tripCount ? exit : Analysis::CFG::npos);
+            if (k == 0)
+                retarget(preheader, loop.header, map.labels[loop.header]);
+            else
+                redirectBackEdge(loop, prev, map.labels[loop.header]);
+            prev = std::move(map);
+        }
+
+        // 只有最后一份迭代离开循环: 出口 phi 的来源块改为最后一份的 exiting 块，
+        // 循环外对循环内定义的值的使用改为最后一份中的值 (最后一份的 header phi 映射到对应的值)
+        Operand* oldLabel = getLabelOperand(exiting);
+        Operand* newLabel = getLabelOperand(prev.labels[exiting]);
+        for (auto* inst : cfg->getBlock(exit)->insts)
+        {
+            if (inst->opcode != Operator::PHI) break;
+            auto* phi = static_cast<PhiInst*>(inst);
+            auto  it  = phi->incomingVals.find(oldLabel);
+            if (it == phi->incomingVals.end()) continue;
+            Operand* val = it->second;
+            phi->incomingVals.erase(it);
+            phi->addIncoming(val, newLabel);
+        }
+
+        std::unordered_set<size_t> cloned;
+        for (auto& [from, to] : prev.labels) cloned.insert(to);
+        for (auto& [id, block] : function->blocks)
+        {
+            if (loop.contains(id) || cloned.count(id)) continue;
+            for (auto* inst : block->insts)
+                for (Operand** use : collectOperands(*inst).uses) *use = prev.mapValue(*use);
+        }
+    }
+
+    size_t LoopUnrollPass::unrollPartially(
+        Analysis::Loop& loop, size_t preheader, const Induction& induction, size_t count)
+    {
+        size_t latch = loop.latches[0];
+        auto   phis  = headerPhis(cfg->getBlock(loop.header));
+        Block* guard = function->createBlock();
+
+        // 第 count - 1 份迭代的退出判断为 (phi + distance) pred bound，改写为 phi pred (bound - distance)，
+        // 避免在 guard 中做可能回绕的加法。常数 bound 直接折叠 (tryUnroll 已检查不溢出);
+        // 否则在 check 块中计算 bound - distance，并只在它不溢出时进入展开后的循环，溢出时直接执行原循环
+        long long distance = induction.delta + static_cast<long long>(count - 1) * induction.step;
+        Operand*  limit    = induction.bound;
+        Block*    check    = nullptr;
+        if (distance != 0 && limit->getType() == OperandType::IMMEI32)
+            limit = getImmeI32Operand(static_cast<int>(static_cast<ImmeI32Operand*>(limit)->value - distance));
+        else if (distance != 0)
+        {
+            check         = function->createBlock();
+            Operand* safe = getRegOperand(function->getNewRegId());
+            if (distance > 0)
+                check->insertBack(new IcmpInst(DataType::I32, ICmpOp::SGE, induction.bound,
+                    getImmeI32Operand(static_cast<int>(INT_MIN + distance)), safe));
+            else
+                check->insertBack(new IcmpInst(DataType::I32, ICmpOp::SLE, induction.bound,
+                    getImmeI32Operand(static_cast<int>(INT_MAX + distance)), safe));
+            limit = getRegOperand(function->getNewRegId());
+            check->insertBack(new ArithmeticInst(
+                Operator::SUB, DataType::I32, induction.bound, getImmeI32Operand(static_cast<int>(distance)), limit));
+            check->insertBack(new BrCondInst(safe, getLabelOperand(guard->blockId), getLabelOperand(loop.header)));
+        }
+        size_t entry = check ? check->blockId : preheader;  // guard 在循环外的前驱
+
+        // 新的循环头 guard: phi 维护进入每轮展开时各 header phi 的值
+        std::unordered_map<Operand*, Operand*> guardValues;
+        std::vector<PhiInst*>                  guardPhis;
+        for (auto* phi : phis)
+        {
+            auto* guardPhi = new PhiInst(phi->dt, getRegOperand(function->getNewRegId()));
+            guardPhi->addIncoming(incomingFrom(phi, preheader), getLabelOperand(entry));
+            guard->insertBack(guardPhi);
+            guardValues[phi->res] = guardPhi->res;
+            guardPhis.push_back(guardPhi);
+        }
+
+        CloneMap prev;
+        size_t   first = 0;
+        for (size_t k = 0; k < count; ++k)
+        {
+            std::unordered_map<Operand*, Operand*> phiValues;
+            for (auto* phi : phis)
+                phiValues[phi->res] = k == 0 ? guardValues[phi->res] : prev.mapValue(incomingFrom(phi, latch));
+
+            CloneMap map = cloneIteration(loop, phiValues, Analysis::CFG::npos);
+            if (k == 0)
+                first = map.labels[loop.header];
+            else
+                redirectBackEdge(loop, prev, map.labels[loop.header]);
+            prev = std::move(map);
+        }
+        redirectBackEdge(loop, prev, guard->blockId);
+        for (size_t i = 0; i < phis.size(); ++i)
+            guardPhis[i]->addIncoming(
+                prev.mapValue(incomingFrom(phis[i], latch)), getLabelOperand(prev.labels[latch]));
+
+        // 第 count - 1 份迭代的退出判断成立时，由单调性前面各份的判断也都成立
+        Operand* cond = getRegOperand(function->getNewRegId());
+        guard->insertBack(new IcmpInst(DataType::I32, induction.pred, guardValues[induction.phi->res], limit, cond));
+        guard->insertBack(new BrCondInst(cond, getLabelOperand(first), getLabelOperand(loop.header)));
+
+        // 原循环作为余数循环，从 guard (以及 check) 进入
+        retarget(preheader, loop.header, check ? check->blockId : guard->blockId);
+        Operand* oldLabel = getLabelOperand(preheader);
+        for (auto* phi : phis)
+        {
+            Operand* init = incomingFrom(phi, preheader);
+            phi->incomingVals.erase(oldLabel);
+            phi->addIncoming(guardValues[phi->res], getLabelOperand(guard->blockId));
+            if (check) phi->addIncoming(init, getLabelOperand(check->blockId));
+        }
+        return guard->blockId;
+    }
+
+    bool LoopUnrollPass::matchInduction(Analysis::Loop& loop, Induction& induction)
+    {
+        std::unordered_map<Operand*, Instruction*> defs;
+        for (size_t id : loop.blocks)
+            for (auto* inst : cfg->getBlock(id)->insts)
+                if (Operand* def = getDefOperand(*inst)) defs[def] = inst;
+
+        Instruction* term = Analysis::CFG::getTerminator(cfg->getBlock(loop.header));
+        if (!term || term->opcode != Operator::BR_COND) return false;
+        auto* br = static_cast<BrCondInst*>(term);
+        auto  it = defs.find(br->cond);
+        if (it == defs.end() || it->second->opcode != Operator::ICMP) return false;
+        auto* cmp = static_cast<IcmpInst*>(it->second);
+        if (cmp->dt != DataType::I32) return false;
+
+        // 规范为 "value pred bound 成立时留在循环内"，bound 须在循环外定义
+        ICmpOp   pred  = cmp->cond;
+        Operand* value = cmp->lhs;
+        Operand* bound = cmp->rhs;
+        if (!defs.count(value))
+        {
+            std::swap(value, bound);
+            pred = swapPredicate(pred);
+        }
+        if (defs.count(bound)) return false;
+        if (!loop.contains(labelOf(br->trueTar))) pred = invertPredicate(pred);
+
+        auto*       scev = Analysis::AM.get<Analysis::ScalarEvolution>(*function);
+        const auto* expr = scev->getSCEV(value);
+        if (!expr->isAddRec() || expr->loop != &loop || !expr->getStep()->isConstant()) return false;
+        // 只有比较方向与步长一致的 slt/sle/sgt/sge 对迭代次数单调
+        long long step = expr->getStep()->constant;
+        bool      up   = pred == ICmpOp::SLT || pred == ICmpOp::SLE;
+        bool      down = pred == ICmpOp::SGT || pred == ICmpOp::SGE;
+        if (!(up && step > 0) && !(down && step < 0)) return false;
+
+        // 找到与 value 相差常数的 header phi，guard 中由它算出 value
+        for (auto* phi : headerPhis(cfg->getBlock(loop.header)))
+        {
+            if (phi->dt != DataType::I32) continue;
+            const auto* diff = scev->getMinusExpr(expr, scev->getSCEV(phi->res));
+            if (!diff->isConstant()) continue;
+            induction.phi   = phi;
+            induction.step  = step;
+            induction.delta = diff->constant;
+            induction.pred  = pred;
+            induction.bound = bound;
+            return true;
+        }
+        return false;
+    }
+
+    bool LoopUnrollPass::isArrayInit(Analysis::Loop& loop) const
+    {
+        bool stores = false;
+        for (size_t id : loop.blocks)
+            for (auto* inst : cfg->getBlock(id)->insts)
+            {
+                if (inst->opcode == Operator::LOAD || inst->opcode == Operator::CALL) return false;
+                stores |= inst->opcode == Operator::STORE;
+            }
+        return stores;
+    }
+
+    size_t LoopUnrollPass::loopSize(Analysis::Loop& loop) const
+    {
+        size_t size = 0;
+        for (size_t id : loop.blocks) size += cfg->getBlock(id)->insts.size();
+        return size;
+    }
+
+    CloneMap LoopUnrollPass::cloneIteration(
+        Analysis::Loop& loop, const std::unordered_map<Operand*, Operand*>& phiValues, size_t exitTarget)
+    {
+        CloneMap map;
+        for (size_t id : loop.blocks) map.labels[id] = function->createBlock()->blockId;
+        for (size_t id : loop.blocks)
+            for (auto* inst : cfg->getBlock(id)->insts)
+                if (Operand* def = getDefOperand(*inst)) map.values[def] = getRegOperand(function->getNewRegId());
+        for (auto& [phi, val] : phiValues) map.values[phi] = val;
+
+        size_t exiting = loop.exitingBlocks[0];
+        for (size_t id : loop.blocks)
+        {
+            Block* copy = function->getBlock(map.labels[id]);
+            for (auto* inst : cfg->getBlock(id)->insts)
+            {
+                if (id == loop.header && inst->opcode == Operator::PHI) continue;
+                if (id == exiting && inst->opcode == Operator::BR_COND)
+                {
+                    auto*  br     = static_cast<BrCondInst*>(inst);
+                    size_t stay   = loop.contains(labelOf(br->trueTar)) ? labelOf(br->trueTar) : labelOf(br->falseTar);
+                    size_t target = exitTarget == Analysis::CFG::npos ? map.labels[stay] : exitTarget;
+                    copy->insertBack(new BrUncondInst(getLabelOperand(target)));
+                    continue;
+                }
+                copy->insertBack(cloneInstruction(*inst, map));
+            }
+        }
+        return map;
+    }
+
+    void LoopUnrollPass::redirectBackEdge(Analysis::Loop& loop, const CloneMap& map, size_t target)
+    {
+        retarget(map.labels.at(loop.latches[0]), map.labels.at(loop.header), target);
+    }
+
+    void LoopUnrollPass::retarget(size_t block, size_t from, size_t to)
+    {
+        Instruction* term = Analysis::CFG::getTerminator(function->getBlock(block));
+        if (term->opcode == Operator::BR_UNCOND)
+        {
+            auto* br = static_cast<BrUncondInst*>(term);
+            if (labelOf(br->target) == from) br->target = getLabelOperand(to);
+        }
+        else if (term->opcode == Operator::BR_COND)
+        {
+            auto* br = static_cast<BrCondInst*>(term);
+            if (labelOf(br->trueTar) == from) br->trueTar = getLabelOperand(to);
+            if (labelOf(br->falseTar) == from) br->falseTar = getLabelOperand(to);
+        }
+    }
+}  // namespace ME
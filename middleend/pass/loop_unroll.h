@@ -0,0 +1,105 @@
+#ifndef __MIDDLEEND_PASS_LOOP_UNROLL_H__
+#define __MIDDLEEND_PASS_LOOP_UNROLL_H__
+
+#include <interfaces/middleend/pass.h>
+#include <middleend/module/ir_function.h>
+#include <middleend/module/ir_block.h>
+#include <middleend/module/ir_instruction.h>
+#include <middleend/pass/analysis/cfg.h>
+#include <middleend/pass/analysis/loop_info.h>
+#include <middleend/pass/analysis/scalar_evolution.h>
+#include <middleend/visitor/utils/clone_visitor.h>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/*
+ * 循环展开 (loop-unroll)
+ * - 只处理最内层循环，要求只有一个 latch、header 只有一个循环外前驱 (不要求是专用的前置块)。
+ *   每展开一个循环后重新获取分析; 全部展开后外层循环成为最内层，也可能继续被展开。
+ * - 完全展开: ScalarEvolution::getConstantTripCount 给出常数次数 n 时 (初值与边界可以是符号，只要差为常数)，按迭代复制循环的所有块 n 份，
+ *   第 k 份中 header 的 phi 取第 k-1 份 latch 处的值 (第 0 份取初值)，exiting 块的条件跳转固定为
+ *   留在循环内 (最后一份为离开循环); 第 k 份的回边改为跳到第 k+1 份的 header。
+ *   循环外对循环内定义的值的使用替换为最后一份中的对应值，出口块 phi 的来源改为最后一份的 exiting 块。
+ * - 部分展开: header 是唯一的 exiting 块，退出条件为 "header phi 加常数 与 循环不变量 的 slt/sle/sgt/sge 比较"，
+ *   且该 phi 是步长为常数的递推 (ScalarEvolution) 时，按因子 u 展开:
+ *   新的循环头 G 用 phi 维护各 header phi 的值，判断第 u-1 次迭代的退出条件 (条件单调，因此前面 u-1 次都成立)，
+ *   成立时依次执行 u 份迭代 (其中的退出判断固定为留在循环内) 后回到 G，否则进入原循环执行余下的迭代。
+ *   G 中的判断写作 phi pred (bound - d)，不在 phi 一侧做可能回绕的加法; bound 不是常数时，
+ *   前置的 check 块在 bound - d 会溢出时直接进入原循环。常数次数不足 u 次的循环不做部分展开。
+ * - 规模限制: 完全展开要求次数与展开后的指令数不超过上限; 部分展开时因子减半直到展开后的大小不超过上限;
+ *   每个函数因展开增加的指令总数不超过 FunctionBudget。
+ *   循环内只有 store 而没有 load 与 call 时视为数组初始化循环，各项上限加倍 (完全展开次数上限为 4 倍)。
+ * - setFactor 对应命令行参数 -unroll-factor=<n>，n < 2 时不做部分展开。
+ * - 在同一函数上多次运行 (如处于 fixpoint 组中) 时保持幂等: 剩余预算与本 pass 产生的循环 (部分展开后的
+ *   新循环与余下迭代的原循环) 的 header 按函数记录，跨多次运行保留; 这些循环不再被展开，
+ *   没有可展开的循环时报告未修改。
+ */
+
+namespace ME
+{
+    class LoopUnrollPass : public FunctionPass
+    {
+      public:
+        static constexpr size_t DefaultFactor     = 4;
+        static constexpr size_t MaxFullTripCount  = 16;
+        static constexpr size_t FullUnrollSize    = 256;
+        static constexpr size_t PartialUnrollSize = 160;
+        static constexpr size_t FunctionBudget    = 4000;
+
+        LoopUnrollPass()  = default;
+        ~LoopUnrollPass() = default;
+
+        PreservedAnalyses runOnFunction(Function& function) override;
+
+        static void setFactor(size_t value) { factor = value; }
+
+      private:
+        static inline size_t factor = DefaultFactor;
+
+        // 退出条件: 留在循环内当且仅当 (phi + delta) pred bound，phi 每次迭代增加 step
+        struct Induction
+        {
+            PhiInst*  phi   = nullptr;
+            long long step  = 0;
+            long long delta = 0;
+            ICmpOp    pred  = ICmpOp::SLT;
+            Operand*  bound = nullptr;
+        };
+
+        // 跨多次运行保留的函数状态。pass 实例按工作线程划分，同一函数的多次运行可能落在不同实例上，
+        // 因此状态由所有实例共享; 同一时刻只有一个线程处理某个函数，只有查找表本身需要加锁
+        struct FunctionState
+        {
+            size_t                     budget = FunctionBudget;  // 本函数还允许因展开增加的指令数
+            std::unordered_set<size_t> created;                  // 本 pass 产生的循环的 header
+        };
+
+        static inline std::mutex                                           statesMutex;
+        static inline std::unordered_map<const Function*, FunctionState> states;
+
+        Function*      function = nullptr;
+        Analysis::CFG* cfg      = nullptr;
+        FunctionState* state    = nullptr;
+
+      private:
+        bool tryUnroll(Analysis::Loop& loop);
+        void unrollFully(Analysis::Loop& loop, size_t preheader, size_t tripCount);
+        // 返回展开后的新循环的 header 编号
+        size_t unrollPartially(Analysis::Loop& loop, size_t preheader, const Induction& induction, size_t count);
+
+        bool   matchInduction(Analysis::Loop& loop, Induction& induction);
+        bool   isArrayInit(Analysis::Loop& loop) const;
+        size_t loopSize(Analysis::Loop& loop) const;
+
+        // 复制一次迭代: header 的 phi 不复制，取 phiValues 给出的值; exiting 块的条件跳转改为无条件跳转，
+        // exitTarget 为 CFG::npos 时留在循环内，否则跳到 exitTarget。回边仍指向本份的 header，由 redirectBackEdge 修改
+        CloneMap cloneIteration(Analysis::Loop& loop, const std::unordered_map<Operand*, Operand*>& phiValues,
+            size_t exitTarget);
+        void     redirectBackEdge(Analysis::Loop& loop, const CloneMap& map, size_t target);
+        void     retarget(size_t block, size_t from, size_t to);
+    };
+}  // namespace ME
+
+#endif  // __MIDDLEEND_PASS_LOOP_UNROLL_H__
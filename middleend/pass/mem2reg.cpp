@@ -0,0 +1,196 @@
+#include <middleend/pass/mem2reg.h>
+#include <middleend/pass/analysis/analysis_manager.h>
+#include <middleend/pass/analysis/call_graph.h>
+#include <middleend/pass/analysis/control_dependence.h>
+#include <middleend/pass/analysis/dataflow.h>
+#include <middleend/pass/analysis/loop_info.h>
+#include <middleend/pass/analysis/postdominfo.h>
+#include <middleend/module/ir_operand.h>
+#include <middleend/visitor/utils/operand_visitor.h>
+#include <algorithm>
+#include <unordered_set>
+
+namespace ME
+{
+    namespace
+    {
+        // 以 alloca 为位的后向活跃性: gen 为块内先读后写的 alloca，kill 为块内写过的 alloca
+        struct SlotLiveness : Analysis::BitVectorProblem<Analysis::Direction::Backward, Analysis::MeetOp::Union>
+        {
+            const char* name() const { return "mem2reg-liveness"; }
+        };
+    }  // namespace
+
+    PreservedAnalyses Mem2RegPass::runOnFunction(Function& function)
+    {
+        auto* cfg     = Analysis::AM.get<Analysis::CFG>(function);
+        auto* domInfo = Analysis::AM.get<Analysis::DomInfo>(function);
+
+        std::vector<AllocaInst*> allocas = collectPromotable(*cfg);
+        if (allocas.empty()) return PreservedAnalyses::all();
+
+        constexpr size_t                     npos = static_cast<size_t>(-1);
+        size_t                               n    = allocas.size();
+        std::unordered_map<Operand*, size_t> index;
+        for (size_t i = 0; i < n; ++i) index[allocas[i]->res] = i;
+        auto slotOf = [&](Instruction* inst) {
+            Operand* ptr = nullptr;
+            if (inst->opcode == Operator::LOAD) ptr = static_cast<LoadInst*>(inst)->ptr;
+            if (inst->opcode == Operator::STORE) ptr = static_cast<StoreInst*>(inst)->ptr;
+            auto it = ptr ? index.find(ptr) : index.end();
+            return it == index.end() ? npos : it->second;
+        };
+
+        // 写入 alloca 的块，以及块内第一次访问为读取的块
+        std::vector<std::vector<int>> defBlocks(n);
+        std::vector<size_t>           touched(n, npos);
+        SlotLiveness                  liveness;
+        liveness.init(cfg->size(), n);
+        for (size_t id : cfg->getRPO())
+            for (auto* inst : cfg->getBlock(id)->insts)
+            {
+                size_t slot = slotOf(inst);
+                if (slot == npos) continue;
+                if (touched[slot] != id)
+                {
+                    touched[slot] = id;
+                    if (inst->opcode == Operator::LOAD) liveness.gen[id].set(slot);
+                }
+                if (inst->opcode == Operator::STORE && !liveness.kill[id].test(slot))
+                {
+                    liveness.kill[id].set(slot);
+                    defBlocks[slot].push_back(id);
+                }
+            }
+        auto live = Analysis::DataflowSolver<SlotLiveness>::solve(*cfg, liveness);
+
+        std::vector<std::vector<std::pair<PhiInst*, size_t>>> blockPhis(cfg->size());
+        for (size_t slot = 0; slot < n; ++slot)
+        {
+            std::vector<bool> liveIn(cfg->size(), false);
+            for (size_t id : cfg->getRPO()) liveIn[id] = live.in[id].test(slot);
+            for (int block : domInfo->computeIDF(defBlocks[slot], &liveIn))
+            {
+                auto* phi = new PhiInst(allocas[slot]->dt, getRegOperand(function.getNewRegId()));
+                blockPhis[block].push_back({phi, slot});
+            }
+        }
+
+        // 沿支配树重命名
+        struct Frame
+        {
+            size_t                                   block;
+            size_t                                   child = 0;
+            std::vector<std::pair<size_t, Operand*>> saved;
+        };
+
+        std::vector<Operand*> current(n);
+        for (size_t slot = 0; slot < n; ++slot)
+            current[slot] = allocas[slot]->dt == DataType::F32 ? static_cast<Operand*>(getImmeF32Operand(0.0f))
+                                                               : static_cast<Operand*>(getImmeI32Operand(0));
+        std::unordered_map<Operand*, Operand*> replacement;
+        std::unordered_set<Instruction*>       dead(allocas.begin(), allocas.end());
+        const auto&                            tree = domInfo->getDomTree();
+        std::vector<Frame>                     stack;
+
+        auto enter = [&](size_t block) {
+            Frame frame;
+            frame.block = block;
+            for (auto& [phi, slot] : blockPhis[block])
+            {
+                frame.saved.push_back({slot, current[slot]});
+                current[slot] = phi->res;
+            }
+            for (auto* inst : cfg->getBlock(block)->insts)
+            {
+                size_t slot = slotOf(inst);
+                if (slot == npos) continue;
+                dead.insert(inst);
+                if (inst->opcode == Operator::LOAD)
+                    replacement[static_cast<LoadInst*>(inst)->res] = current[slot];
+                else
+                {
+                    frame.saved.push_back({slot, current[slot]});
+                    current[slot] = static_cast<StoreInst*>(inst)->val;
+                }
+            }
+            Operand* label = getLabelOperand(block);
+            for (size_t succ : cfg->succs(block))
+                for (auto& [phi, slot] : blockPhis[succ]) phi->addIncoming(current[slot], label);
+            stack.push_back(std::move(frame));
+        };
+
+        enter(cfg->entry);
+        while (!stack.empty())
+        {
+            Frame& top = stack.back();
+            if (top.child < tree[top.block].size())
+            {
+                enter(tree[top.block][top.child++]);
+                continue;
+            }
+            for (auto it = top.saved.rbegin(); it != top.saved.rend(); ++it) current[it->first] = it->second;
+            stack.pop_back();
+        }
+
+        // load 的结果可能被另一个被提升的 load 的结果替代，沿替换链找到最终的值
+        auto resolve = [&](Operand* op) {
+            for (auto it = replacement.find(op); it != replacement.end(); it = replacement.find(op)) op = it->second;
+            return op;
+        };
+        for (size_t id : cfg->getRPO())
+        {
+            Block* block = cfg->getBlock(id);
+            for (auto it = blockPhis[id].rbegin(); it != blockPhis[id].rend(); ++it) block->insertFront(it->first);
+
+            auto& insts = block->insts;
+            for (auto* inst : insts)
+                if (!dead.count(inst))
+                    for (Operand** use : collectOperands(*inst).uses) *use = resolve(*use);
+            insts.erase(std::remove_if(insts.begin(), insts.end(), [&](Instruction* inst) { return dead.count(inst); }),
+                insts.end());
+        }
+        for (auto* inst : dead) delete inst;
+
+        // 控制流与函数对外可见的访存都没有改变
+        PreservedAnalyses pa = PreservedAnalyses::none();
+        pa.preserve<Analysis::CFG>()
+            .preserve<Analysis::DomInfo>()
+            .preserve<Analysis::PostDomInfo>()
+            .preserve<Analysis::ControlDependence>()
+            .preserve<Analysis::LoopInfo>()
+            .preserve<Analysis::CallGraph>();
+        return pa;
+    }
+
+    std::vector<AllocaInst*> Mem2RegPass::collectPromotable(Analysis::CFG& cfg)
+    {
+        std::unordered_map<Operand*, AllocaInst*> candidates;
+        for (size_t id : cfg.getRPO())
+            for (auto* inst : cfg.getBlock(id)->insts)
+            {
+                if (inst->opcode != Operator::ALLOCA) continue;
+                auto* alloca = static_cast<AllocaInst*>(inst);
+                if (alloca->dims.empty() && (alloca->dt == DataType::I32 || alloca->dt == DataType::F32))
+                    candidates[alloca->res] = alloca;
+            }
+
+        // 除了作为 load/store 的地址之外的任何使用都意味着地址逃逸
+        for (size_t id : cfg.getRPO())
+            for (auto* inst : cfg.getBlock(id)->insts)
+                for (Operand** use : collectOperands(*inst).uses)
+                {
+                    if (!candidates.count(*use)) continue;
+                    bool asAddress = inst->opcode == Operator::LOAD ||
+                                     (inst->opcode == Operator::STORE && use == &static_cast<StoreInst*>(inst)->ptr);
+                    if (!asAddress) candidates.erase(*use);
+                }
+
+        std::vector<AllocaInst*> promotable;
+        for (size_t id : cfg.getRPO())
+            for (auto* inst : cfg.getBlock(id)->insts)
+                if (inst->opcode == Operator::ALLOCA && candidates.count(static_cast<AllocaInst*>(inst)->res))
+                    promotable.push_back(static_cast<AllocaInst*>(inst));
+        return promotable;
+    }
+}  // namespace ME
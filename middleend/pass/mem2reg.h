@@ -0,0 +1,39 @@
+#ifndef __MIDDLEEND_PASS_MEM2REG_H__
+#define __MIDDLEEND_PASS_MEM2REG_H__
+
+#include <interfaces/middleend/pass.h>
+#include <middleend/module/ir_function.h>
+#include <middleend/module/ir_block.h>
+#include <middleend/module/ir_instruction.h>
+#include <middleend/pass/analysis/cfg.h>
+#include <middleend/pass/analysis/dominfo.h>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * mem2reg: 将标量 alloca 提升为 SSA 寄存器
+ * - 可提升的 alloca: 没有维度的 i32 / float，且只作为 load 的地址或 store 的地址出现 (未逃逸)。
+ * - 以 alloca 为位向量、用 DataflowSolver 求后向活跃性 (gen 为块内先读后写，kill 为块内写过)，
+ *   得到每个 alloca 的 live-in 块，由 DomInfo::computeIDF 在定义块的迭代支配边界中只保留 live-in 的块放置 phi (剪枝 SSA)。
+ * - 沿支配树 DFS 重命名: 维护每个 alloca 的当前值，load 记为当前值的别名，store 更新当前值，
+ *   离开块时填写后继中 phi 来自本块的来源。最后统一替换 load 结果的所有使用并删除 alloca/load/store。
+ *   未初始化就读取的值取 0。
+ * - 只修改块内指令，不改变控制流，也不影响函数对调用者可见的访存。
+ */
+
+namespace ME
+{
+    class Mem2RegPass : public FunctionPass
+    {
+      public:
+        Mem2RegPass()  = default;
+        ~Mem2RegPass() = default;
+
+        PreservedAnalyses runOnFunction(Function& function) override;
+
+      private:
+        std::vector<AllocaInst*> collectPromotable(Analysis::CFG& cfg);
+    };
+}  // namespace ME
+
+#endif  // __MIDDLEEND_PASS_MEM2REG_H__
@@ -0,0 +1,252 @@
+#include <middleend/pass/pass_manager.h>
+#include <middleend/pass/analysis/analysis_manager.h>
+#include <middleend/pass/analysis/call_graph.h>
+#include <middleend/pass/adce.h>
+#include <middleend/pass/gvn.h>
+#include <middleend/pass/inliner.h>
+#include <middleend/pass/licm.h>
+#include <middleend/pass/loop_unroll.h>
+#include <middleend/pass/mem2reg.h>
+#include <middleend/pass/range_simplify.h>
+#include <middleend/pass/sccp.h>
+#include <middleend/pass/simplify_cfg.h>
+#include <middleend/pass/unify_return.h>
+#include <middleend/module/ir_module.h>
+#include <middleend/module/ir_function.h>
+#include <middleend/module/ir_block.h>
+#include <algorithm>
+#include <chrono>
+#include <cctype>
+#include <iomanip>
+#include <ostream>
+
+namespace ME
+{
+    const std::map<std::string, PassManager::PassFactory>& PassManager::registry()
+    {
+        static const std::map<std::string, PassFactory> passes = {
+            {"unify-return", [] { return new UnifyReturnPass(); }},
+            {"mem2reg", [] { return new Mem2RegPass(); }},
+            {"sccp", [] { return new SCCPPass(); }},
+            {"gvn", [] { return new GVNPass(); }},
+            {"licm", [] { return new LICMPass(); }},
+            {"loop-unroll", [] { return new LoopUnrollPass(); }},
+            {"inline", [] { return new InlinerPass(); }},
+            {"adce", [] { return new ADCEPass(); }},
+            {"dce", [] { return new ADCEPass(); }},
+            {"simplifycfg", [] { return new SimplifyCFGPass(); }},
+            {"range-simplify", [] { return new RangeSimplifyPass(); }},
+        };
+        return passes;
+    }
+
+    namespace
+    {
+        // -O1/-O2/-O3 对应的预设流水线
+        // O1 只做标量清理; O2 增加内联、GVN、LICM 与区间化简; O3 再做循环展开，并在展开后重复一轮清理
+        const std::map<int, std::string> presets = {
+            {1, "unify-return,mem2reg,sccp,adce,simplifycfg"},
+            {2, "unify-return,mem2reg,sccp,inline,sccp,gvn,licm,range-simplify,adce,simplifycfg"},
+            {3, "unify-return,mem2reg,sccp,inline,sccp,gvn,licm,loop-unroll,sccp,gvn,range-simplify,adce,simplifycfg,"
+                "sccp,gvn,simplifycfg"},
+        };
+    }  // namespace
+
+    PassManager::PassManager() : pool(std::make_unique<ThreadPool>(1)) {}
+
+    void PassManager::setThreads(size_t threadCount) { pool = std::make_unique<ThreadPool>(threadCount); }
+
+    bool PassManager::parsePipeline(const std::string& text, std::string& error)
+    {
+        std::vector<PipelineEntry> entries;
+        size_t                     pos = 0;
+        if (!parseList(text, pos, entries, error)) return false;
+        if (pos != text.size())
+        {
+            error = "unexpected '" + std::string(1, text[pos]) + "' at position " + std::to_string(pos);
+            return false;
+        }
+
+        for (auto& entry : entries) pipeline.push_back(std::move(entry));
+        return true;
+    }
+
+    bool PassManager::buildPreset(int optLevel, std::string& error)
+    {
+        auto it = presets.find(optLevel);
+        if (it == presets.end()) return true;
+        return parsePipeline(it->second, error);
+    }
+
+    bool PassManager::parseList(
+        const std::string& text, size_t& pos, std::vector<PipelineEntry>& out, std::string& error)
+    {
+        while (true)
+        {
+            size_t start = pos;
+            while (pos < text.size() && (std::isalnum((unsigned char)text[pos]) || text[pos] == '-' || text[pos] == '_'))
+                ++pos;
+            std::string name = text.substr(start, pos - start);
+            if (name.empty())
+            {
+                error = "expected pass name at position " + std::to_string(start);
+                return false;
+            }
+
+            PipelineEntry entry;
+            entry.name = name;
+            if (pos < text.size() && text[pos] == '(')
+            {
+                if (name != "fixpoint")
+                {
+                    error = "unknown pass group '" + name + "'";
+                    return false;
+                }
+                ++pos;
+                if (!parseList(text, pos, entry.group, error)) return false;
+                if (pos >= text.size() || text[pos] != ')')
+                {
+                    error = "missing ')' for fixpoint group";
+                    return false;
+                }
+                ++pos;
+            }
+            else
+            {
+                auto it = registry().find(name);
+                if (it == registry().end())
+                {
+                    error = "unknown pass '" + name + "'";
+                    return false;
+                }
+                entry.factory = it->second;
+                entry.instances.emplace_back(entry.factory());
+            }
+            out.push_back(std::move(entry));
+
+            if (pos >= text.size() || text[pos] != ',') return true;
+            ++pos;
+        }
+    }
+
+    void PassManager::run(Module& module)
+    {
+        for (auto& entry : pipeline) runEntry(entry, module);
+    }
+
+    bool PassManager::runEntry(PipelineEntry& entry, Module& module)
+    {
+        if (!entry.isGroup()) return runPass(entry, module);
+
+        bool everChanged = false;
+        for (size_t iter = 0; iter < maxFixpointIterations; ++iter)
+        {
+            bool changed = false;
+            for (auto& member : entry.group) changed |= runEntry(member, module);
+            if (!changed) break;
+            everChanged = true;
+        }
+        return everChanged;
+    }
+
+    bool PassManager::runPass(PipelineEntry& entry, Module& module)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        size_t instsBefore = timePasses ? countInstructions(module) : 0;
+        auto   statsBefore = Analysis::AM.getTotalStats();
+        auto   begin       = Clock::now();
+
+        bool changed = false;
+        if (dynamic_cast<FunctionPass*>(entry.instances[0].get()))
+            changed = runFunctionPass(entry, module);
+        else
+        {
+            PreservedAnalyses pa = entry.instances[0]->runOnModule(module);
+            changed              = !pa.areAllPreserved();
+            Analysis::AM.invalidate(module, pa);
+        }
+
+        if (!timePasses) return changed;
+
+        auto       end        = Clock::now();
+        auto       statsAfter = Analysis::AM.getTotalStats();
+        PassRecord record;
+        record.name        = entry.name;
+        record.wallMs      = std::chrono::duration<double, std::milli>(end - begin).count();
+        record.instsBefore = instsBefore;
+        record.instsAfter  = countInstructions(module);
+        record.cacheHits   = statsAfter.hits - statsBefore.hits;
+        record.cacheMisses = statsAfter.misses - statsBefore.misses;
+        record.changed     = changed;
+        records.push_back(record);
+
+        return changed;
+    }
+
+    bool PassManager::runFunctionPass(PipelineEntry& entry, Module& module)
+    {
+        while (entry.instances.size() < pool->size()) entry.instances.emplace_back(entry.factory());
+
+        // 按指令条数从大到小分发，尽量避免最大的函数最后才开始运行
+        auto&               functions = module.functions;
+        std::vector<size_t> sizes(functions.size(), 0);
+        std::vector<size_t> order(functions.size());
+        for (size_t i = 0; i < functions.size(); ++i)
+        {
+            order[i] = i;
+            for (auto& [id, block] : functions[i]->blocks) sizes[i] += block->insts.size();
+        }
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return sizes[a] > sizes[b]; });
+
+        // 模块级分析汇总自所有函数体，不能在其它线程修改函数时构建; 在分发之前准备好调用图
+        Analysis::AM.get<Analysis::CallGraph>(module);
+
+        std::vector<PreservedAnalyses> results(functions.size(), PreservedAnalyses::all());
+        pool->parallelFor(order.size(), [&](size_t i) {
+            Function& function = *functions[order[i]];
+            auto*     pass     = static_cast<FunctionPass*>(entry.instances[ThreadPool::currentWorker()].get());
+            results[order[i]]  = pass->runOnFunction(function);
+            Analysis::AM.invalidateFunctionAnalyses(function, results[order[i]]);
+        });
+
+        // 模块级分析可能正被其它线程读取，等所有函数运行结束后再统一失效
+        PreservedAnalyses combined = PreservedAnalyses::all();
+        for (auto& pa : results) combined.intersect(pa);
+        Analysis::AM.invalidateModuleAnalyses(module, combined);
+        return !combined.areAllPreserved();
+    }
+
+    size_t PassManager::countInstructions(Module& module)
+    {
+        size_t count = 0;
+        for (auto* function : module.functions)
+            for (auto& [id, block] : function->blocks) count += block->insts.size();
+        return count;
+    }
+
+    void PassManager::printTimeReport(std::ostream& os) const
+    {
+        double total = 0;
+        for (auto& record : records) total += record.wallMs;
+
+        os << "===" << std::string(73, '-') << "===\n";
+        os << "                      ... Pass execution timing report ...\n";
+        os << "===" << std::string(73, '-') << "===\n";
+        os << "  Total Execution Time: " << std::fixed << std::setprecision(3) << total << " ms\n\n";
+
+        os << std::right << std::setw(12) << "Wall (ms)" << std::setw(9) << "%" << std::setw(12) << "Insts in"
+           << std::setw(12) << "Insts out" << std::setw(10) << "AM hit" << std::setw(10) << "AM miss" << "  Pass\n";
+        for (auto& record : records)
+        {
+            double percent = total > 0 ? record.wallMs * 100.0 / total : 0.0;
+            os << std::setw(12) << std::setprecision(3) << record.wallMs << std::setw(8) << std::setprecision(1)
+               << percent << "%" << std::setw(12) << record.instsBefore << std::setw(12) << record.instsAfter
+               << std::setw(10) << record.cacheHits << std::setw(10) << record.cacheMisses << "  " << record.name
+               << (record.changed ? "" : " (no change)") << "\n";
+        }
+        os << std::setw(12) << std::setprecision(3) << total << std::setw(8) << std::setprecision(1) << 100.0 << "%"
+           << std::setw(44) << "" << "  Total\n";
+        os.unsetf(std::ios_base::floatfield);
+    }
+}  // namespace ME
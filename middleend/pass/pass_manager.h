@@ -0,0 +1,95 @@
+#ifndef __MIDDLEEND_PASS_PASS_MANAGER_H__
+#define __MIDDLEEND_PASS_PASS_MANAGER_H__
+
+#include <interfaces/middleend/pass.h>
+#include <thread_pool.h>
+#include <functional>
+#include <iosfwd>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*
+ * Pass 管理器
+ *
+ * - 通过文本描述构建 pass 流水线，例如 "mem2reg,sccp,fixpoint(simplifycfg,dce)"
+ *   其中 fixpoint(...) 为不动点迭代组: 组内 pass 依次运行，直到某一轮中没有任何 pass 修改 IR
+ *   (或达到迭代上限) 为止
+ * - 通过 buildPreset(level) 使用 -O1/-O2/-O3 对应的预设流水线
+ * - pass 名称到构造函数的映射见 pass_manager.cpp 中的 registry()，新增 pass 时在此注册
+ * - 函数级 pass 通过工作窃取线程池在各函数上并发运行，线程数由 setThreads (-j) 指定。
+ *   每个工作线程持有各自的 pass 实例，pass 的成员状态不会被多个线程共享；
+ *   各函数的结果互不影响，因此输出与线程数无关
+ * - 开启 setTimePasses(true) 后记录每个 pass 的耗时、运行前后的指令条数与分析缓存命中情况，
+ *   由 printTimeReport 输出
+ */
+
+namespace ME
+{
+    class Module;
+
+    class PassManager
+    {
+      public:
+        using PassFactory = std::function<Pass*()>;
+
+        static constexpr size_t maxFixpointIterations = 16;
+
+      private:
+        struct PipelineEntry
+        {
+            std::string                        name;
+            PassFactory                        factory;
+            std::vector<std::unique_ptr<Pass>> instances;  // 按工作线程编号索引
+            std::vector<PipelineEntry>         group;
+
+            bool isGroup() const { return !factory; }
+        };
+
+        struct PassRecord
+        {
+            std::string name;
+            double      wallMs;
+            size_t      instsBefore;
+            size_t      instsAfter;
+            size_t      cacheHits;
+            size_t      cacheMisses;
+            bool        changed;
+        };
+
+        std::vector<PipelineEntry>  pipeline;
+        std::vector<PassRecord>     records;
+        bool                        timePasses = false;
+        std::unique_ptr<ThreadPool> pool;
+
+      public:
+        PassManager();
+        ~PassManager() = default;
+
+        static const std::map<std::string, PassFactory>& registry();
+
+        // 解析失败时返回 false，并将原因写入 error
+        bool parsePipeline(const std::string& text, std::string& error);
+        bool buildPreset(int optLevel, std::string& error);
+
+        void setTimePasses(bool enable) { timePasses = enable; }
+        void setThreads(size_t threadCount);
+        bool empty() const { return pipeline.empty(); }
+
+        void run(Module& module);
+        void printTimeReport(std::ostream& os) const;
+
+      private:
+        bool parseList(const std::string& text, size_t& pos, std::vector<PipelineEntry>& out, std::string& error);
+
+        // 返回该项是否修改了 IR
+        bool runEntry(PipelineEntry& entry, Module& module);
+        bool runPass(PipelineEntry& entry, Module& module);
+        bool runFunctionPass(PipelineEntry& entry, Module& module);
+
+        static size_t countInstructions(Module& module);
+    };
+}  // namespace ME
+
+#endif  // __MIDDLEEND_PASS_PASS_MANAGER_H__
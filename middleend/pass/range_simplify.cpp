@@ -0,0 +1,91 @@
+#include <middleend/pass/range_simplify.h>
+#include <middleend/pass/analysis/analysis_manager.h>
+#include <middleend/pass/analysis/call_graph.h>
+#include <middleend/pass/analysis/cfg.h>
+#include <middleend/pass/analysis/control_dependence.h>
+#include <middleend/pass/analysis/dominfo.h>
+#include <middleend/pass/analysis/loop_info.h>
+#include <middleend/pass/analysis/postdominfo.h>
+#include <middleend/module/ir_operand.h>
+#include <middleend/module/ir_utils.h>
+#include <algorithm>
+
+namespace ME
+{
+    PreservedAnalyses RangeSimplifyPass::runOnFunction(Function& function)
+    {
+        auto* cfg    = Analysis::AM.get<Analysis::CFG>(function);
+        auto* ranges = Analysis::AM.get<Analysis::RangeAnalysis>(function);
+
+        bool reduced = false;
+        bool folded  = false;
+        for (size_t id : std::vector<size_t>(cfg->getRPO()))
+        {
+            Block* block = cfg->getBlock(id);
+            for (auto* inst : block->insts)
+                if (inst->opcode == Operator::DIV || inst->opcode == Operator::MOD)
+                    reduced |= reduceDivision(static_cast<ArithmeticInst*>(inst), id, *ranges);
+            folded |= foldBranch(*cfg, id, *ranges);
+        }
+
+        if (folded)
+        {
+            Analysis::CFG::removeUnreachableBlocks(function);
+            return PreservedAnalyses::none();
+        }
+        if (!reduced) return PreservedAnalyses::all();
+
+        // 只改写了算术指令，控制流相关的分析与调用图仍然有效
+        PreservedAnalyses pa = PreservedAnalyses::none();
+        pa.preserve<Analysis::CFG>()
+            .preserve<Analysis::DomInfo>()
+            .preserve<Analysis::PostDomInfo>()
+            .preserve<Analysis::ControlDependence>()
+            .preserve<Analysis::LoopInfo>()
+            .preserve<Analysis::CallGraph>();
+        return pa;
+    }
+
+    bool RangeSimplifyPass::foldBranch(Analysis::CFG& cfg, size_t id, Analysis::RangeAnalysis& ranges)
+    {
+        Block*       block = cfg.getBlock(id);
+        Instruction* term = Analysis::CFG::getTerminator(block);
+        if (!term || term->opcode != Operator::BR_COND) return false;
+        auto* br = static_cast<BrCondInst*>(term);
+        if (br->trueTar == br->falseTar) return false;
+
+        Analysis::ConstantRange range = ranges.getRangeAt(br->cond, id);
+        if (range.isEmpty() || !range.isSingle()) return false;
+
+        Operand* taken = range.getSingle() ? br->trueTar : br->falseTar;
+        Operand* dead  = range.getSingle() ? br->falseTar : br->trueTar;
+        for (auto* inst : cfg.getBlock(labelOf(dead))->insts)
+            if (inst->opcode == Operator::PHI) static_cast<PhiInst*>(inst)->incomingVals.erase(getLabelOperand(id));
+
+        *std::find(block->insts.begin(), block->insts.end(), term) = new BrUncondInst(taken);
+        delete term;
+        return true;
+    }
+
+    bool RangeSimplifyPass::reduceDivision(ArithmeticInst* inst, size_t block, Analysis::RangeAnalysis& ranges)
+    {
+        if (inst->dt != DataType::I32 || inst->rhs->getType() != OperandType::IMMEI32) return false;
+        int divisor = static_cast<ImmeI32Operand*>(inst->rhs)->value;
+        if (divisor <= 0 || (divisor & (divisor - 1)) != 0) return false;
+        if (!ranges.getRangeAt(inst->lhs, block).isNonNegative()) return false;
+
+        int shift = 0;
+        while ((1 << shift) != divisor) ++shift;
+        if (inst->opcode == Operator::DIV)
+        {
+            inst->opcode = Operator::ASHR;
+            inst->rhs    = getImmeI32Operand(shift);
+        }
+        else
+        {
+            inst->opcode = Operator::BITAND;
+            inst->rhs    = getImmeI32Operand(divisor - 1);
+        }
+        return true;
+    }
+}  // namespace ME
@@ -0,0 +1,33 @@
+#ifndef __MIDDLEEND_PASS_RANGE_SIMPLIFY_H__
+#define __MIDDLEEND_PASS_RANGE_SIMPLIFY_H__
+
+#include <interfaces/middleend/pass.h>
+#include <middleend/module/ir_function.h>
+#include <middleend/module/ir_block.h>
+#include <middleend/module/ir_instruction.h>
+#include <middleend/pass/analysis/range_analysis.h>
+
+/*
+ * 基于值域的化简 (range-simplify)
+ * - 条件跳转的条件在该处值域为常数时改为无条件跳转，并删去被放弃的后继中 phi 来自本块的来源;
+ *   随后重建 CFG 删除因此不可达的块。
+ * - 被除数非负时，sdiv / srem 2^k 分别改写为 ashr k 与 and (2^k - 1)。
+ */
+
+namespace ME
+{
+    class RangeSimplifyPass : public FunctionPass
+    {
+      public:
+        RangeSimplifyPass()  = default;
+        ~RangeSimplifyPass() = default;
+
+        PreservedAnalyses runOnFunction(Function& function) override;
+
+      private:
+        bool foldBranch(Analysis::CFG& cfg, size_t id, Analysis::RangeAnalysis& ranges);
+        bool reduceDivision(ArithmeticInst* inst, size_t block, Analysis::RangeAnalysis& ranges);
+    };
+}  // namespace ME
+
+#endif  // __MIDDLEEND_PASS_RANGE_SIMPLIFY_H__
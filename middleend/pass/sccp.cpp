@@ -0,0 +1,595 @@
+#include <middleend/pass/sccp.h>
+#include <middleend/pass/analysis/analysis_manager.h>
+#include <middleend/pass/analysis/alias_analysis.h>
+#include <middleend/pass/analysis/call_graph.h>
+#include <middleend/pass/analysis/control_dependence.h>
+#include <middleend/pass/analysis/dominfo.h>
+#include <middleend/pass/analysis/loop_info.h>
+#include <middleend/pass/analysis/postdominfo.h>
+#include <middleend/module/ir_operand.h>
+#include <middleend/module/ir_utils.h>
+#include <middleend/visitor/utils/operand_visitor.h>
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <unordered_set>
+
+namespace ME
+{
+    namespace
+    {
+        int   intOf(Operand* op) { return static_cast<ImmeI32Operand*>(op)->value; }
+        float floatOf(Operand* op) { return static_cast<ImmeF32Operand*>(op)->value; }
+
+        Operand* zeroOf(DataType type)
+        {
+            if (type == DataType::F32) return getImmeF32Operand(0.0f);
+            return getImmeI32Operand(0);
+        }
+
+        Operand* makeInt(long long value) { return getImmeI32Operand(static_cast<int>(static_cast<unsigned>(value))); }
+
+        bool compareFloat(FCmpOp cond, float a, float b)
+        {
+            bool unordered = std::isnan(a) || std::isnan(b);
+            switch (cond)
+            {
+                case FCmpOp::OEQ: return !unordered && a == b;
+                case FCmpOp::OGT: return !unordered && a > b;
+                case FCmpOp::OGE: return !unordered && a >= b;
+                case FCmpOp::OLT: return !unordered && a < b;
+                case FCmpOp::OLE: return !unordered && a <= b;
+                case FCmpOp::ONE: return !unordered && a != b;
+                case FCmpOp::ORD: return !unordered;
+                case FCmpOp::UEQ: return unordered || a == b;
+                case FCmpOp::UGT: return unordered || a > b;
+                case FCmpOp::UGE: return unordered || a >= b;
+                case FCmpOp::ULT: return unordered || a < b;
+                case FCmpOp::ULE: return unordered || a <= b;
+                case FCmpOp::UNE: return unordered || a != b;
+                default: return unordered;
+            }
+        }
+    }  // namespace
+
+    PreservedAnalyses SCCPPass::runOnModule(Module& module)
+    {
+        collectReadOnlyGlobals(module);
+
+        PreservedAnalyses combined = PreservedAnalyses::all();
+        for (auto* function : module.functions)
+        {
+            PreservedAnalyses pa = runOnFunction(*function);
+            Analysis::AM.invalidateFunctionAnalyses(*function, pa);
+            combined.intersect(pa);
+        }
+        readOnlyGlobals.clear();
+        return combined;
+    }
+
+    void SCCPPass::collectReadOnlyGlobals(Module& module)
+    {
+        readOnlyGlobals.clear();
+        for (auto* decl : module.globalVars) readOnlyGlobals[getGlobalOperand(decl->name)] = decl;
+
+        auto* callGraph = Analysis::AM.get<Analysis::CallGraph>(module);
+        for (auto* function : module.functions)
+        {
+            auto* cfg = Analysis::AM.get<Analysis::CFG>(*function);
+            auto* aa  = Analysis::AM.get<Analysis::AliasAnalysis>(*function);
+
+            // 返回 false 表示指针来源不明，无法再认定任何全局变量只读
+            auto written = [&](Operand* ptr) {
+                const Analysis::MemoryLocation& loc = aa->getLocation(ptr);
+                if (loc.kind == Analysis::MemoryLocation::Kind::Unknown) return false;
+                if (loc.kind == Analysis::MemoryLocation::Kind::Global) readOnlyGlobals.erase(loc.base);
+                return true;
+            };
+
+            for (size_t id : cfg->getRPO())
+                for (auto* inst : cfg->getBlock(id)->insts)
+                {
+                    bool known = true;
+                    if (inst->opcode == Operator::STORE)
+                        known = written(static_cast<StoreInst*>(inst)->ptr);
+                    else if (inst->opcode == Operator::CALL)
+                    {
+                        auto* call = static_cast<CallInst*>(inst);
+                        if (!callGraph->getSummary(*call).writesArgMemory) continue;
+                        for (auto& [type, arg] : call->args)
+                        {
+                            if (type == DataType::I32 || type == DataType::F32 || type == DataType::I1) continue;
+                            known &= written(arg);
+                        }
+                    }
+                    if (!known)
+                    {
+                        readOnlyGlobals.clear();
+                        return;
+                    }
+                }
+        }
+    }
+
+    PreservedAnalyses SCCPPass::runOnFunction(Function& function)
+    {
+        initialize(function);
+        executable[cfg->entry] = true;
+        blockWork.push_back(cfg->entry);
+        do solve();
+        while (resolveUndefBranches());
+
+        bool folded  = false;
+        bool changed = rewrite(folded);
+
+        defs.clear();
+        instBlock.clear();
+        lattice.clear();
+        users.clear();
+        extraUsers.clear();
+        executableEdges.clear();
+
+        if (folded)
+        {
+            Analysis::CFG::removeUnreachableBlocks(function);
+            return PreservedAnalyses::none();
+        }
+        if (!changed) return PreservedAnalyses::all();
+
+        // 只删除了算术、比较、load 与 phi，控制流与调用关系没有改变
+        PreservedAnalyses pa = PreservedAnalyses::none();
+        pa.preserve<Analysis::CFG>()
+            .preserve<Analysis::DomInfo>()
+            .preserve<Analysis::PostDomInfo>()
+            .preserve<Analysis::ControlDependence>()
+            .preserve<Analysis::LoopInfo>()
+            .preserve<Analysis::CallGraph>();
+        return pa;
+    }
+
+    void SCCPPass::initialize(Function& function)
+    {
+        cfg       = Analysis::AM.get<Analysis::CFG>(function);
+        memorySSA = Analysis::AM.get<Analysis::MemorySSA>(function);
+        executable.assign(cfg->size(), false);
+        blockWork.clear();
+        instWork.clear();
+
+        for (size_t id : cfg->getRPO())
+            for (auto* inst : cfg->getBlock(id)->insts)
+            {
+                instBlock[inst] = id;
+                if (Operand* def = getDefOperand(*inst)) defs[def] = inst;
+            }
+        for (size_t id : cfg->getRPO())
+            for (auto* inst : cfg->getBlock(id)->insts)
+                for (Operand** use : collectOperands(*inst).uses)
+                    if (defs.count(*use)) users[*use].push_back(inst);
+    }
+
+    void SCCPPass::solve()
+    {
+        while (!blockWork.empty() || !instWork.empty())
+        {
+            while (!instWork.empty())
+            {
+                Instruction* inst = instWork.back();
+                instWork.pop_back();
+                size_t block = instBlock[inst];
+                if (executable[block]) visit(inst, block);
+            }
+            if (blockWork.empty()) break;
+
+            size_t block = blockWork.back();
+            blockWork.pop_back();
+            for (auto* inst : cfg->getBlock(block)->insts) visit(inst, block);
+        }
+    }
+
+    bool SCCPPass::resolveUndefBranches()
+    {
+        // 到达不动点后条件仍为 Undef 的跳转 (条件只取决于不可达路径上的值) 保守地认为两个方向都可执行
+        bool resolved = false;
+        for (size_t id : cfg->getRPO())
+        {
+            if (!executable[id]) continue;
+            Instruction* term = Analysis::CFG::getTerminator(cfg->getBlock(id));
+            if (!term || term->opcode != Operator::BR_COND) continue;
+            auto* br = static_cast<BrCondInst*>(term);
+            if (!getValue(br->cond).isUndef()) continue;
+            for (Operand* target : {br->trueTar, br->falseTar})
+            {
+                size_t to = labelOf(target);
+                if (executableEdges.count({id, to})) continue;
+                markEdge(id, to);
+                resolved = true;
+            }
+        }
+        return resolved;
+    }
+
+    SCCPPass::LatticeValue SCCPPass::getValue(Operand* op)
+    {
+        if (op->getType() == OperandType::IMMEI32 || op->getType() == OperandType::IMMEF32)
+            return LatticeValue::constant(op);
+        if (!defs.count(op)) return LatticeValue::overdefined();
+        return lattice[op];
+    }
+
+    void SCCPPass::update(Operand* def, LatticeValue value)
+    {
+        // 与旧值取交，保证格上的值只降不升 (load 的求值依赖查找路径，未必单调)
+        LatticeValue& old = lattice[def];
+        if (value.isUndef() || old.isOverdefined()) return;
+        if (old.isConst() && (value.isOverdefined() || value.value != old.value))
+            value = LatticeValue::overdefined();
+        else if (old.isConst())
+            return;
+
+        old = value;
+        for (auto* user : users[def]) instWork.push_back(user);
+    }
+
+    void SCCPPass::markEdge(size_t from, size_t to)
+    {
+        if (!executableEdges.insert({from, to}).second) return;
+        if (!executable[to])
+        {
+            executable[to] = true;
+            blockWork.push_back(to);
+            return;
+        }
+        // 块已经求值过，新的可执行入边只影响其中的 phi
+        for (auto* inst : cfg->getBlock(to)->insts)
+        {
+            if (inst->opcode != Operator::PHI) break;
+            instWork.push_back(inst);
+        }
+    }
+
+    void SCCPPass::addUser(Operand* op, Instruction* user)
+    {
+        if (!defs.count(op) || !extraUsers.insert({op, user}).second) return;
+        users[op].push_back(user);
+    }
+
+    void SCCPPass::visit(Instruction* inst, size_t block)
+    {
+        switch (inst->opcode)
+        {
+            case Operator::BR_UNCOND:
+                markEdge(block, labelOf(static_cast<BrUncondInst*>(inst)->target));
+                return;
+            case Operator::BR_COND:
+            {
+                auto*        br   = static_cast<BrCondInst*>(inst);
+                LatticeValue cond = getValue(br->cond);
+                if (cond.isUndef()) return;
+                if (cond.isOverdefined() || intOf(cond.value))
+                    markEdge(block, labelOf(br->trueTar));
+                if (cond.isOverdefined() || !intOf(cond.value))
+                    markEdge(block, labelOf(br->falseTar));
+                return;
+            }
+            case Operator::PHI: visitPhi(static_cast<PhiInst*>(inst), block); return;
+            case Operator::LOAD: visitLoad(static_cast<LoadInst*>(inst)); return;
+            default: break;
+        }
+
+        Operand* def = getDefOperand(*inst);
+        if (!def) return;
+        update(def, fold(inst));
+    }
+
+    void SCCPPass::visitPhi(PhiInst* phi, size_t block)
+    {
+        LatticeValue result;
+        for (auto& [label, val] : phi->incomingVals)
+        {
+            if (!executableEdges.count({labelOf(label), block})) continue;
+            LatticeValue in = getValue(val);
+            if (in.isUndef()) continue;
+            if (in.isOverdefined() || (result.isConst() && result.value != in.value))
+            {
+                result = LatticeValue::overdefined();
+                break;
+            }
+            result = in;
+        }
+        update(phi->res, result);
+    }
+
+    void SCCPPass::visitLoad(LoadInst* load)
+    {
+        Address addr = resolveAddress(load->ptr, load);
+        if (addr.state == LatticeValue::State::Undef) return;
+        if (addr.state == LatticeValue::State::Overdefined) return update(load->res, LatticeValue::overdefined());
+
+        auto global = readOnlyGlobals.find(addr.base);
+        if (global != readOnlyGlobals.end())
+            return update(load->res, loadFromGlobal(global->second, addr.offset, load->dt));
+
+        auto baseDef = defs.find(addr.base);
+        if (baseDef == defs.end() || baseDef->second->opcode != Operator::ALLOCA)
+            return update(load->res, LatticeValue::overdefined());
+
+        // 沿 MemorySSA 向上找到写入同一元素的访问; 地址不是常量的 store 可能写入任意元素
+        Analysis::MemoryAccess* acc = memorySSA->getMemoryAccess(load)->defining;
+        while (true)
+        {
+            acc = memorySSA->getClobberingAccess(acc, load->ptr);
+            if (!acc->isDef()) break;
+
+            if (acc->inst->opcode == Operator::STORE)
+            {
+                auto*   store = static_cast<StoreInst*>(acc->inst);
+                Address dest  = resolveAddress(store->ptr, load);
+                if (dest.state != LatticeValue::State::Const || dest.base != addr.base) break;
+                if (dest.offset == addr.offset)
+                {
+                    if (store->dt != load->dt) break;
+                    addUser(store->val, load);
+                    return update(load->res, getValue(store->val));
+                }
+            }
+            else
+            {
+                auto* call = static_cast<CallInst*>(acc->inst);
+                if (call->funcName.rfind("llvm.memset", 0) != 0 || call->args.size() < 3) break;
+                Address      dest  = resolveAddress(call->args[0].second, load);
+                LatticeValue value = getValue(call->args[1].second);
+                LatticeValue bytes = getValue(call->args[2].second);
+                if (dest.state != LatticeValue::State::Const) break;
+                if (dest.base == addr.base)
+                {
+                    if (!value.isConst() || !bytes.isConst() || intOf(value.value) != 0) break;
+                    long long count = intOf(bytes.value) / 4;
+                    if (addr.offset < dest.offset || addr.offset >= dest.offset + count) break;
+                    return update(load->res, LatticeValue::constant(zeroOf(load->dt)));
+                }
+            }
+            acc = acc->defining;
+        }
+        update(load->res, LatticeValue::overdefined());
+    }
+
+    SCCPPass::Address SCCPPass::resolveAddress(Operand* ptr, Instruction* user)
+    {
+        Address addr;
+        addr.state = LatticeValue::State::Const;
+        while (true)
+        {
+            if (ptr->getType() == OperandType::GLOBAL)
+            {
+                addr.base = ptr;
+                return addr;
+            }
+            auto it = defs.find(ptr);
+            if (it != defs.end() && it->second->opcode == Operator::ALLOCA)
+            {
+                addr.base = ptr;
+                return addr;
+            }
+            if (it == defs.end() || it->second->opcode != Operator::GETELEMENTPTR) break;
+
+            // 第 j 个下标的步长为 dims[j..] 的乘积
+            auto* gep = static_cast<GEPInst*>(it->second);
+            for (size_t j = 0; j < gep->idxs.size(); ++j)
+            {
+                long long stride = 1;
+                for (size_t k = j; k < gep->dims.size(); ++k) stride *= gep->dims[k];
+
+                addUser(gep->idxs[j], user);
+                LatticeValue idx = getValue(gep->idxs[j]);
+                if (idx.isUndef())
+                {
+                    addr.state = LatticeValue::State::Undef;
+                    continue;
+                }
+                if (idx.isOverdefined() || idx.value->getType() != OperandType::IMMEI32)
+                    return Address{LatticeValue::State::Overdefined, nullptr, 0};
+                addr.offset += stride * intOf(idx.value);
+            }
+            ptr = gep->basePtr;
+        }
+        return Address{LatticeValue::State::Overdefined, nullptr, 0};
+    }
+
+    SCCPPass::LatticeValue SCCPPass::loadFromGlobal(GlbVarDeclInst* decl, long long offset, DataType type)
+    {
+        if (decl->dt != type) return LatticeValue::overdefined();
+
+        const auto& dims = decl->initList.arrayDims;
+        if (dims.empty())
+        {
+            if (offset != 0) return LatticeValue::overdefined();
+            if (!decl->init) return LatticeValue::constant(zeroOf(type));
+            OperandType expected = type == DataType::F32 ? OperandType::IMMEF32 : OperandType::IMMEI32;
+            if (decl->init->getType() != expected) return LatticeValue::overdefined();
+            return LatticeValue::constant(decl->init);
+        }
+
+        long long total = 1;
+        for (int dim : dims) total *= dim;
+        if (offset < 0 || offset >= total) return LatticeValue::overdefined();
+
+        // 全零的数组可能没有展开初始化列表
+        const auto& values = decl->initList.initList;
+        if (static_cast<size_t>(offset) >= values.size()) return LatticeValue::constant(zeroOf(type));
+        if (type == DataType::F32) return LatticeValue::constant(getImmeF32Operand(values[offset].getFloat()));
+        return LatticeValue::constant(getImmeI32Operand(values[offset].getInt()));
+    }
+
+    SCCPPass::LatticeValue SCCPPass::fold(Instruction* inst)
+    {
+        auto operandsOf = [&](std::initializer_list<Operand*> ops, std::vector<Operand*>& out) {
+            LatticeValue::State state = LatticeValue::State::Const;
+            for (Operand* op : ops)
+            {
+                LatticeValue value = getValue(op);
+                if (value.isOverdefined()) return LatticeValue::State::Overdefined;
+                if (value.isUndef()) state = LatticeValue::State::Undef;
+                out.push_back(value.value);
+            }
+            return state;
+        };
+
+        std::vector<Operand*> c;
+        switch (inst->opcode)
+        {
+            case Operator::ADD:
+            case Operator::SUB:
+            case Operator::MUL:
+            case Operator::DIV:
+            case Operator::MOD:
+            case Operator::BITXOR:
+            case Operator::BITAND:
+            case Operator::SHL:
+            case Operator::ASHR:
+            case Operator::LSHR:
+            {
+                auto* arith = static_cast<ArithmeticInst*>(inst);
+                auto  state = operandsOf({arith->lhs, arith->rhs}, c);
+                if (state != LatticeValue::State::Const) return {state, nullptr};
+                if (c[0]->getType() != OperandType::IMMEI32 || c[1]->getType() != OperandType::IMMEI32) break;
+
+                long long a = intOf(c[0]), b = intOf(c[1]);
+                switch (inst->opcode)
+                {
+                    case Operator::ADD: return LatticeValue::constant(makeInt(a + b));
+                    case Operator::SUB: return LatticeValue::constant(makeInt(a - b));
+                    case Operator::MUL: return LatticeValue::constant(makeInt(a * b));
+                    case Operator::BITXOR: return LatticeValue::constant(makeInt(a ^ b));
+                    case Operator::BITAND: return LatticeValue::constant(makeInt(a & b));
+                    case Operator::DIV:
+                    case Operator::MOD:
+                        if (b == 0 || (a == INT_MIN && b == -1)) break;
+                        return LatticeValue::constant(makeInt(inst->opcode == Operator::DIV ? a / b : a % b));
+                    default:
+                        if (b < 0 || b >= 32) break;
+                        if (inst->opcode == Operator::SHL) return LatticeValue::constant(makeInt(a << b));
+                        if (inst->opcode == Operator::ASHR) return LatticeValue::constant(makeInt(a >> b));
+                        return LatticeValue::constant(makeInt(static_cast<unsigned>(a) >> b));
+                }
+                break;
+            }
+            case Operator::FADD:
+            case Operator::FSUB:
+            case Operator::FMUL:
+            case Operator::FDIV:
+            {
+                auto* arith = static_cast<ArithmeticInst*>(inst);
+                auto  state = operandsOf({arith->lhs, arith->rhs}, c);
+                if (state != LatticeValue::State::Const) return {state, nullptr};
+                if (c[0]->getType() != OperandType::IMMEF32 || c[1]->getType() != OperandType::IMMEF32) break;
+
+                float a = floatOf(c[0]), b = floatOf(c[1]), r = 0.0f;
+                switch (inst->opcode)
+                {
+                    case Operator::FADD: r = a + b; break;
+                    case Operator::FSUB: r = a - b; break;
+                    case Operator::FMUL: r = a * b; break;
+                    default: r = a / b; break;
+                }
+                if (!std::isfinite(r)) break;
+                return LatticeValue::constant(getImmeF32Operand(r));
+            }
+            case Operator::ICMP:
+            {
+                auto* icmp  = static_cast<IcmpInst*>(inst);
+                auto  state = operandsOf({icmp->lhs, icmp->rhs}, c);
+                if (state != LatticeValue::State::Const) return {state, nullptr};
+                if (c[0]->getType() != OperandType::IMMEI32 || c[1]->getType() != OperandType::IMMEI32) break;
+                return LatticeValue::constant(getImmeI32Operand(evaluateICmp(icmp->cond, intOf(c[0]), intOf(c[1]))));
+            }
+            case Operator::FCMP:
+            {
+                auto* fcmp  = static_cast<FcmpInst*>(inst);
+                auto  state = operandsOf({fcmp->lhs, fcmp->rhs}, c);
+                if (state != LatticeValue::State::Const) return {state, nullptr};
+                if (c[0]->getType() != OperandType::IMMEF32 || c[1]->getType() != OperandType::IMMEF32) break;
+                return LatticeValue::constant(
+                    getImmeI32Operand(compareFloat(fcmp->cond, floatOf(c[0]), floatOf(c[1]))));
+            }
+            case Operator::ZEXT:
+            {
+                auto state = operandsOf({static_cast<ZextInst*>(inst)->src}, c);
+                if (state != LatticeValue::State::Const) return {state, nullptr};
+                if (c[0]->getType() != OperandType::IMMEI32) break;
+                return LatticeValue::constant(c[0]);
+            }
+            case Operator::SITOFP:
+            {
+                auto state = operandsOf({static_cast<SI2FPInst*>(inst)->src}, c);
+                if (state != LatticeValue::State::Const) return {state, nullptr};
+                if (c[0]->getType() != OperandType::IMMEI32) break;
+                return LatticeValue::constant(getImmeF32Operand(static_cast<float>(intOf(c[0]))));
+            }
+            case Operator::FPTOSI:
+            {
+                auto state = operandsOf({static_cast<FP2SIInst*>(inst)->src}, c);
+                if (state != LatticeValue::State::Const) return {state, nullptr};
+                if (c[0]->getType() != OperandType::IMMEF32) break;
+                float value = floatOf(c[0]);
+                // 超出 i32 范围的转换结果是 poison，不折叠
+                if (!(value > -2147483904.0f && value < 2147483648.0f)) break;
+                return LatticeValue::constant(getImmeI32Operand(static_cast<int>(value)));
+            }
+            default: break;
+        }
+        return LatticeValue::overdefined();
+    }
+
+    bool SCCPPass::rewrite(bool& folded)
+    {
+        std::unordered_map<Operand*, Operand*> replacement;
+        std::unordered_set<Instruction*>       dead;
+        for (size_t id : cfg->getRPO())
+        {
+            if (!executable[id]) continue;
+            for (auto* inst : cfg->getBlock(id)->insts)
+            {
+                Operand* def = getDefOperand(*inst);
+                if (!def || inst->opcode == Operator::CALL) continue;
+                LatticeValue value = getValue(def);
+                if (!value.isConst()) continue;
+                replacement[def] = value.value;
+                dead.insert(inst);
+            }
+        }
+
+        for (size_t id : std::vector<size_t>(cfg->getRPO()))
+        {
+            Block* block = cfg->getBlock(id);
+            auto&  insts = block->insts;
+            for (auto* inst : insts)
+                for (Operand** use : collectOperands(*inst).uses)
+                {
+                    auto it = replacement.find(*use);
+                    if (it != replacement.end()) *use = it->second;
+                }
+            insts.erase(std::remove_if(insts.begin(), insts.end(), [&](Instruction* inst) { return dead.count(inst); }),
+                insts.end());
+
+            if (!executable[id]) continue;
+            Instruction* term = Analysis::CFG::getTerminator(block);
+            if (!term || term->opcode != Operator::BR_COND) continue;
+            auto* br = static_cast<BrCondInst*>(term);
+            if (br->cond->getType() != OperandType::IMMEI32) continue;
+
+            Operand* taken = intOf(br->cond) ? br->trueTar : br->falseTar;
+            Operand* lost  = intOf(br->cond) ? br->falseTar : br->trueTar;
+            if (lost != taken)
+                for (auto* inst : cfg->getBlock(labelOf(lost))->insts)
+                    if (inst->opcode == Operator::PHI)
+                        static_cast<PhiInst*>(inst)->incomingVals.erase(getLabelOperand(id));
+
+            *std::find(insts.begin(), insts.end(), term) = new BrUncondInst(taken);
+            delete term;
+            folded = true;
+        }
+        for (auto* inst : dead) delete inst;
+
+        return folded || !dead.empty();
+    }
+}  // namespace ME
@@ -0,0 +1,112 @@
+#ifndef __MIDDLEEND_PASS_SCCP_H__
+#define __MIDDLEEND_PASS_SCCP_H__
+
+#include <interfaces/middleend/pass.h>
+#include <middleend/module/ir_module.h>
+#include <middleend/module/ir_function.h>
+#include <middleend/module/ir_block.h>
+#include <middleend/module/ir_instruction.h>
+#include <middleend/pass/analysis/cfg.h>
+#include <middleend/pass/analysis/memory_ssa.h>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/*
+ * 稀疏条件常量传播 (sccp)
+ * - 格: Undef (尚未求值) > 常量 > Overdefined。同时维护可执行边: 只有入口与经由可执行边到达的块被求值，
+ *   phi 只合并来自可执行入边的值; 条件跳转的条件为常量时只有被选中的那条边可执行。
+ * - 折叠 i32 / float 的算术、icmp、fcmp、zext、fptosi、sitofp; 除以 0、移位量越界、结果非有限等情形为 Overdefined。
+ * - 经由内存传播常量 (load):
+ *   - 地址由 alloca / 全局变量经 getelementptr 得到且各下标在格上为常量时，地址记为 "基对象 + 元素偏移"。
+ *   - 基对象为整个模块中从未被写入的全局变量时，load 的值为初始化列表中对应的元素。
+ *     "从未被写入" 由 runOnModule 在所有函数上检查: 没有 store 指向它，也没有作为指针实参传给可能写形参内存的函数。
+ *   - 基对象为 alloca 时沿 MemorySSA 向上查找: 同一对象上偏移不同的 store 被跳过，偏移相同的 store 给出 load 的值;
+ *     llvm.memset 清零覆盖的元素为 0; 遇到 phi、其它调用或无法确定地址的 store 时为 Overdefined。
+ *     逃逸到调用实参中的数组由 MemorySSA 中该调用的 MemoryDef 截断，因此只有未逃逸的局部数组会被折叠。
+ *   load 依赖的下标与被读出的存储值都登记为它的使用者，这些值变化时重新对 load 求值。
+ * - 改写: 值为常量的指令 (call 除外) 的所有使用替换为立即数后删除; 条件为常量的条件跳转改为无条件跳转，
+ *   并删去被放弃的后继中 phi 来自本块的来源; 随后重建 CFG 删除不可达块。
+ * - 作为模块级 pass 在单线程上依次处理各函数; 单独调用 runOnFunction 时不把任何全局变量视为只读。
+ */
+
+namespace ME
+{
+    class SCCPPass : public ModulePass
+    {
+      public:
+        SCCPPass()  = default;
+        ~SCCPPass() = default;
+
+        PreservedAnalyses runOnModule(Module& module) override;
+        PreservedAnalyses runOnFunction(Function& function) override;
+
+      private:
+        struct LatticeValue
+        {
+            enum class State
+            {
+                Undef,
+                Const,
+                Overdefined
+            };
+
+            State    state = State::Undef;
+            Operand* value = nullptr;  // 常量时为 (已驻留的) 立即数
+
+            bool isUndef() const { return state == State::Undef; }
+            bool isConst() const { return state == State::Const; }
+            bool isOverdefined() const { return state == State::Overdefined; }
+
+            static LatticeValue constant(Operand* value) { return {State::Const, value}; }
+            static LatticeValue overdefined() { return {State::Overdefined, nullptr}; }
+        };
+
+        // 基对象 + 元素偏移
+        struct Address
+        {
+            LatticeValue::State state  = LatticeValue::State::Undef;
+            Operand*            base   = nullptr;
+            long long           offset = 0;
+        };
+
+        std::unordered_map<Operand*, GlbVarDeclInst*> readOnlyGlobals;
+
+        // 以下为处理单个函数时的状态
+        Analysis::CFG*                                          cfg       = nullptr;
+        Analysis::MemorySSA*                                    memorySSA = nullptr;
+        std::unordered_map<Operand*, Instruction*>              defs;
+        std::unordered_map<Instruction*, size_t>                instBlock;
+        std::unordered_map<Operand*, LatticeValue>              lattice;
+        std::unordered_map<Operand*, std::vector<Instruction*>> users;
+        std::set<std::pair<Operand*, Instruction*>>             extraUsers;  // 经由内存与地址登记的使用者，用于去重
+        std::vector<bool>                                       executable;
+        std::set<std::pair<size_t, size_t>>                     executableEdges;
+        std::vector<size_t>                                     blockWork;
+        std::vector<Instruction*>                               instWork;
+
+      private:
+        void collectReadOnlyGlobals(Module& module);
+
+        void initialize(Function& function);
+        void solve();
+        bool resolveUndefBranches();
+
+        LatticeValue getValue(Operand* op);
+        void         update(Operand* def, LatticeValue value);
+        void         markEdge(size_t from, size_t to);
+        void         addUser(Operand* op, Instruction* user);
+
+        void         visit(Instruction* inst, size_t block);
+        void         visitPhi(PhiInst* phi, size_t block);
+        void         visitLoad(LoadInst* load);
+        LatticeValue fold(Instruction* inst);
+        Address      resolveAddress(Operand* ptr, Instruction* user);
+        LatticeValue loadFromGlobal(GlbVarDeclInst* decl, long long offset, DataType type);
+
+        bool rewrite(bool& folded);
+    };
+}  // namespace ME
+
+#endif  // __MIDDLEEND_PASS_SCCP_H__
@@ -0,0 +1,346 @@
+#include <middleend/pass/simplify_cfg.h>
+#include <middleend/pass/analysis/analysis_manager.h>
+#include <middleend/module/ir_operand.h>
+#include <middleend/module/ir_utils.h>
+#include <middleend/visitor/utils/operand_visitor.h>
+
+namespace ME
+{
+    PreservedAnalyses SimplifyCFGPass::runOnFunction(Function& function)
+    {
+        this->function   = &function;
+        size_t numBlocks = function.blocks.size();
+
+        bool changed = false;
+        while (runRound()) changed = true;
+
+        defs.clear();
+        defBlock.clear();
+        usedOutside.clear();
+        replaced.clear();
+        touched.clear();
+
+        // 首轮重建 CFG 时可能删除了之前遗留的不可达块
+        if (!changed && function.blocks.size() == numBlocks) return PreservedAnalyses::all();
+        return PreservedAnalyses::none();
+    }
+
+    bool SimplifyCFGPass::runRound()
+    {
+        cfg.build(*function);
+        touched.assign(cfg.size(), 0);
+        defs.clear();
+        defBlock.clear();
+        usedOutside.clear();
+        replaced.clear();
+
+        const std::vector<size_t> rpo = cfg.getRPO();
+        for (size_t id : rpo)
+            for (auto* inst : cfg.getBlock(id)->insts)
+                if (Operand* def = getDefOperand(*inst))
+                {
+                    defs[def]     = inst;
+                    defBlock[def] = id;
+                }
+        for (size_t id : rpo)
+            for (auto* inst : cfg.getBlock(id)->insts)
+                for (Operand** use : collectOperands(*inst).uses)
+                {
+                    auto it = defBlock.find(*use);
+                    if (it != defBlock.end() && (it->second != id || inst->opcode == Operator::PHI))
+                        usedOutside.insert(*use);
+                }
+
+        bool changed = false;
+        for (size_t id : rpo)
+        {
+            if (touched[id]) continue;
+            bool folded = foldBranch(id);
+            changed |= folded;
+            if (mergeSuccessor(id) || forwardEmptyBlock(id) || (!folded && threadJumps(id))) changed = true;
+        }
+        if (replaced.empty()) return changed;
+
+        // 被合并的块中单来源 phi 的使用替换为其来源值; 来源值本身也可能被替换
+        auto resolve = [&](Operand* op) {
+            for (auto it = replaced.find(op); it != replaced.end(); it = replaced.find(op)) op = it->second;
+            return op;
+        };
+        for (auto& [id, block] : function->blocks)
+            for (auto* inst : block->insts)
+                for (Operand** use : collectOperands(*inst).uses) *use = resolve(*use);
+        return changed;
+    }
+
+    bool SimplifyCFGPass::foldBranch(size_t id)
+    {
+        Block*       block = cfg.getBlock(id);
+        Instruction* term  = Analysis::CFG::getTerminator(block);
+        if (!term || term->opcode != Operator::BR_COND) return false;
+
+        auto*  br   = static_cast<BrCondInst*>(term);
+        size_t keep = labelOf(br->trueTar);
+        size_t drop = labelOf(br->falseTar);
+        if (keep == drop)
+            drop = Analysis::CFG::npos;
+        else if (br->cond->getType() == OperandType::IMMEI32)
+        {
+            if (!static_cast<ImmeI32Operand*>(br->cond)->value) std::swap(keep, drop);
+        }
+        else
+            return false;
+
+        if (drop != Analysis::CFG::npos && cfg.contains(drop))
+        {
+            for (auto* inst : cfg.getBlock(drop)->insts)
+            {
+                if (inst->opcode != Operator::PHI) break;
+                static_cast<PhiInst*>(inst)->incomingVals.erase(getLabelOperand(id));
+            }
+            touched[drop] = 1;
+        }
+        block->insts.back() = new BrUncondInst(getLabelOperand(keep));
+        delete br;
+        return true;
+    }
+
+    bool SimplifyCFGPass::mergeSuccessor(size_t id)
+    {
+        Block* block   = cfg.getBlock(id);
+        bool   changed = false;
+        while (true)
+        {
+            Instruction* term = Analysis::CFG::getTerminator(block);
+            if (!term || term->opcode != Operator::BR_UNCOND) break;
+            size_t succ = labelOf(static_cast<BrUncondInst*>(term)->target);
+            if (succ == id || succ == cfg.entry || !cfg.contains(succ) || touched[succ] || cfg.preds(succ).size() != 1)
+                break;
+
+            // 链上的块只有一个前驱，CFG 中记录的前驱数在合并过程中仍然准确
+            Block* next = cfg.getBlock(succ);
+            block->insts.pop_back();
+            delete term;
+            for (auto* inst : next->insts)
+            {
+                if (inst->opcode != Operator::PHI)
+                {
+                    if (Operand* def = getDefOperand(*inst)) defBlock[def] = id;
+                    block->insts.push_back(inst);
+                    continue;
+                }
+                // 删除的 phi 同时从 defs / defBlock 中移除，本轮后续的查询不能再访问它
+                auto* phi = static_cast<PhiInst*>(inst);
+                if (!phi->incomingVals.empty()) replaced[phi->res] = phi->incomingVals.begin()->second;
+                defs.erase(phi->res);
+                defBlock.erase(phi->res);
+                delete phi;
+            }
+            next->insts.clear();
+            for (size_t s : Analysis::CFG::getSuccessorIds(block))
+                for (auto* inst : function->getBlock(s)->insts)
+                {
+                    if (inst->opcode != Operator::PHI) break;
+                    auto& incoming = static_cast<PhiInst*>(inst)->incomingVals;
+                    auto  it       = incoming.find(getLabelOperand(succ));
+                    if (it == incoming.end()) continue;
+                    Operand* val = it->second;
+                    incoming.erase(it);
+                    incoming[getLabelOperand(id)] = val;
+                }
+            function->blocks.erase(succ);
+            delete next;
+            touched[succ] = 1;
+            changed       = true;
+        }
+        if (!changed) return false;
+
+        touched[id] = 1;
+        for (size_t s : Analysis::CFG::getSuccessorIds(block))
+            if (s < touched.size()) touched[s] = 1;
+        return true;
+    }
+
+    bool SimplifyCFGPass::forwardEmptyBlock(size_t id)
+    {
+        Block* block = cfg.getBlock(id);
+        if (id == cfg.entry || block->insts.size() != 1 || block->insts.back()->opcode != Operator::BR_UNCOND)
+            return false;
+        size_t succ = labelOf(static_cast<BrUncondInst*>(block->insts.back())->target);
+        if (succ == id || !cfg.contains(succ) || touched[succ]) return false;
+
+        bool forwarded = false;
+        for (size_t pred : cfg.preds(id))
+        {
+            if (touched[pred] || !canRedirect(pred, id, succ)) continue;
+            redirect(pred, id, succ);
+            touched[pred] = 1;
+            forwarded     = true;
+        }
+        if (!forwarded) return false;
+
+        touched[id] = touched[succ] = 1;
+        return true;
+    }
+
+    bool SimplifyCFGPass::threadJumps(size_t id)
+    {
+        Instruction* term = Analysis::CFG::getTerminator(cfg.getBlock(id));
+        if (!term || term->opcode != Operator::BR_COND || !isThreadable(id)) return false;
+
+        auto*  br         = static_cast<BrCondInst*>(term);
+        size_t targets[2] = {labelOf(br->falseTar), labelOf(br->trueTar)};
+        bool   usable[2];
+        for (int i = 0; i < 2; ++i) usable[i] = targets[i] != id && cfg.contains(targets[i]) && !touched[targets[i]];
+
+        bool threaded = false;
+        for (size_t pred : cfg.preds(id))
+        {
+            if (pred == id || touched[pred]) continue;
+            int known = knownCondition(id, pred);
+            if (known < 0 || !usable[known] || !canRedirect(pred, id, targets[known])) continue;
+            redirect(pred, id, targets[known]);
+            touched[pred] = 1;
+            threaded      = true;
+        }
+        if (!threaded) return false;
+
+        touched[id] = 1;
+        for (size_t target : targets)
+            if (cfg.contains(target)) touched[target] = 1;
+        return true;
+    }
+
+    int SimplifyCFGPass::knownCondition(size_t id, size_t pred) const
+    {
+        auto*    br   = static_cast<BrCondInst*>(Analysis::CFG::getTerminator(cfg.getBlock(id)));
+        Operand* cond = br->cond;
+
+        // 本块的 phi 在 pred 边上的来源
+        auto incoming = [&](Operand* op) -> Operand* {
+            Instruction* def = localDef(op, id);
+            if (!def || def->opcode != Operator::PHI) return op;
+            auto& vals = static_cast<PhiInst*>(def)->incomingVals;
+            auto  jt   = vals.find(getLabelOperand(pred));
+            return jt == vals.end() ? nullptr : jt->second;
+        };
+        auto isConst = [](Operand* op) { return op && op->getType() == OperandType::IMMEI32; };
+        auto value   = [](Operand* op) { return static_cast<ImmeI32Operand*>(op)->value; };
+
+        if (Instruction* def = localDef(cond, id))
+        {
+            if (def->opcode == Operator::PHI)
+            {
+                Operand* val = incoming(cond);
+                return isConst(val) ? (value(val) != 0) : -1;
+            }
+            if (def->opcode != Operator::ICMP) return -1;
+            auto*    icmp = static_cast<IcmpInst*>(def);
+            Operand* lhs  = incoming(icmp->lhs);
+            Operand* rhs  = incoming(icmp->rhs);
+            if (!isConst(lhs) || !isConst(rhs)) return -1;
+            return evaluateICmp(icmp->cond, value(lhs), value(rhs));
+        }
+
+        // 前驱以同一条件跳转到本块，条件的取值由所走的边决定
+        Instruction* predTerm = Analysis::CFG::getTerminator(cfg.getBlock(pred));
+        if (!predTerm || predTerm->opcode != Operator::BR_COND) return -1;
+        auto* predBr = static_cast<BrCondInst*>(predTerm);
+        if (predBr->cond != cond) return -1;
+        bool onTrue  = labelOf(predBr->trueTar) == id;
+        bool onFalse = labelOf(predBr->falseTar) == id;
+        return onTrue == onFalse ? -1 : onTrue;
+    }
+
+    bool SimplifyCFGPass::isThreadable(size_t id) const
+    {
+        auto* br = static_cast<BrCondInst*>(Analysis::CFG::getTerminator(cfg.getBlock(id)));
+        for (auto* inst : cfg.getBlock(id)->insts)
+        {
+            if (inst == br) continue;
+            if (inst->opcode == Operator::PHI)
+            {
+                if (usedOutside.count(static_cast<PhiInst*>(inst)->res)) return false;
+                continue;
+            }
+            if (inst->opcode != Operator::ICMP) return false;
+
+            // 只允许计算跳转条件的 icmp，其操作数为常数或本块的 phi
+            auto* icmp = static_cast<IcmpInst*>(inst);
+            if (icmp->res != br->cond || usedOutside.count(icmp->res)) return false;
+            for (Operand* op : {icmp->lhs, icmp->rhs})
+            {
+                if (op->getType() == OperandType::IMMEI32) continue;
+                Instruction* def = localDef(op, id);
+                if (!def || def->opcode != Operator::PHI) return false;
+            }
+        }
+        return true;
+    }
+
+    Operand* SimplifyCFGPass::incomingThrough(PhiInst* phi, size_t pred, size_t through) const
+    {
+        auto it = phi->incomingVals.find(getLabelOperand(through));
+        if (it == phi->incomingVals.end()) return nullptr;
+
+        Operand*     val = it->second;
+        Instruction* def = localDef(val, through);
+        if (!def || def->opcode != Operator::PHI) return val;
+        auto& vals = static_cast<PhiInst*>(def)->incomingVals;
+        auto  jt   = vals.find(getLabelOperand(pred));
+        return jt == vals.end() ? nullptr : jt->second;
+    }
+
+    Instruction* SimplifyCFGPass::localDef(Operand* op, size_t id) const
+    {
+        auto it = defBlock.find(op);
+        if (it == defBlock.end() || it->second != id) return nullptr;
+        return defs.at(op);
+    }
+
+    bool SimplifyCFGPass::canRedirect(size_t pred, size_t through, size_t target) const
+    {
+        for (auto* inst : cfg.getBlock(target)->insts)
+        {
+            if (inst->opcode != Operator::PHI) break;
+            auto*    phi = static_cast<PhiInst*>(inst);
+            Operand* val = incomingThrough(phi, pred, through);
+            if (!val) return false;
+            auto it = phi->incomingVals.find(getLabelOperand(pred));
+            if (it != phi->incomingVals.end() && it->second != val) return false;
+        }
+        return true;
+    }
+
+    void SimplifyCFGPass::redirect(size_t pred, size_t through, size_t target)
+    {
+        Operand*                                   predLabel = getLabelOperand(pred);
+        std::vector<std::pair<PhiInst*, Operand*>> added;
+        for (auto* inst : cfg.getBlock(target)->insts)
+        {
+            if (inst->opcode != Operator::PHI) break;
+            auto* phi = static_cast<PhiInst*>(inst);
+            added.emplace_back(phi, incomingThrough(phi, pred, through));
+        }
+        for (auto& [phi, val] : added) phi->addIncoming(val, predLabel);
+
+        Instruction* term = Analysis::CFG::getTerminator(cfg.getBlock(pred));
+        Operand*     to   = getLabelOperand(target);
+        if (term->opcode == Operator::BR_UNCOND)
+        {
+            auto* br = static_cast<BrUncondInst*>(term);
+            if (labelOf(br->target) == through) br->target = to;
+        }
+        else if (term->opcode == Operator::BR_COND)
+        {
+            auto* br = static_cast<BrCondInst*>(term);
+            if (labelOf(br->trueTar) == through) br->trueTar = to;
+            if (labelOf(br->falseTar) == through) br->falseTar = to;
+        }
+
+        for (auto* inst : cfg.getBlock(through)->insts)
+        {
+            if (inst->opcode != Operator::PHI) break;
+            static_cast<PhiInst*>(inst)->incomingVals.erase(predLabel);
+        }
+    }
+}  // namespace ME
@@ -0,0 +1,68 @@
+#ifndef __MIDDLEEND_PASS_SIMPLIFY_CFG_H__
+#define __MIDDLEEND_PASS_SIMPLIFY_CFG_H__
+
+#include <interfaces/middleend/pass.h>
+#include <middleend/module/ir_function.h>
+#include <middleend/module/ir_block.h>
+#include <middleend/module/ir_instruction.h>
+#include <middleend/pass/analysis/cfg.h>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/*
+ * 控制流图化简 (simplifycfg)
+ * - 按轮进行，每轮在新建的 CFG 上按逆后序访问各块，依次尝试:
+ *   1) 折叠条件跳转: 条件为常数，或两个目标相同时改为无条件跳转，被放弃的后继中删去来自本块的 phi 来源;
+ *   2) 合并: 块以无条件跳转到达的后继只有它一个前驱时，后继 (其 phi 只有一个来源，直接替换为该值) 并入本块;
+ *   3) 转发空块: 只有一条无条件跳转的块 (入口除外)，其前驱直接跳到它的后继，后继的 phi 为每个前驱补上来源;
+ *      前驱已经是后继的前驱且两条路径在 phi 上的值不同时不转发;
+ *   4) 跳转穿越: 块只包含 phi、计算条件的 icmp 与条件跳转，且这些值都只在块内使用时，
+ *      若某个前驱到来的边上条件已知 (条件或 icmp 的操作数是取常数来源的 phi，或前驱以同一条件跳转到本块)，
+ *      该前驱直接跳到对应的目标。
+ * - 一轮中改变了前驱或后继的块不再参与本轮的其它变换，保证每次变换依据的 CFG 信息仍然准确;
+ *   没有变换可做时到达不动点。每轮的代价与函数大小成线性，轮数通常很少。
+ * - 不可达的块由重建 CFG 删除。
+ */
+
+namespace ME
+{
+    class SimplifyCFGPass : public FunctionPass
+    {
+      public:
+        SimplifyCFGPass()  = default;
+        ~SimplifyCFGPass() = default;
+
+        PreservedAnalyses runOnFunction(Function& function) override;
+
+      private:
+        Function*                                  function = nullptr;
+        Analysis::CFG                              cfg;
+        std::vector<char>                          touched;
+        std::unordered_map<Operand*, Instruction*> defs;
+        std::unordered_map<Operand*, size_t>       defBlock;
+        std::unordered_set<Operand*>               usedOutside;  // 在定义块之外被使用的值
+        std::unordered_map<Operand*, Operand*>     replaced;
+
+      private:
+        bool runRound();
+        bool foldBranch(size_t id);
+        bool mergeSuccessor(size_t id);
+        bool forwardEmptyBlock(size_t id);
+        bool threadJumps(size_t id);
+
+        // 返回条件在 pred -> id 这条边上的取值: 0 / 1，未知时为 -1
+        int  knownCondition(size_t id, size_t pred) const;
+        bool isThreadable(size_t id) const;
+
+        // op 在块 id 中定义时返回定义它的指令，否则 (包括已被删除的 phi) 返回 nullptr
+        Instruction* localDef(Operand* op, size_t id) const;
+
+        // pred -> through -> target 改为 pred -> target 时，target 中 phi 在新边上的值
+        Operand* incomingThrough(PhiInst* phi, size_t pred, size_t through) const;
+        bool     canRedirect(size_t pred, size_t through, size_t target) const;
+        void     redirect(size_t pred, size_t through, size_t target);
+    };
+}  // namespace ME
+
+#endif  // __MIDDLEEND_PASS_SIMPLIFY_CFG_H__
@@ -7,20 +7,26 @@
 
 namespace ME
 {
-    void UnifyReturnPass::runOnModule(Module& module)
+    PreservedAnalyses UnifyReturnPass::runOnModule(Module& module)
     {
-        for (auto* function : module.functions) unifyFunctionReturns(*function);
+        // 只使改动过的函数的分析失效; 不改变调用关系，模块级分析 (调用图) 仍然有效
+        for (auto* function : module.functions)
+        {
+            PreservedAnalyses pa = unifyFunctionReturns(*function);
+            if (!pa.areAllPreserved()) Analysis::AM.invalidateFunctionAnalyses(*function, pa);
+        }
+        return PreservedAnalyses::all();
     }
 
-    void UnifyReturnPass::runOnFunction(Function& function) { unifyFunctionReturns(function); }
+    PreservedAnalyses UnifyReturnPass::runOnFunction(Function& function) { return unifyFunctionReturns(function); }
 
-    void UnifyReturnPass::unifyFunctionReturns(Function& function)
+    PreservedAnalyses UnifyReturnPass::unifyFunctionReturns(Function& function)
     {
         auto* cfg = Analysis::AM.get<Analysis::CFG>(function);
 
         auto retInstructions = findReturnInstructions(cfg);
 
-        if (retInstructions.size() <= 1) return;
+        if (retInstructions.size() <= 1) return PreservedAnalyses::all();
 
         Block* exitBlock = function.createBlock();
 
@@ -80,18 +86,19 @@ namespace ME
             exitBlock->insertBack(finalRet);
         }
 
-        // 由于在 `if (retInstructions.size() <= 1) return;` 处没有退出
+        // 由于在 `if (retInstructions.size() <= 1) return ...;` 处没有退出
         // 我们可以确定该 pass 的执行一定向当前函数插入了新的基本块并修改了跳转关系
-        // 因此需要 invalidate 当前函数的 CFG 缓存
-        Analysis::AM.invalidate(function);
+        // 因此不保留任何分析，由调用者 invalidate 当前函数的 CFG 及依赖它的缓存
+        return PreservedAnalyses::none();
     }
 
     std::vector<RetInst*> UnifyReturnPass::findReturnInstructions(Analysis::CFG* cfg)
     {
         std::vector<RetInst*> retInstructions;
 
-        for (auto& [blockId, block] : cfg->id2block)
+        for (auto* block : cfg->id2block)
         {
+            if (!block) continue;
             for (auto* inst : block->insts)
             {
                 if (inst->opcode != Operator::RET) continue;
@@ -105,8 +112,9 @@ namespace ME
     Block* UnifyReturnPass::getBlockContaining(Function& function, Instruction* inst)
     {
         auto* cfg = Analysis::AM.get<Analysis::CFG>(function);
-        for (auto& [blockId, block] : cfg->id2block)
+        for (auto* block : cfg->id2block)
         {
+            if (!block) continue;
             auto it = std::find(block->insts.begin(), block->insts.end(), inst);
             if (it != block->insts.end()) return block;
         }
@@ -17,11 +17,11 @@ namespace ME
         UnifyReturnPass()  = default;
         ~UnifyReturnPass() = default;
 
-        void runOnModule(Module& module) override;
-        void runOnFunction(Function& function) override;
+        PreservedAnalyses runOnModule(Module& module) override;
+        PreservedAnalyses runOnFunction(Function& function) override;
 
       private:
-        void unifyFunctionReturns(Function& function);
+        PreservedAnalyses unifyFunctionReturns(Function& function);
 
         std::vector<RetInst*> findReturnInstructions(Analysis::CFG* cfg);
         Block*                getBlockContaining(Function& function, Instruction* inst);
@@ -10,6 +10,7 @@
 #include <middleend/module/ir_module.h>
 #include <debug.h>
 #include <list>
+#include <unordered_map>
 
 /*
  * Lab 3-2: 中间代码生成 (IR Generation)
@@ -30,6 +31,14 @@
  * - 变量：局部使用 alloca+store 初始化；数组索引使用 GEP（getelementptr) 取址；全局需在 Module 层声明。
  * - 控制流：为 if/while/for 构造清晰的 cond/body/step/end 等基本块，并正确连边。
  * - 调用：准备参数寄存器，必要时插入转换；根据返回类型决定是否分配返回寄存器。
+ *
+ * -fdirect-ssa (setDirectSSA(true)):
+ * - 标量局部变量/形参与短路求值的临时变量不再分配 alloca，name2reg 中记录的是一个不会出现在 IR 里的变量编号，
+ *   读写通过 readVariable / writeVariable 在各块的当前定值表上进行 (Braun et al. 的 SSA 构造)。
+ * - 前驱全部确定的块调用 sealBlock 封闭; 在未封闭块中读取变量先放置不完整的 phi，封闭时再补全入边。
+ *   已封闭的块先查各前驱，取值一致时不放置 phi。
+ * - 读取变量时插入一条 `add v, 0` 形式的复制，保持 "表达式的值在最大编号的寄存器中" 这一约定;
+ *   函数生成结束后 finishSSA 消去这些复制和平凡 phi。没有定值就读取的变量取 0。
  */
 
 namespace ME
@@ -102,6 +111,25 @@ namespace ME
         std::map<size_t, bool>                    paramPtrTab;  // if the i-th param is a pointer or not
         std::map<FE::AST::LeftValExpr*, Operand*> lval2ptr;
 
+        bool directSSA;
+        struct SSABlock
+        {
+            std::vector<size_t>                      preds;
+            bool                                     sealed = false;
+            std::unordered_map<size_t, Operand*>     defs;  // 变量 -> 块内当前值, 查找中为 nullptr
+            std::vector<std::pair<size_t, PhiInst*>> incompletePhis;
+        };
+        struct SSAState
+        {
+            std::unordered_map<size_t, DataType>   varTypes;
+            std::vector<SSABlock>                  blocks;  // 按块编号索引
+            std::vector<PhiInst*>                  phis;
+            std::vector<Instruction*>              copies;
+            std::unordered_map<Operand*, Operand*> replacement;
+
+            void clear() { *this = SSAState(); }
+        } ssa;
+
       public:
         ASTCodeGen(const std::map<FE::Sym::Entry*, FE::AST::VarAttr>& glbSymbols,
             const std::map<FE::Sym::Entry*, FE::AST::FuncDeclStmt*>&  funcDecls)
@@ -112,9 +140,13 @@ namespace ME
               name2reg(),
               reg2attr(),
               paramPtrTab(),
-              lval2ptr()
+              lval2ptr(),
+              directSSA(false),
+              ssa()
         {}
 
+        void setDirectSSA(bool enable) { directSSA = enable; }
+
       private:
         // Basic AST nodes
         void visit(FE::AST::Root& node, Module* m) override;
@@ -164,14 +196,36 @@ namespace ME
         void   enterBlock(Block* block) { curBlock = block; }
         void   enterBlock(size_t label) { curBlock = curFunc->getBlock(label); }
         void   exitBlock() { curBlock = nullptr; }
-        Block* createBlock() { return curFunc->createBlock(); }
+        Block* createBlock()
+        {
+            Block* block = curFunc->createBlock();
+            if (directSSA) ssa.blocks.resize(block->blockId + 1);
+            return block;
+        }
         Block* getBlock(size_t label) { return curFunc->getBlock(label); }
         size_t getMaxReg() { return curFunc->getMaxReg(); }
         size_t getMaxLabel() { return curFunc->getMaxLabel(); }
         size_t getNewRegId() { return curFunc->getNewRegId(); }
-        void   insert(Instruction* inst) { curBlock->insertBack(inst); }
+        void   insert(Instruction* inst)
+        {
+            if (directSSA && inst->isTerminator()) recordEdges(inst);
+            curBlock->insertBack(inst);
+        }
         void   insertToEntry(Instruction* inst) { entryBlock->insertFront(inst); }
 
+      private:
+        // 标量变量的分配与读写，-fdirect-ssa 下不生成 alloca/load/store
+        size_t createScalarVar(DataType t);
+        size_t emitLoad(DataType t, Operand* ptr, size_t resReg);  // 返回结果所在的寄存器
+        void   emitStore(DataType t, Operand* val, Operand* ptr);
+
+        void     writeVariable(size_t var, size_t block, Operand* val);
+        Operand* readVariable(size_t var, size_t block);
+        PhiInst* newPhi(size_t var, size_t block);
+        void     sealBlock(Block* block);
+        void     recordEdges(Instruction* term);
+        void     finishSSA();
+
       private:
         DataType convert(FE::AST::Type* at);
         void     handleUnaryCalc(FE::AST::ExprNode& node, FE::AST::Operator uop, Block* block, Module* m);
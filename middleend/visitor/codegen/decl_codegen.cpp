@@ -44,15 +44,14 @@ namespace ME
                 }
             }
             
-            size_t stackReg = getNewRegId();
-            AllocaInst* alloca = nullptr;
+            size_t stackReg = 0;
             if (isArray) {
-                alloca = createAllocaInst(type, stackReg, dims);
+                stackReg = getNewRegId();
+                // Insert alloca to entry block to avoid stack overflow in loops
+                insertToEntry(createAllocaInst(type, stackReg, dims));
             } else {
-                alloca = createAllocaInst(type, stackReg);
+                stackReg = createScalarVar(type == DataType::PTR ? DataType::I32 : type);
             }
-            // Insert alloca to entry block to avoid stack overflow in loops
-            insertToEntry(alloca);
             name2reg.addSymbol(lval->entry, stackReg);
             
             // Store array dims for GEP generation
@@ -92,7 +91,7 @@ namespace ME
                             for (auto* inst : insts) insert(inst);
                             valReg = getMaxReg();
                         }
-                        insert(createStoreInst(type, valReg, getRegOperand(stackReg)));
+                        emitStore(type, getRegOperand(valReg), getRegOperand(stackReg));
                     }
                 } else {
                     // Array initialization with init lists
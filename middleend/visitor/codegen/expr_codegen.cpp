@@ -172,7 +172,7 @@ namespace ME
             } else if (type == DataType::PTR || type == DataType::F32_PTR) {
                 loadType = DataType::I32;  // Default for pointer types without indexing
             }
-            insert(createLoadInst(loadType, addrOp, resReg));
+            resReg = emitLoad(loadType, addrOp, resReg);
         } else {
             // Partial array index: addrOp points to sub-array (e.g., c[0] -> [4 x i32]*)
             // Need to get pointer to first element (e.g., -> i32*)
@@ -369,15 +369,14 @@ namespace ME
             for (auto* inst : insts) insert(inst);
             rhsReg = getMaxReg();
         }
-        insert(createStoreInst(lhsType, rhsReg, addrOp));
+        emitStore(lhsType, getRegOperand(rhsReg), addrOp);
     }
 
     void ASTCodeGen::handleLogicalAnd(
         FE::AST::BinaryExpr& node, FE::AST::ExprNode& lhs, FE::AST::ExprNode& rhs, Module* m)
     {
         (void)node;
-        size_t resPtr = getNewRegId();
-        insertToEntry(createAllocaInst(DataType::I32, resPtr));
+        size_t resPtr = createScalarVar(DataType::I32);
         
         Block* rhsBB = createBlock();
         Block* trueBB = createBlock();
@@ -404,6 +403,7 @@ namespace ME
             lhsReg = i1Reg;
         }
         insert(createBranchInst(lhsReg, rhsBB->blockId, falseBB->blockId));
+        sealBlock(rhsBB);
         
         enterBlock(rhsBB);
         dispatch(&rhs, m);
@@ -416,18 +416,20 @@ namespace ME
             rhsReg = i1Reg;
         }
         insert(createBranchInst(rhsReg, trueBB->blockId, falseBB->blockId));
+        sealBlock(trueBB);
+        sealBlock(falseBB);
         
         enterBlock(trueBB);
-        insert(createStoreInst(DataType::I32, getImmeI32Operand(1), getRegOperand(resPtr)));
+        emitStore(DataType::I32, getImmeI32Operand(1), getRegOperand(resPtr));
         insert(createBranchInst(endBB->blockId));
         
         enterBlock(falseBB);
-        insert(createStoreInst(DataType::I32, getImmeI32Operand(0), getRegOperand(resPtr)));
+        emitStore(DataType::I32, getImmeI32Operand(0), getRegOperand(resPtr));
         insert(createBranchInst(endBB->blockId));
+        sealBlock(endBB);
         
         enterBlock(endBB);
-        size_t resReg = getNewRegId();
-        insert(createLoadInst(DataType::I32, getRegOperand(resPtr), resReg));
+        size_t resReg = emitLoad(DataType::I32, getRegOperand(resPtr), getNewRegId());
         // Convert i32 to i1 for conditional branches
         size_t i1Reg = getNewRegId();
         insert(createIcmpInst_ImmeRight(ICmpOp::NE, resReg, 0, i1Reg));
@@ -437,8 +439,7 @@ namespace ME
         FE::AST::BinaryExpr& node, FE::AST::ExprNode& lhs, FE::AST::ExprNode& rhs, Module* m)
     {
         (void)node;
-        size_t resPtr = getNewRegId();
-        insertToEntry(createAllocaInst(DataType::I32, resPtr));
+        size_t resPtr = createScalarVar(DataType::I32);
         
         Block* rhsBB = createBlock();
         Block* trueBB = createBlock();
@@ -465,6 +466,7 @@ namespace ME
             lhsReg = i1Reg;
         }
         insert(createBranchInst(lhsReg, trueBB->blockId, rhsBB->blockId));
+        sealBlock(rhsBB);
         
         enterBlock(rhsBB);
         dispatch(&rhs, m);
@@ -477,18 +479,20 @@ namespace ME
             rhsReg = i1Reg;
         }
         insert(createBranchInst(rhsReg, trueBB->blockId, falseBB->blockId));
+        sealBlock(trueBB);
+        sealBlock(falseBB);
         
         enterBlock(trueBB);
-        insert(createStoreInst(DataType::I32, getImmeI32Operand(1), getRegOperand(resPtr)));
+        emitStore(DataType::I32, getImmeI32Operand(1), getRegOperand(resPtr));
         insert(createBranchInst(endBB->blockId));
         
         enterBlock(falseBB);
-        insert(createStoreInst(DataType::I32, getImmeI32Operand(0), getRegOperand(resPtr)));
+        emitStore(DataType::I32, getImmeI32Operand(0), getRegOperand(resPtr));
         insert(createBranchInst(endBB->blockId));
+        sealBlock(endBB);
         
         enterBlock(endBB);
-        size_t resReg = getNewRegId();
-        insert(createLoadInst(DataType::I32, getRegOperand(resPtr), resReg));
+        size_t resReg = emitLoad(DataType::I32, getRegOperand(resPtr), getNewRegId());
         // Convert i32 to i1 for conditional branches
         size_t i1Reg = getNewRegId();
         insert(createIcmpInst_ImmeRight(ICmpOp::NE, resReg, 0, i1Reg));
@@ -0,0 +1,241 @@
+#include <middleend/visitor/codegen/ast_codegen.h>
+#include <middleend/visitor/utils/operand_visitor.h>
+#include <algorithm>
+#include <unordered_set>
+
+namespace ME
+{
+    namespace
+    {
+        Operand* undefValue(DataType t)
+        {
+            return t == DataType::F32 ? static_cast<Operand*>(getImmeF32Operand(0.0f))
+                                      : static_cast<Operand*>(getImmeI32Operand(0));
+        }
+    }  // namespace
+
+    size_t ASTCodeGen::createScalarVar(DataType t)
+    {
+        size_t reg = getNewRegId();
+        if (directSSA)
+            ssa.varTypes[reg] = t;
+        else
+            insertToEntry(createAllocaInst(t, reg));
+        return reg;
+    }
+
+    size_t ASTCodeGen::emitLoad(DataType t, Operand* ptr, size_t resReg)
+    {
+        auto it = directSSA && ptr->getType() == OperandType::REG
+                      ? ssa.varTypes.find(static_cast<RegOperand*>(ptr)->getRegNum())
+                      : ssa.varTypes.end();
+        if (it == ssa.varTypes.end())
+        {
+            insert(createLoadInst(t, ptr, resReg));
+            return resReg;
+        }
+
+        DataType type = it->second;
+        Operand* val  = readVariable(it->first, curBlock->blockId);
+        // 读取时新建的 phi 占用了更大的寄存器编号，复制的结果需要重新取号以保持在最大编号上
+        if (getMaxReg() != resReg) resReg = getNewRegId();
+        Operand* res  = getRegOperand(resReg);
+        Operator op   = type == DataType::F32 ? Operator::FADD : Operator::ADD;
+        auto*    copy = new ArithmeticInst(op, type, val, undefValue(type), res);
+        insert(copy);
+        ssa.copies.push_back(copy);
+        ssa.replacement[res] = val;
+        return resReg;
+    }
+
+    void ASTCodeGen::emitStore(DataType t, Operand* val, Operand* ptr)
+    {
+        size_t reg = directSSA && ptr->getType() == OperandType::REG ? static_cast<RegOperand*>(ptr)->getRegNum()
+                                                                     : static_cast<size_t>(-1);
+        if (ssa.varTypes.count(reg))
+            writeVariable(reg, curBlock->blockId, val);
+        else
+            insert(createStoreInst(t, val, ptr));
+    }
+
+    void ASTCodeGen::writeVariable(size_t var, size_t block, Operand* val) { ssa.blocks[block].defs[var] = val; }
+
+    PhiInst* ASTCodeGen::newPhi(size_t var, size_t block)
+    {
+        auto* phi = new PhiInst(ssa.varTypes[var], getRegOperand(getNewRegId()));
+        getBlock(block)->insertFront(phi);
+        ssa.phis.push_back(phi);
+        writeVariable(var, block, phi->res);
+        return phi;
+    }
+
+    Operand* ASTCodeGen::readVariable(size_t var, size_t block)
+    {
+        // 先查各前驱再决定是否需要 phi: 前驱的值一致时直接沿用，只有取值不同或查找绕回正在查找的块 (环) 时才放置 phi。
+        // 正在查找的块的当前值记为 nullptr; 用显式栈代替递归，很长的块链也不会耗尽栈空间
+        struct Frame
+        {
+            size_t    block;
+            size_t    next;
+            size_t    valBase;  // 各前驱的值从 vals[valBase] 开始
+            Operand** def;
+            PhiInst*  phi;
+        };
+        std::vector<Frame>    stack;
+        std::vector<Operand*> vals;
+
+        auto lookup = [&](size_t b, Operand*& val) {
+            SSABlock& state     = ssa.blocks[b];
+            auto [it, inserted] = state.defs.try_emplace(var, nullptr);
+            if (!inserted && it->second)
+                val = it->second;
+            else if (!inserted)
+            {
+                auto frame = std::find_if(stack.begin(), stack.end(), [&](const Frame& f) { return f.block == b; });
+                frame->phi = newPhi(var, b);
+                val        = frame->phi->res;
+            }
+            else if (!state.sealed)
+            {
+                PhiInst* phi = newPhi(var, b);
+                state.incompletePhis.push_back({var, phi});
+                val = phi->res;
+            }
+            else if (state.preds.empty())
+                val = it->second = undefValue(ssa.varTypes[var]);
+            else
+            {
+                stack.push_back({b, 0, vals.size(), &it->second, nullptr});
+                return false;
+            }
+            return true;
+        };
+
+        Operand* result = nullptr;
+        if (lookup(block, result)) return result;
+        while (!stack.empty())
+        {
+            Frame&      top   = stack.back();
+            const auto& preds = ssa.blocks[top.block].preds;
+            if (top.next < preds.size())
+            {
+                Operand* val = nullptr;
+                if (lookup(preds[top.next++], val)) vals.push_back(val);
+                continue;
+            }
+
+            Operand* same    = nullptr;
+            bool     differs = false;
+            for (size_t i = top.valBase; i < vals.size(); ++i)
+            {
+                if (top.phi && vals[i] == top.phi->res) continue;
+                if (!same)
+                    same = vals[i];
+                else if (vals[i] != same)
+                    differs = true;
+            }
+
+            PhiInst* phi = top.phi;
+            if (!phi && differs) phi = newPhi(var, top.block);
+            Operand* val = phi ? phi->res : same;
+            if (phi)
+                for (size_t i = 0; i < preds.size(); ++i)
+                    phi->addIncoming(vals[top.valBase + i], getLabelOperand(preds[i]));
+            // 环上的 phi 若只有一个不同于自身的入值，之后的读取直接使用该值
+            if (phi && !differs && same)
+            {
+                ssa.replacement[phi->res] = same;
+                val                       = same;
+            }
+            *top.def = val;
+
+            vals.resize(top.valBase);
+            stack.pop_back();
+            if (stack.empty())
+                result = val;
+            else
+                vals.push_back(val);
+        }
+        return result;
+    }
+
+    void ASTCodeGen::sealBlock(Block* block)
+    {
+        if (!directSSA || ssa.blocks[block->blockId].sealed) return;
+        SSABlock& state = ssa.blocks[block->blockId];
+        state.sealed    = true;
+        auto phis       = std::move(state.incompletePhis);
+        for (auto& [var, phi] : phis)
+            for (size_t pred : state.preds) phi->addIncoming(readVariable(var, pred), getLabelOperand(pred));
+    }
+
+    void ASTCodeGen::recordEdges(Instruction* term)
+    {
+        std::vector<Operand*> targets;
+        if (term->opcode == Operator::BR_COND)
+        {
+            auto* br = static_cast<BrCondInst*>(term);
+            targets  = {br->trueTar, br->falseTar};
+        }
+        else if (term->opcode == Operator::BR_UNCOND)
+            targets = {static_cast<BrUncondInst*>(term)->target};
+
+        for (auto* target : targets)
+        {
+            auto& preds = ssa.blocks[static_cast<LabelOperand*>(target)->lnum].preds;
+            if (std::find(preds.begin(), preds.end(), curBlock->blockId) == preds.end())
+                preds.push_back(curBlock->blockId);
+        }
+    }
+
+    void ASTCodeGen::finishSSA()
+    {
+        if (!directSSA) return;
+        for (auto& [id, block] : curFunc->blocks) sealBlock(block);
+
+        auto resolve = [&](Operand* op) {
+            for (auto it = ssa.replacement.find(op); it != ssa.replacement.end(); it = ssa.replacement.find(op))
+                op = it->second;
+            return op;
+        };
+
+        // 只有一个不同于自身的入值的 phi 是平凡的，用该值替代; 替代后其它 phi 可能随之变得平凡
+        std::unordered_set<Instruction*> dead(ssa.copies.begin(), ssa.copies.end());
+        for (bool changed = true; changed;)
+        {
+            changed = false;
+            for (auto* phi : ssa.phis)
+            {
+                if (dead.count(phi)) continue;
+                Operand* same    = nullptr;
+                bool     trivial = true;
+                for (auto& [label, val] : phi->incomingVals)
+                {
+                    Operand* v = resolve(val);
+                    if (v == phi->res || v == same) continue;
+                    if (same)
+                    {
+                        trivial = false;
+                        break;
+                    }
+                    same = v;
+                }
+                if (!trivial) continue;
+                ssa.replacement[phi->res] = same ? same : undefValue(phi->dt);
+                dead.insert(phi);
+                changed = true;
+            }
+        }
+
+        for (auto& [id, block] : curFunc->blocks)
+        {
+            auto& insts = block->insts;
+            insts.erase(std::remove_if(insts.begin(), insts.end(), [&](Instruction* inst) { return dead.count(inst); }),
+                insts.end());
+            for (auto* inst : insts)
+                for (Operand** use : collectOperands(*inst).uses) *use = resolve(*use);
+        }
+        for (auto* inst : dead) delete inst;
+        ssa.clear();
+    }
+}  // namespace ME
@@ -21,6 +21,7 @@ namespace ME
         
         // Create Function
         Function* func = new Function(funcDef);
+        func->parent = m;
         m->functions.push_back(func);
         enterFunc(func);
         
@@ -49,6 +50,7 @@ namespace ME
         // Create Entry Block
         entryBlock = createBlock();
         enterBlock(entryBlock);
+        sealBlock(entryBlock);
         
         // Scope for args
         name2reg.enterScope();
@@ -85,12 +87,8 @@ namespace ME
                     reg2attr[argReg] = attr;
                 } else {
                     // Scalar parameters: alloca + store (make them mutable)
-                    size_t stackReg = getNewRegId();
-                    AllocaInst* alloca = createAllocaInst(paramType, stackReg);
-                    insertToEntry(alloca);
-                    
-                    StoreInst* store = createStoreInst(paramType, argReg, getRegOperand(stackReg));
-                    insert(store);
+                    size_t stackReg = createScalarVar(paramType);
+                    emitStore(paramType, argOp, getRegOperand(stackReg));
                     
                     name2reg.addSymbol(param->entry, stackReg);
                 }
@@ -124,6 +122,7 @@ namespace ME
             }
         }
         
+        finishSSA();
         exitFunc();
     }
 
@@ -252,6 +251,7 @@ namespace ME
             // No cond -> true
             insert(createBranchInst(bodyBB->blockId));
         }
+        sealBlock(bodyBB);
         
         // Body
         enterBlock(bodyBB);
@@ -261,6 +261,9 @@ namespace ME
         if (curBlock->insts.empty() || !curBlock->insts.back()->isTerminator()) {
             insert(createBranchInst(condBB->blockId));
         }
+        // continue/break 只会出现在循环体内，此时条件块与结束块的前驱都已确定
+        sealBlock(condBB);
+        sealBlock(endBB);
         
         // End
         enterBlock(endBB);
@@ -312,6 +315,8 @@ namespace ME
             
             insert(createBranchInst(condReg, thenBB->blockId, elseBB ? elseBB->blockId : endBB->blockId));
         }
+        sealBlock(thenBB);
+        if (elseBB) sealBlock(elseBB);
         
         // Then
         enterBlock(thenBB);
@@ -324,6 +329,7 @@ namespace ME
             if (node.elseStmt) dispatch(node.elseStmt, m);
             if (curBlock->insts.empty() || !curBlock->insts.back()->isTerminator()) insert(createBranchInst(endBB->blockId));
         }
+        sealBlock(endBB);
         
         enterBlock(endBB);
     }
@@ -383,16 +389,20 @@ namespace ME
         } else {
             insert(createBranchInst(bodyBB->blockId));
         }
+        sealBlock(bodyBB);
         
         // Body
         enterBlock(bodyBB);
         if (node.body) dispatch(node.body, m);
         if (curBlock->insts.empty() || !curBlock->insts.back()->isTerminator()) insert(createBranchInst(stepBB->blockId));
+        sealBlock(stepBB);
         
         // Step
         enterBlock(stepBB);
         if (node.step) dispatch(node.step, m);
         insert(createBranchInst(condBB->blockId));
+        sealBlock(condBB);
+        sealBlock(endBB);
         
         // End
         enterBlock(endBB);
@@ -0,0 +1,130 @@
+#include <middleend/visitor/utils/clone_visitor.h>
+#include <middleend/module/ir_operand.h>
+#include <debug.h>
+
+namespace ME
+{
+    Operand* CloneMap::mapValue(Operand* op) const
+    {
+        auto it = values.find(op);
+        return it == values.end() ? op : it->second;
+    }
+
+    Operand* CloneMap::mapLabel(Operand* op) const
+    {
+        auto it = labels.find(static_cast<LabelOperand*>(op)->lnum);
+        return it == labels.end() ? op : getLabelOperand(it->second);
+    }
+
+    Instruction* InstCloner::visit(LoadInst& inst, const CloneMap& map)
+    {
+        return new LoadInst(inst.dt, map.mapValue(inst.ptr), map.mapValue(inst.res));
+    }
+
+    Instruction* InstCloner::visit(StoreInst& inst, const CloneMap& map)
+    {
+        return new StoreInst(inst.dt, map.mapValue(inst.val), map.mapValue(inst.ptr));
+    }
+
+    Instruction* InstCloner::visit(ArithmeticInst& inst, const CloneMap& map)
+    {
+        return new ArithmeticInst(
+            inst.opcode, inst.dt, map.mapValue(inst.lhs), map.mapValue(inst.rhs), map.mapValue(inst.res));
+    }
+
+    Instruction* InstCloner::visit(IcmpInst& inst, const CloneMap& map)
+    {
+        return new IcmpInst(inst.dt, inst.cond, map.mapValue(inst.lhs), map.mapValue(inst.rhs), map.mapValue(inst.res));
+    }
+
+    Instruction* InstCloner::visit(FcmpInst& inst, const CloneMap& map)
+    {
+        return new FcmpInst(inst.dt, inst.cond, map.mapValue(inst.lhs), map.mapValue(inst.rhs), map.mapValue(inst.res));
+    }
+
+    Instruction* InstCloner::visit(AllocaInst& inst, const CloneMap& map)
+    {
+        return new AllocaInst(inst.dt, map.mapValue(inst.res), inst.dims);
+    }
+
+    Instruction* InstCloner::visit(BrCondInst& inst, const CloneMap& map)
+    {
+        return new BrCondInst(map.mapValue(inst.cond), map.mapLabel(inst.trueTar), map.mapLabel(inst.falseTar));
+    }
+
+    Instruction* InstCloner::visit(BrUncondInst& inst, const CloneMap& map)
+    {
+        return new BrUncondInst(map.mapLabel(inst.target));
+    }
+
+    Instruction* InstCloner::visit(GlbVarDeclInst& inst, const CloneMap& map)
+    {
+        (void)inst;
+        (void)map;
+        ERROR("Global variable declarations cannot be cloned");
+        return nullptr;
+    }
+
+    Instruction* InstCloner::visit(CallInst& inst, const CloneMap& map)
+    {
+        CallInst::argList args;
+        for (auto& [type, arg] : inst.args) args.emplace_back(type, map.mapValue(arg));
+        return new CallInst(inst.retType, inst.funcName, args, inst.res ? map.mapValue(inst.res) : nullptr);
+    }
+
+    Instruction* InstCloner::visit(FuncDeclInst& inst, const CloneMap& map)
+    {
+        (void)inst;
+        (void)map;
+        ERROR("Function declarations cannot be cloned");
+        return nullptr;
+    }
+
+    Instruction* InstCloner::visit(FuncDefInst& inst, const CloneMap& map)
+    {
+        (void)inst;
+        (void)map;
+        ERROR("Function definitions cannot be cloned");
+        return nullptr;
+    }
+
+    Instruction* InstCloner::visit(RetInst& inst, const CloneMap& map)
+    {
+        return new RetInst(inst.rt, inst.res ? map.mapValue(inst.res) : nullptr);
+    }
+
+    Instruction* InstCloner::visit(GEPInst& inst, const CloneMap& map)
+    {
+        std::vector<Operand*> idxs;
+        for (Operand* idx : inst.idxs) idxs.push_back(map.mapValue(idx));
+        return new GEPInst(inst.dt, inst.idxType, map.mapValue(inst.basePtr), map.mapValue(inst.res), inst.dims, idxs);
+    }
+
+    Instruction* InstCloner::visit(FP2SIInst& inst, const CloneMap& map)
+    {
+        return new FP2SIInst(map.mapValue(inst.src), map.mapValue(inst.dest));
+    }
+
+    Instruction* InstCloner::visit(SI2FPInst& inst, const CloneMap& map)
+    {
+        return new SI2FPInst(map.mapValue(inst.src), map.mapValue(inst.dest));
+    }
+
+    Instruction* InstCloner::visit(ZextInst& inst, const CloneMap& map)
+    {
+        return new ZextInst(inst.from, inst.to, map.mapValue(inst.src), map.mapValue(inst.dest));
+    }
+
+    Instruction* InstCloner::visit(PhiInst& inst, const CloneMap& map)
+    {
+        auto* phi = new PhiInst(inst.dt, map.mapValue(inst.res));
+        for (auto& [label, val] : inst.incomingVals) phi->addIncoming(map.mapValue(val), map.mapLabel(label));
+        return phi;
+    }
+
+    Instruction* cloneInstruction(Instruction& inst, const CloneMap& map)
+    {
+        InstCloner cloner;
+        return apply(cloner, inst, map);
+    }
+}  // namespace ME
@@ -0,0 +1,57 @@
+#ifndef __MIDDLEEND_VISITOR_UTILS_CLONE_VISITOR_H__
+#define __MIDDLEEND_VISITOR_UTILS_CLONE_VISITOR_H__
+
+#include <middleend/ir_visitor.h>
+#include <middleend/module/ir_instruction.h>
+#include <unordered_map>
+
+/*
+ * 复制指令 (内联、循环展开等需要复制一段代码的 pass 使用)
+ * - 新指令的每个操作数 (包括结果寄存器) 按 values 映射，不在映射中的操作数 (立即数、全局变量、
+ *   被复制区域之外定义的值) 保持不变; 跳转目标与 phi 来源的标签按 labels 映射。
+ * - 复制区域中的定义应在复制前全部登记到 values 中，这样 phi 与回边上先使用后定义的值也能正确映射。
+ * - 函数定义、函数声明与全局变量不属于任何块，不能复制。
+ */
+
+namespace ME
+{
+    struct CloneMap
+    {
+        std::unordered_map<Operand*, Operand*> values;
+        std::unordered_map<size_t, size_t>     labels;
+
+        Operand* mapValue(Operand* op) const;
+        Operand* mapLabel(Operand* op) const;
+    };
+
+    using InstCloner_t = InsVisitor_t<Instruction*, const CloneMap&>;
+
+    class InstCloner : public InstCloner_t
+    {
+      public:
+        InstCloner() = default;
+
+        Instruction* visit(LoadInst&, const CloneMap&) override;
+        Instruction* visit(StoreInst&, const CloneMap&) override;
+        Instruction* visit(ArithmeticInst&, const CloneMap&) override;
+        Instruction* visit(IcmpInst&, const CloneMap&) override;
+        Instruction* visit(FcmpInst&, const CloneMap&) override;
+        Instruction* visit(AllocaInst&, const CloneMap&) override;
+        Instruction* visit(BrCondInst&, const CloneMap&) override;
+        Instruction* visit(BrUncondInst&, const CloneMap&) override;
+        Instruction* visit(GlbVarDeclInst&, const CloneMap&) override;
+        Instruction* visit(CallInst&, const CloneMap&) override;
+        Instruction* visit(FuncDeclInst&, const CloneMap&) override;
+        Instruction* visit(FuncDefInst&, const CloneMap&) override;
+        Instruction* visit(RetInst&, const CloneMap&) override;
+        Instruction* visit(GEPInst&, const CloneMap&) override;
+        Instruction* visit(FP2SIInst&, const CloneMap&) override;
+        Instruction* visit(SI2FPInst&, const CloneMap&) override;
+        Instruction* visit(ZextInst&, const CloneMap&) override;
+        Instruction* visit(PhiInst&, const CloneMap&) override;
+    };
+
+    Instruction* cloneInstruction(Instruction& inst, const CloneMap& map);
+}  // namespace ME
+
+#endif  // __MIDDLEEND_VISITOR_UTILS_CLONE_VISITOR_H__
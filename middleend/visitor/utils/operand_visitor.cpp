@@ -0,0 +1,148 @@
+#include <middleend/visitor/utils/operand_visitor.h>
+#include <middleend/module/ir_operand.h>
+
+namespace ME
+{
+    void OperandCollector::visit(LoadInst& inst, InstOperands& ops)
+    {
+        ops.uses.push_back(&inst.ptr);
+        ops.def = &inst.res;
+    }
+
+    void OperandCollector::visit(StoreInst& inst, InstOperands& ops)
+    {
+        ops.uses.push_back(&inst.val);
+        ops.uses.push_back(&inst.ptr);
+    }
+
+    void OperandCollector::visit(ArithmeticInst& inst, InstOperands& ops)
+    {
+        ops.uses.push_back(&inst.lhs);
+        ops.uses.push_back(&inst.rhs);
+        ops.def = &inst.res;
+    }
+
+    void OperandCollector::visit(IcmpInst& inst, InstOperands& ops)
+    {
+        ops.uses.push_back(&inst.lhs);
+        ops.uses.push_back(&inst.rhs);
+        ops.def = &inst.res;
+    }
+
+    void OperandCollector::visit(FcmpInst& inst, InstOperands& ops)
+    {
+        ops.uses.push_back(&inst.lhs);
+        ops.uses.push_back(&inst.rhs);
+        ops.def = &inst.res;
+    }
+
+    void OperandCollector::visit(AllocaInst& inst, InstOperands& ops) { ops.def = &inst.res; }
+
+    void OperandCollector::visit(BrCondInst& inst, InstOperands& ops) { ops.uses.push_back(&inst.cond); }
+
+    void OperandCollector::visit(BrUncondInst& inst, InstOperands& ops)
+    {
+        (void)inst;
+        (void)ops;
+    }
+
+    void OperandCollector::visit(GlbVarDeclInst& inst, InstOperands& ops)
+    {
+        (void)inst;
+        (void)ops;
+    }
+
+    void OperandCollector::visit(CallInst& inst, InstOperands& ops)
+    {
+        for (auto& arg : inst.args) ops.uses.push_back(&arg.second);
+        if (inst.res) ops.def = &inst.res;
+    }
+
+    void OperandCollector::visit(FuncDeclInst& inst, InstOperands& ops)
+    {
+        (void)inst;
+        (void)ops;
+    }
+
+    void OperandCollector::visit(FuncDefInst& inst, InstOperands& ops)
+    {
+        (void)inst;
+        (void)ops;
+    }
+
+    void OperandCollector::visit(RetInst& inst, InstOperands& ops)
+    {
+        if (inst.res) ops.uses.push_back(&inst.res);
+    }
+
+    void OperandCollector::visit(GEPInst& inst, InstOperands& ops)
+    {
+        ops.uses.push_back(&inst.basePtr);
+        for (auto& idx : inst.idxs) ops.uses.push_back(&idx);
+        ops.def = &inst.res;
+    }
+
+    void OperandCollector::visit(FP2SIInst& inst, InstOperands& ops)
+    {
+        ops.uses.push_back(&inst.src);
+        ops.def = &inst.dest;
+    }
+
+    void OperandCollector::visit(SI2FPInst& inst, InstOperands& ops)
+    {
+        ops.uses.push_back(&inst.src);
+        ops.def = &inst.dest;
+    }
+
+    void OperandCollector::visit(ZextInst& inst, InstOperands& ops)
+    {
+        ops.uses.push_back(&inst.src);
+        ops.def = &inst.dest;
+    }
+
+    void OperandCollector::visit(PhiInst& inst, InstOperands& ops)
+    {
+        for (auto& [label, val] : inst.incomingVals) ops.uses.push_back(&val);
+        ops.def = &inst.res;
+    }
+
+    InstOperands collectOperands(Instruction& inst)
+    {
+        OperandCollector collector;
+        InstOperands     ops;
+        apply(collector, inst, ops);
+        return ops;
+    }
+
+    Operand* getDefOperand(Instruction& inst)
+    {
+        switch (inst.opcode)
+        {
+            case Operator::LOAD: return static_cast<LoadInst&>(inst).res;
+            case Operator::ALLOCA: return static_cast<AllocaInst&>(inst).res;
+            case Operator::ICMP: return static_cast<IcmpInst&>(inst).res;
+            case Operator::FCMP: return static_cast<FcmpInst&>(inst).res;
+            case Operator::CALL: return static_cast<CallInst&>(inst).res;
+            case Operator::GETELEMENTPTR: return static_cast<GEPInst&>(inst).res;
+            case Operator::FPTOSI: return static_cast<FP2SIInst&>(inst).dest;
+            case Operator::SITOFP: return static_cast<SI2FPInst&>(inst).dest;
+            case Operator::ZEXT: return static_cast<ZextInst&>(inst).dest;
+            case Operator::PHI: return static_cast<PhiInst&>(inst).res;
+            case Operator::ADD:
+            case Operator::SUB:
+            case Operator::MUL:
+            case Operator::DIV:
+            case Operator::MOD:
+            case Operator::FADD:
+            case Operator::FSUB:
+            case Operator::FMUL:
+            case Operator::FDIV:
+            case Operator::BITXOR:
+            case Operator::BITAND:
+            case Operator::SHL:
+            case Operator::ASHR:
+            case Operator::LSHR: return static_cast<ArithmeticInst&>(inst).res;
+            default: return nullptr;
+        }
+    }
+}  // namespace ME
@@ -0,0 +1,57 @@
+#ifndef __MIDDLEEND_VISITOR_UTILS_OPERAND_VISITOR_H__
+#define __MIDDLEEND_VISITOR_UTILS_OPERAND_VISITOR_H__
+
+#include <middleend/ir_visitor.h>
+#include <middleend/module/ir_instruction.h>
+#include <vector>
+
+/*
+ * 收集指令的操作数
+ * - uses 为指令读取的操作数所在位置 (Operand**)，可以直接改写以替换某个使用;
+ *   phi 的各来源值、call 的各实参都按在指令中出现的顺序给出，跳转目标标签与 alloca 结果不算使用。
+ * - def 为指令写入的结果寄存器所在位置，没有结果时为 nullptr。
+ * - 只收集位置，不区分操作数类型; 调用者按需过滤 REG / 立即数 / 全局变量。
+ */
+
+namespace ME
+{
+    struct InstOperands
+    {
+        std::vector<Operand**> uses;
+        Operand**              def = nullptr;
+    };
+
+    using OperandCollector_t = InsVisitor_t<void, InstOperands&>;
+
+    class OperandCollector : public OperandCollector_t
+    {
+      public:
+        OperandCollector() = default;
+
+        void visit(LoadInst&, InstOperands&) override;
+        void visit(StoreInst&, InstOperands&) override;
+        void visit(ArithmeticInst&, InstOperands&) override;
+        void visit(IcmpInst&, InstOperands&) override;
+        void visit(FcmpInst&, InstOperands&) override;
+        void visit(AllocaInst&, InstOperands&) override;
+        void visit(BrCondInst&, InstOperands&) override;
+        void visit(BrUncondInst&, InstOperands&) override;
+        void visit(GlbVarDeclInst&, InstOperands&) override;
+        void visit(CallInst&, InstOperands&) override;
+        void visit(FuncDeclInst&, InstOperands&) override;
+        void visit(FuncDefInst&, InstOperands&) override;
+        void visit(RetInst&, InstOperands&) override;
+        void visit(GEPInst&, InstOperands&) override;
+        void visit(FP2SIInst&, InstOperands&) override;
+        void visit(SI2FPInst&, InstOperands&) override;
+        void visit(ZextInst&, InstOperands&) override;
+        void visit(PhiInst&, InstOperands&) override;
+    };
+
+    InstOperands collectOperands(Instruction& inst);
+
+    // 结果寄存器; 没有结果 (或结果不是寄存器) 时返回 nullptr
+    Operand* getDefOperand(Instruction& inst);
+}  // namespace ME
+
+#endif  // __MIDDLEEND_VISITOR_UTILS_OPERAND_VISITOR_H__
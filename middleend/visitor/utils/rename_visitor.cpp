@@ -105,7 +105,7 @@ namespace ME
     void RegRename::visit(PhiInst& inst, RegMap& rm)
     {
         renameReg(inst.res, rm);
-        std::map<Operand*, Operand*> newIncomingVals;
+        PhiInst::IncomingMap newIncomingVals;
         for (auto& [label, val] : inst.incomingVals)
         {
             Operand* newVal = val;
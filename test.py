@@ -7,7 +7,8 @@ import subprocess
 import os
 import sys
 import argparse
-from typing import Optional
+import shlex
+from typing import List, Optional
 from dataclasses import dataclass
 from contextlib import ExitStack
 
@@ -18,6 +19,7 @@ class TestConfig:
     input_file: str
     output_file: str
     opt_level: int
+    extra_flags: List[str]
     std_input: Optional[str]
     std_output: str
     act_output: str
@@ -122,12 +124,13 @@ def add_returncode(file, ret):
     return False
 
 
-def _compile_to_ir(src_file: str, target_file: str, opt_level: int, test_name: str):
+def _compile_to_ir(src_file: str, target_file: str, opt_level: int, extra_flags: List[str],
+                   test_name: str):
     """Compiles the input SysY file to LLVM IR."""
     print_test_status(test_name, "Compiling sy to ir")
     res = subprocess.run([
         "timeout", IR_TIMEOUT,
-        SYSY, src_file, "-llvm", "-o", target_file, f"-O{opt_level}"
+        SYSY, src_file, "-llvm", "-o", target_file, f"-O{opt_level}", *extra_flags
     ], stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL, check=False)
     if res.returncode == 124:
         print_test_status(test_name, "\033[93mCompile Time Limit Exceed\033[0m", final=True)
@@ -218,12 +221,13 @@ def _run_ir_and_check(test_cfg: TestConfig, test_name: str):
     return True
 
 
-def _compile_to_asm(src_file: str, target_file: str, opt_level: int, test_name: str):
+def _compile_to_asm(src_file: str, target_file: str, opt_level: int, extra_flags: List[str],
+                    test_name: str):
     """Compiles the input SysY file to RISC-V assembly."""
     print_test_status(test_name, "Compiling sy to asm")
     res = subprocess.run([
         "timeout", ASM_TIMEOUT,
-        SYSY, src_file, "-S", "-o", target_file, f"-O{opt_level}"
+        SYSY, src_file, "-S", "-o", target_file, f"-O{opt_level}", *extra_flags
     ], stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL, check=False)
     if res.returncode == 124:
         print_test_status(test_name, "\033[93mCompile Time Limit Exceed\033[0m", final=True)
@@ -309,13 +313,14 @@ def _run_riscv_and_check(test_cfg: TestConfig, test_name: str):
     return True
 
 
-def _compile_to_asm_arm(src_file: str, target_file: str, opt_level: int, test_name: str):
+def _compile_to_asm_arm(src_file: str, target_file: str, opt_level: int, extra_flags: List[str],
+                        test_name: str):
     """Compiles the input SysY file to AArch64 assembly."""
     print_test_status(test_name, "Compiling sy to asm")
     res = subprocess.run([
         "timeout", ASM_TIMEOUT,
         SYSY, src_file, "-S", "-o", target_file, f"-O{opt_level}",
-        "-march", "aarch64"
+        "-march", "aarch64", *extra_flags
     ], stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL, check=False)
     if res.returncode == 124:
         print_test_status(test_name, "\033[93mCompile Time Limit Exceed\033[0m", final=True)
@@ -402,7 +407,8 @@ def _execute_ir(test_cfg: TestConfig):
     # Print test case name at the beginning
     test_name = os.path.basename(test_cfg.input_file)
     
-    if not _compile_to_ir(test_cfg.input_file, test_cfg.output_file, test_cfg.opt_level, test_name):
+    if not _compile_to_ir(test_cfg.input_file, test_cfg.output_file, test_cfg.opt_level,
+                          test_cfg.extra_flags, test_name):
         return False
 
     if not _check_ir_syntax(test_cfg.output_file, test_cfg.input_file, test_name):
@@ -422,7 +428,8 @@ def _execute_riscv(test_cfg: TestConfig):
     """Full pipeline to compile, run, and check a SysY file via RISC-V assembly."""
     test_name = os.path.basename(test_cfg.input_file)
     
-    if not _compile_to_asm(test_cfg.input_file, test_cfg.output_file, test_cfg.opt_level, test_name):
+    if not _compile_to_asm(test_cfg.input_file, test_cfg.output_file, test_cfg.opt_level,
+                           test_cfg.extra_flags, test_name):
         return False
 
     if not _compile_asm_and_link_riscv(test_cfg.output_file, test_cfg.input_file, test_name):
@@ -439,7 +446,8 @@ def _execute_arm(test_cfg: TestConfig):
     """Full pipeline to compile, run, and check a SysY file via AArch64 assembly."""
     test_name = os.path.basename(test_cfg.input_file)
     
-    if not _compile_to_asm_arm(test_cfg.input_file, test_cfg.output_file, test_cfg.opt_level, test_name):
+    if not _compile_to_asm_arm(test_cfg.input_file, test_cfg.output_file, test_cfg.opt_level,
+                               test_cfg.extra_flags, test_name):
         return False
 
     if not _compile_asm_and_link_arm(test_cfg.output_file, test_cfg.input_file, test_name):
@@ -462,9 +470,12 @@ def main():
                         help="Test case group to run.")
     parser.add_argument("--stage", default="llvm", choices=["llvm", "riscv", "arm"],
                         help="Testing stage.")
-    parser.add_argument("--opt", default=0, type=int, choices=[0, 1, 2],
+    parser.add_argument("--opt", default=0, type=int, choices=[0, 1, 2, 3],
                         help="Optimization level.")
+    parser.add_argument("--extra-flags", default="",
+                        help="Extra flags passed to the compiler, e.g. --extra-flags=\"-fdirect-ssa -j4\".")
     args = parser.parse_args()
+    extra_flags = shlex.split(args.extra_flags)
 
     test_dir = os.path.join(TESTCASES_DIR, args.group)
     if not os.path.isdir(test_dir):
@@ -501,6 +512,7 @@ def main():
             output_file=os.path.join(
                 TEST_OUTPUT_DIR, base_name + ("-O" + str(args.opt)) + output_ext),
             opt_level=args.opt,
+            extra_flags=extra_flags,
             std_input=input_path if os.path.exists(input_path) else None,
             std_output=std_output_file,
             act_output=os.path.join(TEST_OUTPUT_DIR, base_name + ".act")
@@ -511,6 +523,8 @@ def main():
 
     print("\n" + "="*30)
     print(f"\tGroup: {args.group}, Stage: {args.stage}, Opt Level: {args.opt}")
+    if extra_flags:
+        print(f"\tExtra Flags: {' '.join(extra_flags)}")
     print(f"\tPassed: {passes_tests} / {len(sy_files)}")
     if len(sy_files) > 0:
         pass_rate = (passes_tests / len(sy_files)) * 100
@@ -1,7 +1,6 @@
 #include <dom_analyzer.h>
 #include <debug.h>
 #include <cassert>
-#include <functional>
 #include <algorithm>
 
 /*
@@ -27,11 +26,17 @@
  *    - 处理 parent 的半支配孩子集合：依据 sdom(mn[v]) 是否等于 parent 来判定 idom(v) 为 parent 或 mn[v]。
  * 3) 再做一次按 DFS 序的“idom 链压缩”，得到最终的直接支配者数组 imm_dom。
  * 4) 用 imm_dom 构建支配树 dom_tree；随后按每条边 u->v，沿着 idom 链把 v 加入从 u 到 idom(v) 之间结点的支配边界
- * dom_frontier。
+ * dom_frontier (每个结点的支配边界为按块编号升序、无重复的数组)。
  *
  * 备注：当 reverse=true 时，构造反图并以“所有出口”的虚拟源进行同样流程，即可计算“后支配”（post-dominator）。
  *
- * 本实现保留了上述流程的变量与骨架，并在若干关键点设置了 TODO，引导你补完 Eval/Link、DF 等细节。
+ * SEMI-NCA 变体：半支配者的计算与 LT 相同，但不再使用 bucket 求 idom，而是按 DFS 序依次处理每个结点 w，
+ * 从 parent(w) 出发沿已求得的 idom 链向上，直到遇到 dfn 不大于 sdom(w) 的结点，该结点即为 idom(w)。
+ * 最坏复杂度为 O(n^2)，但在实际的控制流图上常数更小。
+ *
+ * 实现细节：
+ * - DFS 与 Eval 的路径压缩均使用显式栈，避免在很深的控制流图上递归导致栈溢出。
+ * - 计算过程中的数组均以 DFS 序号为下标，前驱表以 CSR (起始下标 + 扁平数组) 形式存放。
  */
 
 using namespace std;
@@ -57,115 +62,162 @@ void DomAnalyzer::solve(const vector<vector<int>>& graph, const vector<int>& ent
         for (int u = 0; u < node_count; ++u)
             for (int v : graph[u]) working_graph[v].push_back(u);
 
-        working_graph.push_back(vector<int>());
         for (int exit : entry_points) working_graph[virtual_source].push_back(exit);
     }
 
-    build(working_graph, node_count + 1, virtual_source, entry_points);
+    build(working_graph, node_count + 1, virtual_source);
 }
 
-void DomAnalyzer::build(
-    const vector<vector<int>>& working_graph, int node_count, int virtual_source, const std::vector<int>& entry_points)
+void DomAnalyzer::build(const vector<vector<int>>& working_graph, int node_count, int virtual_source)
 {
-    (void)entry_points;
-    vector<vector<int>> backward_edges(node_count);
-    // TODO(Lab 4): 构建反向边表 backward_edges[v] = { 所有指向 v 的前驱 }
-    // 提示：为了正确处理多入口点的情况，可以使用一个虚拟的“入口点”，让它指向所有实际入口点
-    // 这主要是为了处理后支配树可能有多个入口的情况
-
-    dom_tree.clear();
-    dom_tree.resize(node_count);
-    dom_frontier.clear();
-    dom_frontier.resize(node_count);
-    imm_dom.clear();
-    imm_dom.resize(node_count);
+    // 1) 从虚拟源出发的非递归 DFS，栈中保存 (结点, 下一个待访问的后继下标)
+    vector<int> block_to_dfs(node_count, -1), dfs_to_block, parent;
+    dfs_to_block.reserve(node_count);
+    parent.reserve(node_count);
+    {
+        vector<pair<int, size_t>> stack;
+        block_to_dfs[virtual_source] = 0;
+        dfs_to_block.push_back(virtual_source);
+        parent.push_back(0);
+        stack.push_back({virtual_source, 0});
+        while (!stack.empty())
+        {
+            int         block = stack.back().first;
+            const auto& succs = working_graph[block];
+            if (stack.back().second == succs.size())
+            {
+                stack.pop_back();
+                continue;
+            }
+            int next = succs[stack.back().second++];
+            if (block_to_dfs[next] != -1) continue;
 
-    int                 dfs_count = -1;
-    vector<int>         block_to_dfs(node_count, 0), dfs_to_block(node_count), parent(node_count, 0);
-    vector<int>         semi_dom(node_count);
-    vector<int>         dsu_parent(node_count), min_ancestor(node_count);
-    vector<vector<int>> semi_children(node_count);
+            block_to_dfs[next] = dfs_to_block.size();
+            dfs_to_block.push_back(next);
+            parent.push_back(block_to_dfs[block]);
+            stack.push_back({next, 0});
+        }
+    }
+    int n = dfs_to_block.size();
+
+    // DFS 序下的前驱表 (只包含可达结点)
+    vector<int> pred_start(n + 1, 0), preds;
+    for (int u = 0; u < n; ++u)
+        for (int v : working_graph[dfs_to_block[u]]) ++pred_start[block_to_dfs[v] + 1];
+    for (int i = 0; i < n; ++i) pred_start[i + 1] += pred_start[i];
+    preds.resize(pred_start[n]);
+    {
+        vector<int> fill(pred_start.begin(), pred_start.end() - 1);
+        for (int u = 0; u < n; ++u)
+            for (int v : working_graph[dfs_to_block[u]]) preds[fill[block_to_dfs[v]]++] = u;
+    }
 
-    for (int i = 0; i < node_count; ++i)
+    // 2) 半支配者: semi_dom 保存的是 DFS 序号; ancestor 为 Link 构成的森林, -1 表示森林的根
+    vector<int> semi_dom(n), min_ancestor(n), ancestor(n, -1), idom(n, 0);
+    for (int i = 0; i < n; ++i)
     {
-        dsu_parent[i]   = i;
-        min_ancestor[i] = i;
         semi_dom[i]     = i;
+        min_ancestor[i] = i;
     }
 
-    function<void(int)> dfs = [&](int block) {
-        block_to_dfs[block]     = ++dfs_count;
-        dfs_to_block[dfs_count] = block;
-        semi_dom[block]         = block_to_dfs[block];
-        for (int next : working_graph[block])
-            if (!block_to_dfs[next])
-            {
-                dfs(next);
-                parent[next] = block;
-            }
-    };
-    dfs(virtual_source);
-
-    // TODO(Lab 4): 路径压缩并带最小祖先维护的 Find（Tarjan-Eval）
-    // 依据半支配序比较，维护 min_ancestor，并做并查集压缩
-    auto dsu_find = [&](int u, const auto& self) -> int {
-        (void)self;
-        TODO("Lab4-Analysis: Implement Tarjan Eval/Link find with min-ancestor maintenance");
-        return u;
+    vector<int> path;
+    auto        eval = [&](int v) -> int {
+        if (ancestor[v] == -1) return v;
+        // 路径压缩: 先收集需要压缩的结点，再自靠近根的一端向下更新 min_ancestor
+        int x = v;
+        path.clear();
+        while (ancestor[ancestor[x]] != -1)
+        {
+            path.push_back(x);
+            x = ancestor[x];
+        }
+        for (auto it = path.rbegin(); it != path.rend(); ++it)
+        {
+            int y = *it, a = ancestor[y];
+            if (semi_dom[min_ancestor[a]] < semi_dom[min_ancestor[y]]) min_ancestor[y] = min_ancestor[a];
+            ancestor[y] = ancestor[a];
+        }
+        return min_ancestor[v];
     };
 
-    auto dsu_query = [&](int u) -> int {
-        dsu_find(u, dsu_find);
-        return min_ancestor[u];
-    };
-    // 下两行占位：避免未使用警告，完成实现后可删
-    (void)dsu_find;
-    (void)dsu_query;
-
-    // TODO(Lab 4): 逆 DFS 序回溯半支配与 idom 计算
-    // 指引：
-    // 1) 逆序遍历 dfs_id = dfs_count..1：令 curr = dfs_to_block[dfs_id]
-    //    - 根据 LT 公式合并两类候选：
-    //      a) 所有 pred->curr 且 dfn(pred) < dfn(curr) 的 pred
-    //      b) 所有 pred->curr 且 dfn(pred) > dfn(curr) 的 sdom(eval(pred))
-    //    取上述候选的 dfn 最小者作为 semi_dom[curr]
-    // 2) Link(curr, parent[curr])：并查集父指向 parent[curr]，维护 min_ancestor
-    //    将 curr 放入 semi_children[sdom[curr]]，以备下一步对 parent 的半支配孩子集合进行处理
-    // 3) 对 parent[curr] 的半支配孩子集合中的每个 child：
-    //      若 sdom(mn[child]) == parent[curr] 则 imm_dom[child] = parent[curr]
-    //      否则 imm_dom[child] = mn[child]
-    //    然后清空该集合（以免重复处理）
-    // 注意：eval/Link 的细节由上方 dsu_find/self 与 dsu_parent/min_ancestor 完成
-    TODO("Lab4-Analysis: Reverse DFS pass to compute semi-dominators and initial idoms");
-
-    // 直接支配者 idom 链压缩
-    for (int dfs_id = 1; dfs_id <= dfs_count; ++dfs_id)
+    bool use_semi_nca = algorithm == Algorithm::SemiNCA || (algorithm == Algorithm::Auto && n <= semiNCAThreshold);
+
+    if (use_semi_nca)
     {
-        int curr = dfs_to_block[dfs_id];
-        if (imm_dom[curr] != dfs_to_block[semi_dom[curr]]) imm_dom[curr] = imm_dom[imm_dom[curr]];
+        for (int w = n - 1; w > 0; --w)
+        {
+            for (int i = pred_start[w]; i < pred_start[w + 1]; ++i)
+            {
+                int u = eval(preds[i]);
+                if (semi_dom[u] < semi_dom[w]) semi_dom[w] = semi_dom[u];
+            }
+            ancestor[w] = parent[w];
+        }
+
+        // 3) idom(w) 为 parent(w) 与 sdom(w) 在支配树上的最近公共祖先
+        for (int w = 1; w < n; ++w)
+        {
+            int x = parent[w];
+            while (x > semi_dom[w]) x = idom[x];
+            idom[w] = x;
+        }
     }
+    else
+    {
+        // semi_children 以链表形式存放: bucket_head[v] 为 sdom 为 v 的第一个结点
+        vector<int> bucket_head(n, -1), bucket_next(n, -1);
+        for (int w = n - 1; w > 0; --w)
+        {
+            for (int i = pred_start[w]; i < pred_start[w + 1]; ++i)
+            {
+                int u = eval(preds[i]);
+                if (semi_dom[u] < semi_dom[w]) semi_dom[w] = semi_dom[u];
+            }
+            bucket_next[w]            = bucket_head[semi_dom[w]];
+            bucket_head[semi_dom[w]] = w;
 
-    // 构建支配树（以 idom 为树边）
-    for (int i = 0; i < node_count; ++i)
-        if (block_to_dfs[i]) dom_tree[imm_dom[i]].push_back(i);
+            int p       = parent[w];
+            ancestor[w] = p;
+            for (int v = bucket_head[p]; v != -1; v = bucket_next[v])
+            {
+                int u   = eval(v);
+                idom[v] = semi_dom[u] < semi_dom[v] ? u : p;
+            }
+            bucket_head[p] = -1;
+        }
 
-    dom_tree.resize(virtual_source);
-    dom_frontier.resize(virtual_source);
-    imm_dom.resize(virtual_source);
+        // 3) 直接支配者 idom 链压缩
+        for (int w = 1; w < n; ++w)
+            if (idom[w] != semi_dom[w]) idom[w] = idom[idom[w]];
+    }
 
-    // 在支配树构建完成后，你还需要从里面移除本来并不存在的虚拟源节点
-    // 同时，需要注意设置移除了虚拟源节点后的入口节点的支配者
-    TODO("Lab4: Remove virtual source & adjust imm_dom");
+    // 4) 移除虚拟源: 被虚拟源直接支配的结点 (入口) 以自身为支配者
+    dom_tree.assign(virtual_source, {});
+    dom_frontier.assign(virtual_source, {});
+    imm_dom.assign(virtual_source, -1);
+    for (int w = 1; w < n; ++w)
+    {
+        int block      = dfs_to_block[w];
+        imm_dom[block] = idom[w] == 0 ? block : dfs_to_block[idom[w]];
+        if (idom[w] != 0) dom_tree[imm_dom[block]].push_back(block);
+    }
 
-    // TODO(Lab 4): 构建支配边界
-    for (int block = 0; block < node_count; ++block)
+    // 支配边界: 对每条边 pred->w，沿 idom 链从 pred 向上直到 idom(w)，途经结点的支配边界都包含 w
+    // 按块编号递增处理 w，这样每个结点的支配边界自然有序，去重只需比较末尾元素
+    for (int block = 0; block < virtual_source; ++block)
     {
-        for (int succ : working_graph[block])
+        int w = block_to_dfs[block];
+        if (w <= 0) continue;
+        for (int i = pred_start[w]; i < pred_start[w + 1]; ++i)
         {
-            (void)succ;
-            // 沿 idom 链向上，将 succ 放入 runner 的支配边界集合
-            // 提示：注意处理根与虚拟源节点，避免死循环
-            TODO("Lab4: Update dominance frontier along idom chain");
+            int runner = preds[i];
+            if (runner == 0) continue;
+            while (runner != idom[w])
+            {
+                auto& frontier = dom_frontier[dfs_to_block[runner]];
+                if (frontier.empty() || frontier.back() != block) frontier.push_back(block);
+                runner = idom[runner];
+            }
         }
     }
 }
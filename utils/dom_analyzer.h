@@ -2,33 +2,50 @@
 #define __UTILS_DOM_ANALYZER_H__
 
 #include <vector>
-#include <set>
 
 class DomAnalyzer
 {
   public:
+    // 由半支配者求直接支配者的方式:
+    // - LengauerTarjan: 经典 LT 算法，借助半支配孩子集合 (bucket) 求 idom
+    // - SemiNCA: 沿已求得的 idom 链向上寻找 parent 与 sdom 的最近公共祖先，常数更小，适合小图
+    // - Auto: 结点数不超过 semiNCAThreshold 时使用 SemiNCA，否则使用 LengauerTarjan
+    enum class Algorithm
+    {
+        LengauerTarjan,
+        SemiNCA,
+        Auto
+    };
+    static constexpr int semiNCAThreshold = 4096;
+
+    // 输出约定: 没有真实支配者的结点 (入口，后支配时为各出口以及只被虚拟出口后支配的结点) 的 imm_dom 为其自身，
+    // 从入口不可达的结点 imm_dom 为 -1
+    // dom_frontier[b] 按块编号升序排列且无重复，可直接二分查找或顺序归并
     std::vector<std::vector<int>> dom_tree;
-    std::vector<std::set<int>>    dom_frontier;
+    std::vector<std::vector<int>> dom_frontier;
     std::vector<int>              imm_dom;
 
+  private:
+    Algorithm algorithm = Algorithm::Auto;
+
   public:
     DomAnalyzer();
 
   public:
-    // 计算支配/后支配信息（基于 Lengauer-Tarjan 的总体流程）：
-    // - 你需要补足若干中间步骤（并查集维护、半支配计算、idom 计算、支配边界收集）。
-    // - 我们保留了输入/输出接口与核心调用骨架，细节请参考 TODO 注释与课堂资料。
+    // 计算支配/后支配信息（基于 Lengauer-Tarjan 的总体流程）
+    // reverse = true 时在反图上计算，entry_points 为所有出口，得到后支配信息
     void solve(const std::vector<std::vector<int>>& graph, const std::vector<int>& entry_points, bool reverse = false);
     void clear();
 
+    void      setAlgorithm(Algorithm algo) { algorithm = algo; }
+    Algorithm getAlgorithm() const { return algorithm; }
+
   private:
-    // TODO(Lab 4): 按 LT 算法完成该函数的关键步骤：
-    // 1) DFS 编号与反图/父亲关系构建
-    // 2) 半支配者 semi_dom 计算（含 Eval/Link 结构/最小祖先维护）
-    // 3) 直接支配者 imm_dom 计算与压缩
-    // 4) 支配树与支配边界构建
-    void build(const std::vector<std::vector<int>>& working_graph, int node_count, int virtual_source,
-        const std::vector<int>& entry_points);
+    // 1) 非递归 DFS 编号并建立 DFS 序下的前驱表
+    // 2) 带路径压缩的 Eval/Link 求半支配者 semi_dom
+    // 3) 按所选算法求直接支配者 imm_dom
+    // 4) 移除虚拟源，构建支配树与支配边界
+    void build(const std::vector<std::vector<int>>& working_graph, int node_count, int virtual_source);
 };
 
 #endif  // __UTILS_DOM_ANALYZER_H__
@@ -2,12 +2,18 @@
 #include <algorithm>
 #include <cstring>
 #include <cmath>
+#include <cstdlib>
+#include <new>
 
-#ifdef __GNUC__
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
 #include <x86intrin.h>
-#define CELE_ALIGNED(x) __attribute__((aligned(x)))
+#define CELE_X86_SIMD 1
 #else
-#define CELE_ALIGNED(x) __declspec(align(x))
+#define CELE_X86_SIMD 0
+#endif
+
+#if defined(_MSC_VER) || defined(__MINGW32__)
+#include <malloc.h>
 #endif
 
 namespace Cele
@@ -19,12 +25,246 @@ namespace Cele
 
     static_assert((dynamic_bitset::bits_per_block & (dynamic_bitset::bits_per_block - 1)) == 0,
         "bits_per_block must be a power of 2 for bit-shift optimizations");
+    static_assert(dynamic_bitset::inline_bits % dynamic_bitset::bits_per_block == 0,
+        "inline_bits must be a multiple of bits_per_block");
+
+    /*
+     * 按块运算的内核
+     * - 每个内核返回结果与运算前是否不同 (对所有块的 new ^ old 做按位或)，普通的 &=/|= 也走同一条路径，
+     *   多出的一次异或在访存受限的循环中几乎没有代价。
+     * - dst 可以与任一源操作数是同一个数组 (例如 out = gen | (out & ~kill))，内核逐块先读后写，不依赖 restrict。
+     * - AVX2 / SSE2 版本通过 target 属性单独编译，主体仍按默认指令集编译，运行时根据 CPU 选择。
+     */
+    namespace
+    {
+        using block_type = dynamic_bitset::block_type;
+        using simd_level = dynamic_bitset::simd_level;
+
+        enum class bit_op
+        {
+            AND,
+            OR,
+            XOR,
+            AND_NOT
+        };
+
+        template <bit_op Op>
+        inline block_type apply_scalar(block_type a, block_type b)
+        {
+            if constexpr (Op == bit_op::AND) return a & b;
+            if constexpr (Op == bit_op::OR) return a | b;
+            if constexpr (Op == bit_op::XOR) return a ^ b;
+            return a & ~b;
+        }
+
+        template <bit_op Op>
+        bool binary_scalar(block_type* dst, const block_type* src, size_t n)
+        {
+            block_type diff = 0;
+            for (size_t i = 0; i < n; ++i)
+            {
+                block_type result = apply_scalar<Op>(dst[i], src[i]);
+                diff |= result ^ dst[i];
+                dst[i] = result;
+            }
+            return diff != 0;
+        }
+
+        bool transfer_scalar(block_type* dst, const block_type* b, const block_type* c, const block_type* d, size_t n)
+        {
+            block_type diff = 0;
+            for (size_t i = 0; i < n; ++i)
+            {
+                block_type result = b[i] | (c[i] & ~d[i]);
+                diff |= result ^ dst[i];
+                dst[i] = result;
+            }
+            return diff != 0;
+        }
+
+#if CELE_X86_SIMD
+        constexpr size_t SSE2_BLOCKS = 16 / sizeof(block_type);
+        constexpr size_t AVX2_BLOCKS = 32 / sizeof(block_type);
+
+        template <bit_op Op>
+        __attribute__((target("sse2"))) bool binary_sse2(block_type* dst, const block_type* src, size_t n)
+        {
+            __m128i diff = _mm_setzero_si128();
+            size_t  i    = 0;
+            for (; i + SSE2_BLOCKS <= n; i += SSE2_BLOCKS)
+            {
+                __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+                __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                __m128i r;
+                if constexpr (Op == bit_op::AND) r = _mm_and_si128(a, b);
+                if constexpr (Op == bit_op::OR) r = _mm_or_si128(a, b);
+                if constexpr (Op == bit_op::XOR) r = _mm_xor_si128(a, b);
+                if constexpr (Op == bit_op::AND_NOT) r = _mm_andnot_si128(b, a);
+                diff = _mm_or_si128(diff, _mm_xor_si128(r, a));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), r);
+            }
+            bool changed = _mm_movemask_epi8(_mm_cmpeq_epi8(diff, _mm_setzero_si128())) != 0xFFFF;
+            bool tail    = binary_scalar<Op>(dst + i, src + i, n - i);
+            return changed || tail;
+        }
+
+        __attribute__((target("sse2"))) bool transfer_sse2(
+            block_type* dst, const block_type* b, const block_type* c, const block_type* d, size_t n)
+        {
+            __m128i diff = _mm_setzero_si128();
+            size_t  i    = 0;
+            for (; i + SSE2_BLOCKS <= n; i += SSE2_BLOCKS)
+            {
+                __m128i old = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+                __m128i vb  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+                __m128i vc  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(c + i));
+                __m128i vd  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(d + i));
+                __m128i r   = _mm_or_si128(vb, _mm_andnot_si128(vd, vc));
+                diff        = _mm_or_si128(diff, _mm_xor_si128(r, old));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), r);
+            }
+            bool changed = _mm_movemask_epi8(_mm_cmpeq_epi8(diff, _mm_setzero_si128())) != 0xFFFF;
+            bool tail    = transfer_scalar(dst + i, b + i, c + i, d + i, n - i);
+            return changed || tail;
+        }
+
+        template <bit_op Op>
+        __attribute__((target("avx2"))) bool binary_avx2(block_type* dst, const block_type* src, size_t n)
+        {
+            __m256i diff = _mm256_setzero_si256();
+            size_t  i    = 0;
+            for (; i + AVX2_BLOCKS <= n; i += AVX2_BLOCKS)
+            {
+                __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+                __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+                __m256i r;
+                if constexpr (Op == bit_op::AND) r = _mm256_and_si256(a, b);
+                if constexpr (Op == bit_op::OR) r = _mm256_or_si256(a, b);
+                if constexpr (Op == bit_op::XOR) r = _mm256_xor_si256(a, b);
+                if constexpr (Op == bit_op::AND_NOT) r = _mm256_andnot_si256(b, a);
+                diff = _mm256_or_si256(diff, _mm256_xor_si256(r, a));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), r);
+            }
+            bool changed = !_mm256_testz_si256(diff, diff);
+            bool tail    = binary_scalar<Op>(dst + i, src + i, n - i);
+            return changed || tail;
+        }
+
+        __attribute__((target("avx2"))) bool transfer_avx2(
+            block_type* dst, const block_type* b, const block_type* c, const block_type* d, size_t n)
+        {
+            __m256i diff = _mm256_setzero_si256();
+            size_t  i    = 0;
+            for (; i + AVX2_BLOCKS <= n; i += AVX2_BLOCKS)
+            {
+                __m256i old = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+                __m256i vb  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+                __m256i vc  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c + i));
+                __m256i vd  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(d + i));
+                __m256i r   = _mm256_or_si256(vb, _mm256_andnot_si256(vd, vc));
+                diff        = _mm256_or_si256(diff, _mm256_xor_si256(r, old));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), r);
+            }
+            bool changed = !_mm256_testz_si256(diff, diff);
+            bool tail    = transfer_scalar(dst + i, b + i, c + i, d + i, n - i);
+            return changed || tail;
+        }
+
+        // 默认指令集下 __builtin_popcountl 会编译为查表调用，单独以 popcnt 指令编译一份
+        __attribute__((target("popcnt"))) size_t popcount_hw(const block_type* blocks, size_t n)
+        {
+            size_t count0 = 0, count1 = 0, count2 = 0, count3 = 0;
+            size_t i = 0;
+            for (; i + 4 <= n; i += 4)
+            {
+                count0 += __builtin_popcountl(blocks[i]);
+                count1 += __builtin_popcountl(blocks[i + 1]);
+                count2 += __builtin_popcountl(blocks[i + 2]);
+                count3 += __builtin_popcountl(blocks[i + 3]);
+            }
+            for (; i < n; ++i) count0 += __builtin_popcountl(blocks[i]);
+            return count0 + count1 + count2 + count3;
+        }
+#endif
+
+        struct cpu_features
+        {
+            simd_level detected = simd_level::scalar;
+            simd_level active   = simd_level::scalar;
+            bool       popcnt   = false;
+
+            cpu_features()
+            {
+#if CELE_X86_SIMD
+                __builtin_cpu_init();
+                if (__builtin_cpu_supports("sse2")) detected = simd_level::sse2;
+                if (__builtin_cpu_supports("avx2")) detected = simd_level::avx2;
+                popcnt = __builtin_cpu_supports("popcnt");
+#endif
+                active = detected;
+            }
+        };
+
+        cpu_features& features()
+        {
+            static cpu_features instance;
+            return instance;
+        }
+
+        // 不足一个向量宽度时向量内核只会执行标量尾部，直接走标量路径省去分派开销
+        template <bit_op Op>
+        bool binary(block_type* dst, const block_type* src, size_t n)
+        {
+#if CELE_X86_SIMD
+            if (n < AVX2_BLOCKS) return binary_scalar<Op>(dst, src, n);
+            switch (features().active)
+            {
+                case simd_level::avx2: return binary_avx2<Op>(dst, src, n);
+                case simd_level::sse2: return binary_sse2<Op>(dst, src, n);
+                default: break;
+            }
+#endif
+            return binary_scalar<Op>(dst, src, n);
+        }
+
+        bool transfer(block_type* dst, const block_type* b, const block_type* c, const block_type* d, size_t n)
+        {
+#if CELE_X86_SIMD
+            if (n < AVX2_BLOCKS) return transfer_scalar(dst, b, c, d, n);
+            switch (features().active)
+            {
+                case simd_level::avx2: return transfer_avx2(dst, b, c, d, n);
+                case simd_level::sse2: return transfer_sse2(dst, b, c, d, n);
+                default: break;
+            }
+#endif
+            return transfer_scalar(dst, b, c, d, n);
+        }
+    }  // namespace
+
+    dynamic_bitset::simd_level dynamic_bitset::simd() { return features().active; }
+
+    dynamic_bitset::simd_level dynamic_bitset::detected_simd() { return features().detected; }
+
+    void dynamic_bitset::set_simd(simd_level level)
+    {
+        auto& cpu  = features();
+        cpu.active = static_cast<int>(level) < static_cast<int>(cpu.detected) ? level : cpu.detected;
+    }
+
+    const char* dynamic_bitset::simd_name(simd_level level)
+    {
+        switch (level)
+        {
+            case simd_level::avx2: return "avx2";
+            case simd_level::sse2: return "sse2";
+            default: return "scalar";
+        }
+    }
 
     size_t dynamic_bitset::popcount(block_type block)
     {
-#if defined(__GNUC__) && defined(__POPCNT__)
-        return __builtin_popcountl(block);
-#elif defined(__GNUC__)
+#if defined(__GNUC__)
         return __builtin_popcountl(block);
 #else
 
@@ -38,6 +278,41 @@ namespace Cele
 #endif
     }
 
+    dynamic_bitset::block_type* dynamic_bitset::allocate(size_t num_blocks)
+    {
+        const size_t alignment = 64;
+        void*        ptr       = nullptr;
+#if defined(_MSC_VER) || defined(__MINGW32__)
+        ptr = _aligned_malloc(num_blocks * sizeof(block_type), alignment);
+#else
+        if (posix_memalign(&ptr, alignment, num_blocks * sizeof(block_type)) != 0) ptr = nullptr;
+#endif
+        if (!ptr) throw std::bad_alloc();
+        return static_cast<block_type*>(ptr);
+    }
+
+    void dynamic_bitset::deallocate(block_type* blocks)
+    {
+#if defined(_MSC_VER) || defined(__MINGW32__)
+        _aligned_free(blocks);
+#else
+        free(blocks);
+#endif
+    }
+
+    dynamic_bitset::block_type* dynamic_bitset::acquire(size_t num_blocks)
+    {
+        if (num_blocks == 0) return nullptr;
+        if (num_blocks <= inline_blocks) return m_inline;
+        return allocate(num_blocks);
+    }
+
+    void dynamic_bitset::release()
+    {
+        if (m_blocks && m_blocks != m_inline) deallocate(m_blocks);
+        m_blocks = nullptr;
+    }
+
     void dynamic_bitset::sanitize()
     {
         if (m_num_blocks > 0)
@@ -52,30 +327,16 @@ namespace Cele
     dynamic_bitset::dynamic_bitset(size_t num_bits, unsigned long value)
         : m_num_bits(num_bits), m_num_blocks(blocks_required(num_bits))
     {
+        m_blocks = acquire(m_num_blocks);
         if (m_num_blocks > 0)
         {
-#if defined(__GNUC__) && !defined(__MINGW32__)
-            const size_t alignment = 64;
-            void*        ptr       = nullptr;
-            if (posix_memalign(&ptr, alignment, m_num_blocks * sizeof(block_type)) == 0)
-            {
-                m_blocks = static_cast<block_type*>(ptr);
-                std::memset(m_blocks, 0, m_num_blocks * sizeof(block_type));
-            }
-            else
-                m_blocks = new block_type[m_num_blocks]();
-#else
-            m_blocks = new block_type[m_num_blocks]();
-#endif
-
+            std::memset(m_blocks, 0, m_num_blocks * sizeof(block_type));
             if (value != 0)
             {
                 m_blocks[0] = value;
                 sanitize();
             }
         }
-        else
-            m_blocks = nullptr;
     }
 
     dynamic_bitset::dynamic_bitset(const std::string& str, size_t pos, size_t n, char zero, char one)
@@ -90,7 +351,8 @@ namespace Cele
 
         if (m_num_blocks > 0)
         {
-            m_blocks = new block_type[m_num_blocks]();
+            m_blocks = acquire(m_num_blocks);
+            std::memset(m_blocks, 0, m_num_blocks * sizeof(block_type));
 
             for (size_t i = 0; i < n; ++i)
             {
@@ -103,7 +365,10 @@ namespace Cele
                     m_blocks[block_idx] |= (block_type(1) << bit_offset);
                 }
                 else if (c != zero)
+                {
+                    release();
                     throw std::invalid_argument("Invalid character in bitset initialization");
+                }
             }
         }
     }
@@ -111,27 +376,19 @@ namespace Cele
     dynamic_bitset::dynamic_bitset(const dynamic_bitset& other)
         : m_num_bits(other.m_num_bits), m_num_blocks(other.m_num_blocks)
     {
-        if (m_num_blocks > 0)
-        {
-#if defined(__GNUC__) && !defined(__MINGW32__)
-            const size_t alignment = 64;
-            void*        ptr       = nullptr;
-            if (posix_memalign(&ptr, alignment, m_num_blocks * sizeof(block_type)) == 0)
-                m_blocks = static_cast<block_type*>(ptr);
-            else
-                m_blocks = new block_type[m_num_blocks];
-#else
-            m_blocks = new block_type[m_num_blocks];
-#endif
-
-            std::memcpy(m_blocks, other.m_blocks, m_num_blocks * sizeof(block_type));
-        }
-        else { m_blocks = nullptr; }
+        m_blocks = acquire(m_num_blocks);
+        if (m_num_blocks > 0) std::memcpy(m_blocks, other.m_blocks, m_num_blocks * sizeof(block_type));
     }
 
     dynamic_bitset::dynamic_bitset(dynamic_bitset&& other) noexcept
         : m_blocks(other.m_blocks), m_num_bits(other.m_num_bits), m_num_blocks(other.m_num_blocks)
     {
+        // 内部缓冲区中的数据不能随指针转移，需要复制
+        if (other.m_blocks == other.m_inline)
+        {
+            std::memcpy(m_inline, other.m_inline, sizeof(m_inline));
+            m_blocks = m_inline;
+        }
         other.m_blocks     = nullptr;
         other.m_num_bits   = 0;
         other.m_num_blocks = 0;
@@ -143,29 +400,9 @@ namespace Cele
         {
             if (m_num_blocks != other.m_num_blocks)
             {
-#if defined(__GNUC__) && !defined(__MINGW32__)
-                if (m_blocks) free(m_blocks);
-#else
-                delete[] m_blocks;
-#endif
-
+                release();
                 m_num_blocks = other.m_num_blocks;
-
-                if (m_num_blocks > 0)
-                {
-#if defined(__GNUC__) && !defined(__MINGW32__)
-                    const size_t alignment = 64;
-                    void*        ptr       = nullptr;
-                    if (posix_memalign(&ptr, alignment, m_num_blocks * sizeof(block_type)) == 0)
-                        m_blocks = static_cast<block_type*>(ptr);
-                    else
-                        m_blocks = new block_type[m_num_blocks];
-#else
-                    m_blocks = new block_type[m_num_blocks];
-#endif
-                }
-                else
-                    m_blocks = nullptr;
+                m_blocks     = acquire(m_num_blocks);
             }
 
             m_num_bits = other.m_num_bits;
@@ -180,16 +417,17 @@ namespace Cele
     {
         if (this != &other)
         {
-            // 使用与析构函数匹配的释放方式
-#if defined(__GNUC__) && !defined(__MINGW32__)
-            if (m_blocks) free(m_blocks);
-#else
-            delete[] m_blocks;
-#endif
+            release();
 
-            m_blocks     = other.m_blocks;
             m_num_bits   = other.m_num_bits;
             m_num_blocks = other.m_num_blocks;
+            if (other.m_blocks == other.m_inline)
+            {
+                std::memcpy(m_inline, other.m_inline, sizeof(m_inline));
+                m_blocks = m_inline;
+            }
+            else
+                m_blocks = other.m_blocks;
 
             other.m_blocks     = nullptr;
             other.m_num_bits   = 0;
@@ -198,18 +436,7 @@ namespace Cele
         return *this;
     }
 
-    dynamic_bitset::~dynamic_bitset()
-    {
-#if defined(__GNUC__) && !defined(__MINGW32__)
-        if (m_blocks)
-        {
-            free(m_blocks);
-            m_blocks = nullptr;
-        }
-#else
-        delete[] m_blocks;
-#endif
-    }
+    dynamic_bitset::~dynamic_bitset() { release(); }
 
     dynamic_bitset& dynamic_bitset::set(size_t pos, bool value)
     {
@@ -239,7 +466,9 @@ namespace Cele
 
         if (first_block == last_block)
         {
-            block_type mask = ((block_type(1) << (last_bit - first_bit + 1)) - 1) << first_bit;
+            block_type mask = (last_bit - first_bit + 1 == bits_per_block)
+                                  ? ~block_type(0)
+                                  : ((block_type(1) << (last_bit - first_bit + 1)) - 1) << first_bit;
 
             if (value)
                 m_blocks[first_block] |= mask;
@@ -257,7 +486,8 @@ namespace Cele
             block_type fill_value = value ? ~block_type(0) : block_type(0);
             for (size_t i = first_block + 1; i < last_block; ++i) m_blocks[i] = fill_value;
 
-            block_type last_mask = (block_type(1) << (last_bit + 1)) - 1;
+            block_type last_mask =
+                last_bit + 1 == bits_per_block ? ~block_type(0) : (block_type(1) << (last_bit + 1)) - 1;
             if (value)
                 m_blocks[last_block] |= last_mask;
             else
@@ -338,39 +568,27 @@ namespace Cele
 
         if (new_num_blocks != m_num_blocks)
         {
-            block_type* new_blocks = nullptr;
-
-            if (new_num_blocks > 0)
+            // 在内部缓冲区与堆内存之间切换时搬移数据; 内部缓冲区内的伸缩无需搬移
+            block_type* new_blocks = new_num_blocks <= inline_blocks ? (new_num_blocks ? m_inline : nullptr)
+                                                                     : allocate(new_num_blocks);
+            if (new_blocks != m_blocks)
             {
-#if defined(__GNUC__) && !defined(__MINGW32__)
-                const size_t alignment = 64;
-                void*        ptr       = nullptr;
-                if (posix_memalign(&ptr, alignment, new_num_blocks * sizeof(block_type)) == 0)
-                {
-                    new_blocks = static_cast<block_type*>(ptr);
-                    std::memset(new_blocks, 0, new_num_blocks * sizeof(block_type));
-                }
-                else
-                    new_blocks = new block_type[new_num_blocks]();
-#else
-                new_blocks = new block_type[new_num_blocks]();
-#endif
+                size_t copy_blocks = std::min(m_num_blocks, new_num_blocks);
+                if (copy_blocks > 0) std::memmove(new_blocks, m_blocks, copy_blocks * sizeof(block_type));
+                if (m_blocks && m_blocks != m_inline) deallocate(m_blocks);
             }
 
-            size_t copy_blocks = std::min(m_num_blocks, new_num_blocks);
-            if (copy_blocks > 0) std::memcpy(new_blocks, m_blocks, copy_blocks * sizeof(block_type));
+            if (new_num_blocks > m_num_blocks)
+            {
+                std::fill(new_blocks + m_num_blocks,
+                    new_blocks + new_num_blocks,
+                    value ? ~block_type(0) : block_type(0));
 
-            if (value && new_num_blocks > m_num_blocks)
-                std::fill(new_blocks + m_num_blocks, new_blocks + new_num_blocks, ~block_type(0));
-            else if (new_num_blocks > m_num_blocks)
-                std::fill(new_blocks + m_num_blocks, new_blocks + new_num_blocks, block_type(0));
+                size_t old_bits_in_last_block = m_num_bits % bits_per_block;
+                if (value && old_bits_in_last_block > 0)
+                    new_blocks[m_num_blocks - 1] |= (~block_type(0) << old_bits_in_last_block);
+            }
 
-                // 使用与析构函数匹配的释放方式
-#if defined(__GNUC__) && !defined(__MINGW32__)
-            if (m_blocks) free(m_blocks);
-#else
-            delete[] m_blocks;
-#endif
             m_blocks     = new_blocks;
             m_num_blocks = new_num_blocks;
         }
@@ -425,6 +643,11 @@ namespace Cele
     {
         if (m_num_blocks == 0) return 0;
 
+#if CELE_X86_SIMD
+        if (m_num_blocks > 1 && features().popcnt && features().active != simd_level::scalar)
+            return popcount_hw(m_blocks, m_num_blocks);
+#endif
+
         size_t count = 0;
 
         constexpr size_t UNROLL_COUNT = 8;
@@ -456,67 +679,85 @@ namespace Cele
         return result;
     }
 
-    dynamic_bitset& dynamic_bitset::operator&=(const dynamic_bitset& other)
+    size_t dynamic_bitset::find_first() const
     {
-        if (size() != other.size())
-            throw std::invalid_argument("Bitsets must have the same size for bitwise AND operation");
+        for (size_t i = 0; i < m_num_blocks; ++i)
+            if (m_blocks[i]) return i * bits_per_block + lowest_bit(m_blocks[i]);
+        return npos;
+    }
 
-        constexpr size_t UNROLL_COUNT = 4;
-        size_t           i            = 0;
+    size_t dynamic_bitset::find_next(size_t pos) const
+    {
+        if (pos == npos || pos + 1 >= m_num_bits) return npos;
 
-        for (; i + UNROLL_COUNT <= m_num_blocks; i += UNROLL_COUNT)
-        {
-            m_blocks[i] &= other.m_blocks[i];
-            m_blocks[i + 1] &= other.m_blocks[i + 1];
-            m_blocks[i + 2] &= other.m_blocks[i + 2];
-            m_blocks[i + 3] &= other.m_blocks[i + 3];
-        }
+        ++pos;
+        size_t     block   = pos >> BLOCK_SHIFT;
+        block_type current = m_blocks[block] & (~block_type(0) << (pos & BLOCK_MASK));
+        if (current) return block * bits_per_block + lowest_bit(current);
 
-        for (; i < m_num_blocks; ++i) m_blocks[i] &= other.m_blocks[i];
+        for (++block; block < m_num_blocks; ++block)
+            if (m_blocks[block]) return block * bits_per_block + lowest_bit(m_blocks[block]);
+        return npos;
+    }
 
+    bool dynamic_bitset::intersects(const dynamic_bitset& other) const
+    {
+        check_size(other, "Bitsets must have the same size for intersection test");
+        for (size_t i = 0; i < m_num_blocks; ++i)
+            if (m_blocks[i] & other.m_blocks[i]) return true;
+        return false;
+    }
+
+    dynamic_bitset& dynamic_bitset::operator&=(const dynamic_bitset& other)
+    {
+        and_changed(other);
         return *this;
     }
 
     dynamic_bitset& dynamic_bitset::operator|=(const dynamic_bitset& other)
     {
-        if (size() != other.size())
-            throw std::invalid_argument("Bitsets must have the same size for bitwise OR operation");
-
-        constexpr size_t UNROLL_COUNT = 4;
-        size_t           i            = 0;
+        or_changed(other);
+        return *this;
+    }
 
-        for (; i + UNROLL_COUNT <= m_num_blocks; i += UNROLL_COUNT)
-        {
-            m_blocks[i] |= other.m_blocks[i];
-            m_blocks[i + 1] |= other.m_blocks[i + 1];
-            m_blocks[i + 2] |= other.m_blocks[i + 2];
-            m_blocks[i + 3] |= other.m_blocks[i + 3];
-        }
+    dynamic_bitset& dynamic_bitset::operator^=(const dynamic_bitset& other)
+    {
+        check_size(other, "Bitsets must have the same size for bitwise XOR operation");
+        binary<bit_op::XOR>(m_blocks, other.m_blocks, m_num_blocks);
+        return *this;
+    }
 
-        for (; i < m_num_blocks; ++i) m_blocks[i] |= other.m_blocks[i];
+    bool dynamic_bitset::and_changed(const dynamic_bitset& other)
+    {
+        check_size(other, "Bitsets must have the same size for bitwise AND operation");
+        return binary<bit_op::AND>(m_blocks, other.m_blocks, m_num_blocks);
+    }
 
-        return *this;
+    bool dynamic_bitset::or_changed(const dynamic_bitset& other)
+    {
+        check_size(other, "Bitsets must have the same size for bitwise OR operation");
+        return binary<bit_op::OR>(m_blocks, other.m_blocks, m_num_blocks);
     }
 
-    dynamic_bitset& dynamic_bitset::operator^=(const dynamic_bitset& other)
+    bool dynamic_bitset::and_not_changed(const dynamic_bitset& other)
     {
-        if (size() != other.size())
-            throw std::invalid_argument("Bitsets must have the same size for bitwise XOR operation");
+        check_size(other, "Bitsets must have the same size for bitwise AND-NOT operation");
+        return binary<bit_op::AND_NOT>(m_blocks, other.m_blocks, m_num_blocks);
+    }
 
-        constexpr size_t UNROLL_COUNT = 4;
-        size_t           i            = 0;
+    bool dynamic_bitset::assign_or_and_not(const dynamic_bitset& b, const dynamic_bitset& c, const dynamic_bitset& d)
+    {
+        if (b.size() != c.size() || c.size() != d.size())
+            throw std::invalid_argument("Bitsets must have the same size for fused OR/AND-NOT operation");
 
-        for (; i + UNROLL_COUNT <= m_num_blocks; i += UNROLL_COUNT)
+        // 大小不同时先按 b 的大小重新分配，此时视为发生了变化
+        bool resized = false;
+        if (size() != b.size())
         {
-            m_blocks[i] ^= other.m_blocks[i];
-            m_blocks[i + 1] ^= other.m_blocks[i + 1];
-            m_blocks[i + 2] ^= other.m_blocks[i + 2];
-            m_blocks[i + 3] ^= other.m_blocks[i + 3];
+            resize(b.size());
+            resized = true;
         }
-
-        for (; i < m_num_blocks; ++i) m_blocks[i] ^= other.m_blocks[i];
-
-        return *this;
+        return transfer(m_blocks, b.m_blocks, c.m_blocks, d.m_blocks, m_num_blocks) || resized;
     }
 
     bool dynamic_bitset::operator==(const dynamic_bitset& other) const
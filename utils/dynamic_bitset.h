@@ -7,6 +7,18 @@
 #include <iostream>
 #include <stdexcept>
 
+/*
+ * 动态位集
+ * - 不超过 inline_bits 位的位集直接存放在对象内部 (小缓冲区优化)，不做堆分配；
+ *   数据流分析中大量的小函数因此不会为每个基本块的 in/out 集合各分配一次内存。
+ * - 按位运算与 count 使用 SIMD 内核，运行时根据 CPU 支持情况在 AVX2 / SSE2 / 标量实现间选择，
+ *   可通过 set_simd 降级 (用于基准测试与对拍)。
+ * - *_changed 系列为原地运算，返回结果是否与运算前不同，用于数据流迭代判断不动点；
+ *   assign_or_and_not(b, c, d) 计算 *this = b | (c & ~d)，即常见的 gen | (in - kill) 传递函数。
+ * - find_first/find_next 与 for_each_set_bit 借助 ctz 逐个枚举置位的位。
+ * - 参与二元运算的位集必须等长，否则抛出 std::invalid_argument。
+ */
+
 namespace Cele
 {
     class dynamic_bitset
@@ -14,11 +26,23 @@ namespace Cele
       public:
         using block_type                       = unsigned long;
         static constexpr size_t bits_per_block = sizeof(block_type) * CHAR_BIT;
+        static constexpr size_t inline_bits    = 128;
+        static constexpr size_t npos           = static_cast<size_t>(-1);
+
+        enum class simd_level
+        {
+            scalar,
+            sse2,
+            avx2
+        };
 
       private:
+        static constexpr size_t inline_blocks = inline_bits / bits_per_block;
+
         block_type* m_blocks;
         size_t      m_num_bits;
         size_t      m_num_blocks;
+        alignas(16) block_type m_inline[inline_blocks];
 
       public:
         dynamic_bitset();
@@ -55,14 +79,45 @@ namespace Cele
         size_t      count() const;
         std::string to_string(char zero = '0', char one = '1') const;
 
+        // 第一个 / pos 之后的第一个置位的位，不存在时返回 npos
+        size_t find_first() const;
+        size_t find_next(size_t pos) const;
+
+        template <typename F>
+        void for_each_set_bit(F&& f) const
+        {
+            for (size_t i = 0; i < m_num_blocks; ++i)
+            {
+                block_type block = m_blocks[i];
+                while (block)
+                {
+                    f(i * bits_per_block + lowest_bit(block));
+                    block &= block - 1;
+                }
+            }
+        }
+
+        bool intersects(const dynamic_bitset& other) const;
+
         dynamic_bitset& operator&=(const dynamic_bitset& other);
         dynamic_bitset& operator|=(const dynamic_bitset& other);
         dynamic_bitset& operator^=(const dynamic_bitset& other);
         dynamic_bitset  operator~() const;
 
+        bool and_changed(const dynamic_bitset& other);
+        bool or_changed(const dynamic_bitset& other);
+        bool and_not_changed(const dynamic_bitset& other);  // *this &= ~other
+        bool assign_or_and_not(const dynamic_bitset& b, const dynamic_bitset& c, const dynamic_bitset& d);
+
         bool operator==(const dynamic_bitset& other) const;
         bool operator!=(const dynamic_bitset& other) const;
 
+        // 当前使用的内核; set_simd 只能选择不高于 CPU 支持的级别
+        static simd_level  simd();
+        static simd_level  detected_simd();
+        static void        set_simd(simd_level level);
+        static const char* simd_name(simd_level level);
+
       private:
         static inline size_t blocks_required(size_t num_bits)
         {
@@ -79,6 +134,32 @@ namespace Cele
             if (pos >= m_num_bits) throw std::out_of_range("Position out of range");
         }
 
+        inline void check_size(const dynamic_bitset& other, const char* what) const
+        {
+            if (size() != other.size()) throw std::invalid_argument(what);
+        }
+
+        static inline size_t lowest_bit(block_type block)
+        {
+#if defined(__GNUC__)
+            return __builtin_ctzl(block);
+#else
+            size_t bit = 0;
+            while (!(block & 1))
+            {
+                block >>= 1;
+                ++bit;
+            }
+            return bit;
+#endif
+        }
+
+        // 不超过 inline_blocks 块时使用内部缓冲区，否则分配 64 字节对齐的堆内存
+        block_type*        acquire(size_t num_blocks);
+        void               release();
+        static block_type* allocate(size_t num_blocks);
+        static void        deallocate(block_type* blocks);
+
         void          sanitize();
         static size_t popcount(block_type block);
     };
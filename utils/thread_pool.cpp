@@ -0,0 +1,111 @@
+#include <thread_pool.h>
+
+namespace
+{
+    thread_local size_t workerIndex = 0;
+}  // namespace
+
+ThreadPool::ThreadPool(size_t threadCount)
+{
+    if (threadCount == 0) threadCount = 1;
+    for (size_t i = 0; i < threadCount; ++i) queues.push_back(std::make_unique<WorkQueue>());
+    for (size_t i = 1; i < threadCount; ++i) workers.emplace_back([this, i] { workerLoop(i); });
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMtx);
+        stopping = true;
+    }
+    wakeCv.notify_all();
+    for (auto& worker : workers) worker.join();
+}
+
+size_t ThreadPool::currentWorker() { return workerIndex; }
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& task)
+{
+    if (count == 0) return;
+    if (queues.size() == 1)
+    {
+        for (size_t i = 0; i < count; ++i) task(i);
+        return;
+    }
+
+    // 按轮转方式预先分配到各个队列，负载不均时由空闲线程窃取
+    pending = count;
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto&                       queue = *queues[i % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mtx);
+        ++queued;
+        queue.tasks.push_back([&task, i] { task(i); });
+    }
+    {
+        // 与 workerLoop 中的等待条件检查互斥，避免丢失唤醒
+        std::lock_guard<std::mutex> lock(sleepMtx);
+    }
+    wakeCv.notify_all();
+
+    Task current;
+    while (tryPop(0, current)) runTask(current);
+
+    std::unique_lock<std::mutex> lock(sleepMtx);
+    doneCv.wait(lock, [this] { return pending == 0; });
+}
+
+bool ThreadPool::tryPop(size_t self, Task& task)
+{
+    {
+        auto&                       own = *queues[self];
+        std::lock_guard<std::mutex> lock(own.mtx);
+        if (!own.tasks.empty())
+        {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            --queued;
+            return true;
+        }
+    }
+    for (size_t offset = 1; offset < queues.size(); ++offset)
+    {
+        auto&                       victim = *queues[(self + offset) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mtx);
+        if (victim.tasks.empty()) continue;
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        --queued;
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::runTask(Task& task)
+{
+    task();
+    task = nullptr;
+    if (--pending == 0)
+    {
+        std::lock_guard<std::mutex> lock(sleepMtx);
+        doneCv.notify_all();
+    }
+}
+
+void ThreadPool::workerLoop(size_t self)
+{
+    workerIndex = self;
+    Task task;
+    while (true)
+    {
+        if (tryPop(self, task))
+        {
+            runTask(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMtx);
+        wakeCv.wait(lock, [this] { return stopping || queued > 0; });
+        if (stopping) return;
+    }
+}
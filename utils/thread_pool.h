@@ -0,0 +1,62 @@
+#ifndef __UTILS_THREAD_POOL_H__
+#define __UTILS_THREAD_POOL_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ * 工作窃取 (work-stealing) 线程池
+ * - 每个工作线程持有一个双端队列，优先从自己队列的尾部取任务，空闲时从其它队列的头部窃取
+ * - 调用 parallelFor 的线程作为 0 号工作线程参与执行，因此 ThreadPool(1) 退化为串行执行
+ * - currentWorker() 返回当前线程在池中的编号，可用于访问按线程划分的状态
+ */
+
+class ThreadPool
+{
+  public:
+    using Task = std::function<void()>;
+
+  private:
+    struct WorkQueue
+    {
+        std::mutex       mtx;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::vector<std::thread>                workers;
+
+    std::mutex              sleepMtx;
+    std::condition_variable wakeCv;
+    std::condition_variable doneCv;
+    std::atomic<size_t>     queued{0};
+    std::atomic<size_t>     pending{0};
+    bool                    stopping = false;
+
+  public:
+    explicit ThreadPool(size_t threadCount);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&)            = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const { return queues.size(); }
+
+    // 执行 task(0) ... task(count - 1)，返回时所有任务均已完成
+    void parallelFor(size_t count, const std::function<void(size_t)>& task);
+
+    static size_t currentWorker();
+
+  private:
+    bool tryPop(size_t self, Task& task);
+    void runTask(Task& task);
+    void workerLoop(size_t self);
+};
+
+#endif  // __UTILS_THREAD_POOL_H__